@@ -0,0 +1,244 @@
+#include "batch-runner.h"
+
+#include <spdlog/spdlog.h>
+#include <profiling/instrumentor.h>
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+#include "scomponents/graphics/materials.h"
+#include "scene/generation.h"
+#include "loaders/cbe-loader.h"
+#include "loaders/cbe-writer.h"
+#include "loaders/vox-loader.h"
+#include "loaders/vox-writer.h"
+#include "exporters/mesh-exporter.h"
+
+namespace {
+    std::string extensionOf(const std::string& filePath) {
+        return std::filesystem::path(filePath).extension().string();
+    }
+}
+
+BatchRunner::BatchRunner() : m_isCsgReplacing(true) {
+    // Same starting palette and limits than the editor, so the saved files can be opened in it
+    const Materials materials;
+    m_scene.palette.assign(materials.begin(), materials.end());
+    m_paletteCapacity = static_cast<unsigned int>(materials.capacity());
+}
+
+BatchRunner::~BatchRunner() {}
+
+bool BatchRunner::run(const std::vector<std::string>& words) {
+    for (size_t i = 0; i < words.size(); i++) {
+        const std::string& command = words.at(i);
+        const size_t argumentCount = words.size() - i - 1;
+
+        bool success = false;
+        if (command == "load" && argumentCount >= 1) {
+            success = load(words.at(++i));
+        } else if (command == "save" && argumentCount >= 1) {
+            success = save(words.at(++i));
+        } else if (command == "export" && argumentCount >= 1) {
+            success = exportMesh(words.at(++i));
+        } else if (command == "run" && argumentCount >= 1) {
+            success = runScript(words.at(++i));
+        } else if (command == "convert-trace" && argumentCount >= 2) {
+            success = trace::convertToJson(words.at(i + 1), words.at(i + 2));
+            if (!success)
+                spdlog::error("[Batch] Cannot convert profiling trace : {}", words.at(i + 1));
+            i += 2;
+        } else if (command == "control-point" && argumentCount >= 4) {
+            try {
+                m_controlPoints.push_back(glm::ivec3(std::stoi(words.at(i + 1)), std::stoi(words.at(i + 2)), std::stoi(words.at(i + 3))));
+                m_controlPointWeights.push_back(std::stod(words.at(i + 4)));
+                success = true;
+            } catch (const std::logic_error&) {
+                spdlog::error("[Batch] Invalid control point");
+            }
+            i += 4;
+        } else if (command == "clear-control-points") {
+            m_controlPoints.clear();
+            m_controlPointWeights.clear();
+            success = true;
+        } else if (command == "csg" && argumentCount >= 5) {
+            try {
+                const glm::ivec3 offset(std::stoi(words.at(i + 3)), std::stoi(words.at(i + 4)), std::stoi(words.at(i + 5)));
+                success = combine(words.at(i + 1), words.at(i + 2), offset);
+            } catch (const std::logic_error&) {
+                spdlog::error("[Batch] Invalid csg offset");
+            }
+            i += 5;
+        } else if (command == "csg-materials" && argumentCount >= 1) {
+            const std::string& rule = words.at(++i);
+            success = rule == "keep" || rule == "replace";
+            if (success)
+                m_isCsgReplacing = rule == "replace";
+            else
+                spdlog::error("[Batch] Unknown csg materials rule : {}", rule);
+        } else if (command == "generate") {
+            success = generate();
+        } else if (command == "clear") {
+            m_scene.voxels.clear();
+            success = true;
+        } else {
+            spdlog::error("[Batch] Unknown command or missing arguments : {}", command);
+        }
+
+        if (!success)
+            return false;
+    }
+    return true;
+}
+
+void BatchRunner::printUsage() {
+    std::cout << "Usage: cube-beast-editor-batch <command> [arguments] [<command> [arguments]] ...\n"
+              << "\n"
+              << "Commands are run in order on a single scene:\n"
+              << "  load <file>                  Load a .cbe or .vox model\n"
+              << "  save <file>                  Save as .cbe or .vox\n"
+              << "  export <file>                Export a .obj, .ply or .gltf triangle mesh\n"
+              << "  control-point <x> <y> <z> <weight>\n"
+              << "                               Add a control point for the generation\n"
+              << "  clear-control-points         Remove the control points\n"
+              << "  generate                     Move the voxels with a RBF interpolation of the control points\n"
+              << "  csg <unite|subtract|intersect> <file> <x> <y> <z>\n"
+              << "                               Combine the voxels of a model moved by the offset, keeping the material indices\n"
+              << "  csg-materials <keep|replace>   Materials of the cells used by both models in the next csg, replace by default\n"
+              << "  clear                        Remove all voxels\n"
+              << "  run <script>                 Run the commands of a text file, one per line, # for comments\n"
+              << "  convert-trace <trace> <json> Convert a binary profiling trace for chrome://tracing\n";
+}
+
+bool BatchRunner::load(const std::string& filePath) {
+    // Files without geometry are applied on the current voxels, like in the editor
+    StagingScene staged;
+    staged.voxels = VoxelGrid(m_scene.voxels.snapshot());
+    if (!loadFile(filePath, staged))
+        return false;
+
+    if (staged.palette.empty())
+        staged.palette = std::move(m_scene.palette);
+    else if (staged.palette.size() > m_paletteCapacity)
+        staged.palette.resize(m_paletteCapacity);
+
+    m_scene = std::move(staged);
+    spdlog::info("[Batch] Loaded {} voxels from {}", m_scene.voxels.size(), filePath);
+    return true;
+}
+
+bool BatchRunner::loadFile(const std::string& filePath, StagingScene& staged) const {
+    std::atomic<float> progress;
+    if (extensionOf(filePath) == ".vox") {
+        VoxLoader loader(m_paletteCapacity);
+        return loader.loadFile(filePath.c_str(), staged, progress);
+    }
+    CbeLoader loader;
+    return loader.loadFile(filePath.c_str(), staged, progress);
+}
+
+bool BatchRunner::save(const std::string& filePath) {
+    const std::string extension = extensionOf(filePath);
+    if (extension == ".vox") {
+        VoxWriter writer;
+        return writer.writeFile(filePath.c_str(), m_scene.voxels.snapshot(), m_scene.palette);
+    } else if (extension == ".cbe") {
+        CbeWriter writer(filePath);
+        return writer.writeFile(m_scene.voxels.snapshot(), m_scene.palette);
+    }
+
+    spdlog::error("[Batch] Unsupported save format : {}", filePath);
+    return false;
+}
+
+bool BatchRunner::exportMesh(const std::string& filePath) {
+    MeshExporter exporter;
+    return exporter.writeFile(filePath.c_str(), m_scene.voxels.snapshot(), m_scene.palette);
+}
+
+bool BatchRunner::generate() {
+    if (m_controlPoints.size() < 2) {
+        spdlog::error("[Batch] Generation needs at least 2 control points");
+        return false;
+    }
+
+    Eigen::VectorXd controlPointWeights(m_controlPointWeights.size());
+    for (size_t i = 0; i < m_controlPointWeights.size(); i++) {
+        controlPointWeights[i] = m_controlPointWeights.at(i);
+    }
+
+    generateRbf(m_scene, m_controlPoints, controlPointWeights);
+    return true;
+}
+
+bool BatchRunner::combine(const std::string& operation, const std::string& filePath, const glm::ivec3& offset) {
+    if (operation != "unite" && operation != "subtract" && operation != "intersect") {
+        spdlog::error("[Batch] Unknown csg operation : {}", operation);
+        return false;
+    }
+
+    StagingScene staged;
+    if (!loadFile(filePath, staged))
+        return false;
+
+    // Chunks are combined word by word, so the model is moved cell by cell first
+    VoxelGrid operand;
+    if (offset == glm::ivec3(0)) {
+        operand = std::move(staged.voxels);
+    } else {
+        for (const auto& chunk : staged.voxels.snapshot()) {
+            for (unsigned int index = 0; index < VoxelChunk::VOLUME; index++) {
+                if (chunk->has(index))
+                    operand.insert(chunk->cellPosition(index) + offset, met::null, chunk->materials[index]);
+            }
+        }
+    }
+
+    PROFILE_SCOPE("Batch csg");
+    if (operation == "unite")
+        m_scene.voxels.unite(operand, m_isCsgReplacing);
+    else if (operation == "subtract")
+        m_scene.voxels.subtract(operand);
+    else
+        m_scene.voxels.intersect(operand, m_isCsgReplacing);
+
+    spdlog::info("[Batch] {} with {} voxels from {}, {} voxels left", operation, operand.size(), filePath, m_scene.voxels.size());
+    return true;
+}
+
+bool BatchRunner::runScript(const std::string& filePath) {
+    std::ifstream file(filePath);
+    if (!file) {
+        spdlog::error("[Batch] Cannot open script : {}", filePath);
+        return false;
+    }
+
+    // A script running itself, directly or through others, would never end
+    std::error_code error;
+    std::string scriptPath = std::filesystem::weakly_canonical(filePath, error).string();
+    if (error)
+        scriptPath = filePath;
+    if (!m_runningScripts.insert(scriptPath).second) {
+        spdlog::error("[Batch] Script runs itself : {}", filePath);
+        return false;
+    }
+
+    bool success = true;
+    std::string line;
+    while (success && std::getline(file, line)) {
+        line = line.substr(0, line.find('#'));
+
+        std::vector<std::string> words;
+        std::istringstream stream(line);
+        std::string word;
+        while (stream >> word) {
+            words.push_back(word);
+        }
+
+        success = run(words);
+    }
+    m_runningScripts.erase(scriptPath);
+    return success;
+}
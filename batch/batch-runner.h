@@ -0,0 +1,51 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <unordered_set>
+#include <glm/glm.hpp>
+
+#include "scene/staging-scene.h"
+
+/**
+ * @brief Run editing commands on a scene without any window, to process models from scripts
+ * @note Commands are read in order, with their arguments following them.
+ */
+class BatchRunner {
+public:
+    BatchRunner();
+    ~BatchRunner();
+
+    /**
+     * @brief Run the commands in order. Stops at the first one failing.
+     * @return false if a command failed or is unknown
+     */
+    bool run(const std::vector<std::string>& words);
+
+    static void printUsage();
+
+private:
+    bool load(const std::string& filePath);
+
+    /**
+     * @brief Decode a .vox or .cbe model into the staged scene
+     */
+    bool loadFile(const std::string& filePath, StagingScene& staged) const;
+    bool save(const std::string& filePath);
+    bool exportMesh(const std::string& filePath);
+    bool generate();
+
+    /**
+     * @brief Combine the voxels of a model, moved by the offset, with the scene
+     */
+    bool combine(const std::string& operation, const std::string& filePath, const glm::ivec3& offset);
+    bool runScript(const std::string& filePath);
+
+private:
+    StagingScene m_scene;
+    std::vector<glm::ivec3> m_controlPoints;
+    std::vector<double> m_controlPointWeights;
+    unsigned int m_paletteCapacity;
+    bool m_isCsgReplacing; // Cells used by both models take the materials of the combined one
+    std::unordered_set<std::string> m_runningScripts; // Including the ones running the current script
+};
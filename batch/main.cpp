@@ -0,0 +1,20 @@
+#include <string>
+#include <vector>
+
+#include "batch-runner.h"
+
+int main(int argc, char *argv[]) {
+	if (argc < 2) {
+		BatchRunner::printUsage();
+		return 1;
+	}
+
+	const std::vector<std::string> words(argv + 1, argv + argc);
+	if (words.front() == "--help" || words.front() == "-h") {
+		BatchRunner::printUsage();
+		return 0;
+	}
+
+	BatchRunner runner;
+	return runner.run(words) ? 0 : 1;
+}
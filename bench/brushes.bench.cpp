@@ -0,0 +1,173 @@
+#include <catch2/catch.hpp>
+#include <met/met.hpp>
+#include <vector>
+#include <memory>
+
+#include "scene/voxel-editor.h"
+#include "history/brushes/brush-history.h"
+#include "maths/rasterization.h"
+#include "scene/flood-fill.h"
+
+namespace {
+    /**
+     * @brief Flat ground of the given size and 4 voxels high, centered on the origin
+     */
+    void fillGround(VoxelEditor& editor, int size) {
+        VoxelGrid staged;
+        for (int x = -size / 2; x < size / 2; x++) {
+            for (int z = -size / 2; z < size / 2; z++) {
+                for (int y = -4; y < 0; y++) {
+                    staged.insert(glm::ivec3(x, y, z), met::null, (x + z) & 15);
+                }
+            }
+        }
+        editor.load(staged);
+    }
+
+    /**
+     * @brief Same area than the box brush
+     */
+    std::vector<glm::ivec3> boxArea(const glm::ivec3& startPos, const glm::ivec3& endPos) {
+        std::vector<glm::ivec3> area;
+        for (int x = startPos.x; x <= endPos.x; x++) {
+            for (int y = startPos.y; y <= endPos.y; y++) {
+                for (int z = startPos.z; z <= endPos.z; z++) {
+                    area.push_back(glm::ivec3(x, y, z));
+                }
+            }
+        }
+        return area;
+    }
+
+    /**
+     * @brief Same cells than the circle brush
+     */
+    std::vector<glm::ivec3> sphereArea(int radius) {
+        std::vector<glm::ivec3> area;
+        area.reserve(static_cast<size_t>(4.2 * radius * radius * radius));
+        for (int y = -radius; y <= radius; y++) {
+            for (int z = -radius; z <= radius; z++) {
+                const int halfWidth = voxmt::ballRowHalfWidth(radius, y, z);
+                for (int x = -halfWidth; x <= halfWidth; x++) {
+                    area.push_back(glm::ivec3(x, y, z));
+                }
+            }
+        }
+        return area;
+    }
+}
+
+TEST_CASE("Box brush on growing scenes", "[brush]") {
+    const int groundSize = GENERATE(64, 256, 512);
+    const int boxSize = 32;
+    const std::string suffix = " 32^3 box on " + std::to_string(groundSize * groundSize * 4) + " voxels";
+
+    met::registry registry;
+    VoxelGrid grid;
+    VoxelEditor editor(registry, grid);
+    fillGround(editor, groundSize);
+
+    // Each run uses its own box above the ground, as adding twice at the same place does nothing
+    auto runBox = [boxSize](int run) {
+        const glm::ivec3 start(0, run * boxSize, 0);
+        return boxArea(start, start + glm::ivec3(boxSize - 1));
+    };
+
+    // Edits go through the histories, as when the brush is released
+    BENCHMARK_ADVANCED("Add" + suffix)(Catch::Benchmark::Chronometer meter) {
+        std::vector<std::unique_ptr<BrushHistory>> histories;
+        for (int run = 0; run < meter.runs(); run++) {
+            histories.emplace_back(new BrushHistory(editor, BrushUse::ADD, runBox(run), {}, 1));
+        }
+
+        meter.measure([&](int run) {
+            histories.at(run)->redo();
+        });
+
+        for (const auto& history : histories) {
+            history->undo();
+        }
+    };
+
+    BENCHMARK_ADVANCED("Remove" + suffix)(Catch::Benchmark::Chronometer meter) {
+        std::vector<std::unique_ptr<BrushHistory>> histories;
+        for (int run = 0; run < meter.runs(); run++) {
+            const std::vector<glm::ivec3> area = runBox(run);
+            const std::vector<unsigned int> materials(area.size(), 1);
+            editor.add(area, materials);
+            histories.emplace_back(new BrushHistory(editor, BrushUse::REMOVE, area, materials, 0));
+        }
+
+        meter.measure([&](int run) {
+            histories.at(run)->redo();
+        });
+    };
+
+    // Each run uses another material than the previous one, so that every voxel is changed
+    const std::vector<glm::ivec3> paintedArea = boxArea(glm::ivec3(-boxSize / 2, -4, -boxSize / 2), glm::ivec3(boxSize / 2 - 1, -1, boxSize / 2 - 1));
+    BENCHMARK_ADVANCED("Paint" + suffix)(Catch::Benchmark::Chronometer meter) {
+        std::vector<std::unique_ptr<BrushHistory>> histories;
+        for (int run = 0; run < meter.runs(); run++) {
+            std::vector<unsigned int> previousMaterials;
+            previousMaterials.reserve(paintedArea.size());
+            for (const glm::ivec3& pos : paintedArea) {
+                previousMaterials.push_back(run == 0 ? grid.material(pos) : 2 + ((run - 1) & 1));
+            }
+            histories.emplace_back(new BrushHistory(editor, BrushUse::PAINT, paintedArea, previousMaterials, 2 + (run & 1)));
+        }
+
+        meter.measure([&](int run) {
+            histories.at(run)->redo();
+        });
+    };
+}
+
+TEST_CASE("Sphere brush", "[brush]") {
+    const int radius = 64;
+    const std::string suffix = " sphere of radius " + std::to_string(radius);
+
+    BENCHMARK("Rasterize" + suffix) {
+        return sphereArea(radius).size();
+    };
+
+    // Applied in bulk on release, on an empty scene for each run
+    BENCHMARK_ADVANCED("Add" + suffix)(Catch::Benchmark::Chronometer meter) {
+        const std::vector<glm::ivec3> area = sphereArea(radius);
+        const std::vector<unsigned int> materials(area.size(), 1);
+        std::vector<std::unique_ptr<met::registry>> registries;
+        std::vector<std::unique_ptr<VoxelGrid>> grids;
+        std::vector<std::unique_ptr<VoxelEditor>> editors;
+        for (int run = 0; run < meter.runs(); run++) {
+            registries.push_back(std::make_unique<met::registry>());
+            grids.push_back(std::make_unique<VoxelGrid>());
+            editors.push_back(std::make_unique<VoxelEditor>(*registries.back(), *grids.back()));
+        }
+
+        meter.measure([&](int run) {
+            editors.at(run)->add(area, materials);
+        });
+    };
+}
+
+TEST_CASE("Fill brush", "[brush]") {
+    const int size = 100;
+    const std::string suffix = " cavity of " + std::to_string(size) + "^3 cells";
+
+    // Walls around the cavity
+    VoxelGrid grid;
+    for (int x = -1; x <= size; x++) {
+        for (int y = -1; y <= size; y++) {
+            for (int z = -1; z <= size; z++) {
+                const bool isWall = x == -1 || y == -1 || z == -1 || x == size || y == size || z == size;
+                if (isWall)
+                    grid.insert(glm::ivec3(x, y, z), met::null, 1);
+            }
+        }
+    }
+
+    BENCHMARK("Fill" + suffix) {
+        std::vector<glm::ivec3> cells;
+        floodFill(grid, glm::ivec3(size / 2), size, cells);
+        return cells.size();
+    };
+}
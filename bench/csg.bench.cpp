@@ -0,0 +1,74 @@
+#include <catch2/catch.hpp>
+#include <met/met.hpp>
+
+#include "scomponents/scene/voxel-grid.h"
+#include "scomponents/scene/selection.h"
+#include "scene/morphology.h"
+
+namespace {
+    VoxelGrid filledCube(const glm::ivec3& min, int size, unsigned int material) {
+        VoxelGrid grid;
+        for (int x = min.x; x < min.x + size; x++) {
+            for (int y = min.y; y < min.y + size; y++) {
+                for (int z = min.z; z < min.z + size; z++) {
+                    grid.insert(glm::ivec3(x, y, z), met::null, material);
+                }
+            }
+        }
+        return grid;
+    }
+}
+
+TEST_CASE("CSG of two 256^3 volumes", "[csg][large]") {
+    // Overlapping on half of their cells, with an offset which is not a multiple of the chunk size
+    const VoxelGrid a = filledCube(glm::ivec3(0), 256, 1);
+    const VoxelGrid b = filledCube(glm::ivec3(128, 3, 0), 256, 2);
+
+    BENCHMARK("Unite") {
+        VoxelGrid grid(a.snapshot());
+        grid.unite(b, true);
+        return grid.size();
+    };
+
+    BENCHMARK("Subtract") {
+        VoxelGrid grid(a.snapshot());
+        grid.subtract(b);
+        return grid.size();
+    };
+
+    BENCHMARK("Intersect") {
+        VoxelGrid grid(a.snapshot());
+        grid.intersect(b, true);
+        return grid.size();
+    };
+}
+
+TEST_CASE("Morphological filters on a 128^3 volume", "[csg][filter][large]") {
+    const VoxelGrid grid = filledCube(glm::ivec3(0), 128, 1);
+    Selection all;
+    for (int x = -1; x <= 128; x++) {
+        for (int y = -1; y <= 128; y++) {
+            for (int z = -1; z <= 128; z++) {
+                all.insert(glm::ivec3(x, y, z));
+            }
+        }
+    }
+
+    BENCHMARK("Dilate") {
+        VoxelGrid result;
+        filterVoxels(grid, all, MorphologyFilter::DILATE, result);
+        return result.size();
+    };
+
+    BENCHMARK("Smooth") {
+        VoxelGrid result;
+        filterVoxels(grid, all, MorphologyFilter::SMOOTH, result);
+        return result.size();
+    };
+
+    BENCHMARK("Close") {
+        VoxelGrid result;
+        filterVoxels(grid, all, MorphologyFilter::CLOSE, result);
+        return result.size();
+    };
+}
@@ -0,0 +1,83 @@
+#include <catch2/catch.hpp>
+#include <met/met.hpp>
+#include <vector>
+
+#include "components/physics/transform.h"
+#include "components/graphics/material.h"
+
+namespace {
+    void fill(met::registry& registry, int entityCount) {
+        std::vector<met::entity> ids(entityCount);
+        std::vector<comp::Transform> transforms(entityCount);
+        std::vector<comp::Material> materials(entityCount);
+        for (int i = 0; i < entityCount; i++) {
+            transforms.at(i).position = glm::ivec3(i % 1000, (i / 1000) % 1000, i / 1000000);
+            materials.at(i).sIndex = i % 16;
+        }
+        registry.create(ids.begin(), ids.end());
+        registry.assign<comp::Transform>(ids.begin(), ids.end(), transforms.begin());
+        registry.assign<comp::Material>(ids.begin(), ids.end(), materials.begin());
+    }
+}
+
+TEST_CASE("Registry operations", "[ecs]") {
+    const int entityCount = GENERATE(10000, 100000, 1000000);
+
+    BENCHMARK("Create and assign one by one " + std::to_string(entityCount)) {
+        met::registry registry;
+        for (int i = 0; i < entityCount; i++) {
+            const met::entity id = registry.create();
+            registry.assign<comp::Transform>(id, comp::Transform(glm::ivec3(i, 0, 0)));
+            registry.assign<comp::Material>(id, comp::Material());
+        }
+        return registry.alive();
+    };
+
+    BENCHMARK("Create and assign in bulk " + std::to_string(entityCount)) {
+        met::registry registry;
+        fill(registry, entityCount);
+        return registry.alive();
+    };
+
+    met::registry registry;
+    fill(registry, entityCount);
+    BENCHMARK("View " + std::to_string(entityCount)) {
+        int sum = 0;
+        registry.view<comp::Material, comp::Transform>().each([&sum](met::entity, comp::Material& material, comp::Transform& transform) {
+            sum += transform.position.x + material.sIndex;
+        });
+        return sum;
+    };
+
+    BENCHMARK_ADVANCED("Destroy " + std::to_string(entityCount))(Catch::Benchmark::Chronometer meter) {
+        std::vector<met::registry> registries(meter.runs());
+        for (met::registry& r : registries) {
+            fill(r, entityCount);
+        }
+        meter.measure([&registries, entityCount](int run) {
+            for (met::entity id = 1; id <= static_cast<met::entity>(entityCount); id++) {
+                registries.at(run).destroy(id);
+            }
+        });
+    };
+}
+
+TEST_CASE("Registry operations on very large scenes", "[.][ecs][large]") {
+    const int entityCount = 10000000;
+
+    BENCHMARK("Create and assign in bulk " + std::to_string(entityCount)) {
+        met::registry registry;
+        fill(registry, entityCount);
+        return registry.alive();
+    };
+
+    met::registry registry;
+    fill(registry, entityCount);
+    BENCHMARK("View " + std::to_string(entityCount)) {
+        int sum = 0;
+        registry.view<comp::Material, comp::Transform>().each([&sum](met::entity, comp::Material& material, comp::Transform& transform) {
+            sum += transform.position.x + material.sIndex;
+        });
+        return sum;
+    };
+}
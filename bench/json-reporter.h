@@ -0,0 +1,54 @@
+#pragma once
+
+#include <string>
+#include <catch2/catch.hpp>
+#include <nlohmann/json.hpp>
+
+/**
+ * @brief Write the results of the benchmarks as json, to compare them between releases
+ * @note Use it with "-r json -o results.json". Durations are in nanoseconds.
+ */
+class JsonReporter : public Catch::StreamingReporterBase<JsonReporter> {
+public:
+    JsonReporter(const Catch::ReporterConfig& config) : StreamingReporterBase(config) {
+        m_reporterPrefs.shouldReportAllAssertions = false;
+    }
+
+    static std::string getDescription() {
+        return "Reports the benchmarks as json";
+    }
+
+    void assertionStarting(const Catch::AssertionInfo&) override {}
+    bool assertionEnded(const Catch::AssertionStats&) override { return true; }
+
+    void benchmarkEnded(const Catch::BenchmarkStats<>& stats) override {
+        nlohmann::json benchmark;
+        benchmark["testCase"] = currentTestCaseInfo->name;
+        benchmark["name"] = stats.info.name;
+        benchmark["samples"] = stats.samples.size();
+        benchmark["iterations"] = stats.info.iterations;
+        benchmark["mean"] = { 
+            { "value", stats.mean.point.count() },
+            { "lowerBound", stats.mean.lower_bound.count() },
+            { "upperBound", stats.mean.upper_bound.count() }
+        };
+        benchmark["standardDeviation"] = {
+            { "value", stats.standardDeviation.point.count() },
+            { "lowerBound", stats.standardDeviation.lower_bound.count() },
+            { "upperBound", stats.standardDeviation.upper_bound.count() }
+        };
+        benchmark["outlierVariance"] = stats.outlierVariance;
+        m_benchmarks.push_back(benchmark);
+    }
+
+    void testRunEnded(const Catch::TestRunStats& stats) override {
+        nlohmann::json json;
+        json["name"] = stats.runInfo.name;
+        json["benchmarks"] = m_benchmarks;
+        stream << json.dump(4) << std::endl;
+        StreamingReporterBase::testRunEnded(stats);
+    }
+
+private:
+    nlohmann::json m_benchmarks = nlohmann::json::array();
+};
@@ -0,0 +1,40 @@
+#include <catch2/catch.hpp>
+#include <atomic>
+#include <filesystem>
+
+#include "loaders/cbe-loader.h"
+#include "loaders/cbe-writer.h"
+
+TEST_CASE("Cbe files", "[loading]") {
+    const int size = GENERATE(32, 128, 256);
+    const std::string suffix = " " + std::to_string(size) + "^2 x 16 voxels";
+    const std::filesystem::path directory = std::filesystem::temp_directory_path() / "cube-beast-editor-bench";
+    std::filesystem::create_directories(directory);
+    const std::string filePath = (directory / "scene.cbe").string();
+
+    VoxelGrid grid;
+    for (int x = 0; x < size; x++) {
+        for (int z = 0; z < size; z++) {
+            for (int y = 0; y < 16; y++) {
+                grid.insert(glm::ivec3(x, y, z), met::null, (x ^ z) & 15);
+            }
+        }
+    }
+    const std::vector<cb::perMaterialChange> palette(16, { glm::vec3(0.5f), 0.0f });
+
+    BENCHMARK("Save" + suffix) {
+        // A new writer does not know the chunks already written, so everything is written again
+        CbeWriter writer(filePath);
+        writer.writeFile(grid.snapshot(), palette);
+    };
+
+    BENCHMARK("Load" + suffix) {
+        StagingScene scene;
+        std::atomic<float> progress(0.0f);
+        CbeLoader loader;
+        loader.loadFile(filePath.c_str(), scene, progress);
+        return scene.voxels.size();
+    };
+
+    std::filesystem::remove_all(directory);
+}
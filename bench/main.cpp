@@ -0,0 +1,7 @@
+#define CATCH_CONFIG_MAIN
+#define CATCH_CONFIG_EXTERNAL_INTERFACES
+#include <catch2/catch.hpp>
+
+#include "json-reporter.h"
+
+CATCH_REGISTER_REPORTER("json", JsonReporter)
@@ -0,0 +1,32 @@
+#include <catch2/catch.hpp>
+#include <Eigen/Dense>
+#include <glm/glm.hpp>
+#include <vector>
+
+#include "maths/rbf.h"
+
+TEST_CASE("Radial basis function interpolation scaling", "[rbf]") {
+    const int controlPointCount = GENERATE(4, 16, 64);
+    const int planeSize = GENERATE(32, 128, 256);
+
+    std::vector<glm::ivec3> controlPoints;
+    Eigen::VectorXd weights(controlPointCount);
+    for (int i = 0; i < controlPointCount; i++) {
+        controlPoints.push_back(glm::ivec3((i * 37) % planeSize, i % 8, (i * 91) % planeSize));
+        weights(i) = 1.0 + (i % 3);
+    }
+
+    std::vector<glm::ivec3> plane;
+    plane.reserve(planeSize * planeSize);
+    for (int x = 0; x < planeSize; x++) {
+        for (int z = 0; z < planeSize; z++) {
+            plane.push_back(glm::ivec3(x, 0, z));
+        }
+    }
+
+    BENCHMARK(std::to_string(controlPointCount) + " control points on " + std::to_string(planeSize) + "^2 voxels") {
+        std::vector<glm::ivec3> coords = plane;
+        voxmt::rbfInterpolate(coords, controlPoints, weights, voxmt::RBFType::LINEAR, 0.5f, voxmt::RBFTransformAxis::Y);
+        return coords.back().y;
+    };
+}
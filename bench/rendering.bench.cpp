@@ -0,0 +1,39 @@
+#include <catch2/catch.hpp>
+#include <met/met.hpp>
+#include <vector>
+
+#include "components/physics/transform.h"
+#include "components/graphics/material.h"
+#include "maths/casting.h"
+
+TEST_CASE("Instance buffer packing", "[rendering]") {
+    const int entityCount = GENERATE(10000, 100000, 1000000);
+
+    met::registry registry;
+    std::vector<met::entity> ids(entityCount);
+    std::vector<comp::Transform> transforms(entityCount);
+    std::vector<comp::Material> materials(entityCount);
+    for (int i = 0; i < entityCount; i++) {
+        transforms.at(i).position = glm::ivec3(i % 1000, (i / 1000) % 1000, i / 1000000);
+        materials.at(i).sIndex = i % 16;
+    }
+    registry.create(ids.begin(), ids.end());
+    registry.assign<comp::Material>(ids.begin(), ids.end(), materials.begin());
+    registry.assign<comp::Transform>(ids.begin(), ids.end(), transforms.begin());
+
+    // Same packing than the render system does each frame before uploading the instance buffers
+    std::vector<glm::vec3> translations;
+    std::vector<glm::vec3> entityIds;
+    std::vector<unsigned int> materialIds;
+    BENCHMARK("Pack " + std::to_string(entityCount) + " instances") {
+        translations.clear();
+        entityIds.clear();
+        materialIds.clear();
+        registry.view<comp::Material, comp::Transform>().each([&](met::entity entity, comp::Material& material, comp::Transform& transform) {
+            translations.push_back(transform.position);
+            entityIds.push_back(voxmt::intToNormColor(entity));
+            materialIds.push_back(material.sIndex);
+        });
+        return translations.size();
+    };
+}
@@ -0,0 +1,122 @@
+#include <catch2/catch.hpp>
+#include <met/met.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <vector>
+
+#include "scomponents/scene/selection.h"
+#include "scene/screen-selection.h"
+#include "scomponents/scene/clipboard.h"
+#include "history/selection/paste-history.h"
+
+TEST_CASE("Selection of a 5M voxels scene", "[selection]") {
+    // 200 x 128 x 200 block
+    VoxelGrid grid;
+    for (int x = 0; x < 200; x++) {
+        for (int y = 0; y < 128; y++) {
+            for (int z = 0; z < 200; z++) {
+                grid.insert(glm::ivec3(x, y, z), met::null, 1);
+            }
+        }
+    }
+
+    Selection all;
+    all.selectAll(grid);
+    Selection half;
+    half.selectAll(grid);
+    half.translate(glm::ivec3(100, 0, 0));
+
+    BENCHMARK("Select all") {
+        Selection selection;
+        selection.selectAll(grid);
+        return selection.size();
+    };
+
+    BENCHMARK("Unite") {
+        Selection selection = all;
+        selection.unite(half);
+        return selection.size();
+    };
+
+    BENCHMARK("Subtract") {
+        Selection selection = all;
+        selection.subtract(half);
+        return selection.size();
+    };
+
+    BENCHMARK("Translate") {
+        Selection selection = all;
+        selection.translate(glm::ivec3(3, 1, -2));
+        return selection.size();
+    };
+
+    BENCHMARK("Positions") {
+        std::vector<glm::ivec3> positions;
+        positions.reserve(all.size());
+        all.positions(positions);
+        return positions.size();
+    };
+
+    // Camera facing the block, which fills most of the screen
+    const glm::mat4 proj = glm::perspectiveFovLH(glm::quarter_pi<float>(), 1280.0f, 720.0f, 0.1f, 1000.0f);
+    const glm::mat4 view = glm::lookAtLH(glm::vec3(100.0f, 64.0f, -300.0f), glm::vec3(100.0f, 64.0f, 100.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    const glm::mat4 viewProj = proj * view;
+
+    BENCHMARK("Marquee over half the screen") {
+        Selection selection;
+        selectInRectangle(grid, viewProj, glm::vec2(-1.0f, -1.0f), glm::vec2(0.0f, 1.0f), selection);
+        return selection.size();
+    };
+
+    BENCHMARK("Lasso over half the screen") {
+        const std::vector<glm::vec2> points = { glm::vec2(-1.0f, -1.0f), glm::vec2(0.0f, -1.0f), glm::vec2(0.0f, 1.0f), glm::vec2(-1.0f, 1.0f) };
+        Selection selection;
+        selectInLasso(grid, viewProj, points, selection);
+        return selection.size();
+    };
+}
+
+TEST_CASE("Clipboard of 1M voxels", "[selection]") {
+    // 100 x 100 x 100 block with stripes of materials
+    VoxelGrid copied;
+    for (int x = 0; x < 100; x++) {
+        for (int y = 0; y < 100; y++) {
+            for (int z = 0; z < 100; z++) {
+                copied.insert(glm::ivec3(x, y, z), met::null, y / 10);
+            }
+        }
+    }
+    Selection selection;
+    selection.selectAll(copied);
+
+    Clipboard clipboard;
+    clipboard.copy(copied, selection);
+
+    BENCHMARK("Copy") {
+        Clipboard copy;
+        copy.copy(copied, selection);
+        return copy.runCount();
+    };
+
+    BENCHMARK("Decode turned") {
+        std::vector<glm::ivec3> positions;
+        std::vector<unsigned int> materials;
+        clipboard.stamp(glm::ivec3(0), 1, true, positions, materials);
+        return positions.size();
+    };
+
+    // Stamped half over the block, so half of the voxels are painted
+    met::registry registry;
+    VoxelGrid grid;
+    VoxelEditor editor(registry, grid);
+    editor.load(copied);
+
+    BENCHMARK("Stamp and undo") {
+        std::vector<glm::ivec3> positions;
+        std::vector<unsigned int> materials;
+        clipboard.stamp(glm::ivec3(50, 0, 0), 1, false, positions, materials);
+        PasteHistory history(editor, grid, positions, materials);
+        history.redo();
+        history.undo();
+        return grid.size();
+    };
+}
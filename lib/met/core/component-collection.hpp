@@ -1,6 +1,7 @@
 #pragma once
 
 #include <array>
+#include <algorithm>
 #include <vector>
 #include <cassert>
 
@@ -40,6 +41,11 @@ namespace met {
         virtual void remove(entity id) = 0;
         virtual size_t size() const = 0;
 
+        /**
+         * @brief Get the number of bytes allocated by the collection
+         */
+        virtual size_t memoryUsage() const = 0;
+
     protected:
         std::vector<unsigned int> m_sparse; // Entity to component index
     };
@@ -68,7 +74,7 @@ namespace met {
         /**
          * @brief Insert a component to an entity
          */
-        void insert(entity id, T& component) {
+        void insert(entity id, const T& component) {
             assert(id != null && "Null entity cannot have components");
 
             if (m_sparse.size() <= id) {
@@ -87,6 +93,32 @@ namespace met {
             } 
         }
 
+        /**
+         * @brief Insert components to a range of entities, growing the arrays only once
+         */
+        template<typename It, typename CompIt>
+        void insert(It first, It last, CompIt components) {
+            size_t count = 0;
+            entity maxId = 0;
+            for (It it = first; it != last; ++it, ++count) {
+                maxId = std::max(maxId, *it);
+            }
+
+            if (m_sparse.size() <= maxId) {
+                m_sparse.resize(maxId + 1, null);
+            }
+            // Grown geometrically, so that small bulk inserts stay amortized
+            const size_t capacity = m_components.size() + count;
+            if (capacity > m_components.capacity()) {
+                m_dense.reserve(std::max(capacity, m_dense.capacity() * 2));
+                m_components.reserve(std::max(capacity, m_components.capacity() * 2));
+            }
+
+            for (; first != last; ++first, ++components) {
+                insert(*first, *components);
+            }
+        }
+
         /**
          * @brief Removes the component from the given entity
          */
@@ -122,6 +154,10 @@ namespace met {
             return m_components.size() - 1;
         }
 
+        size_t memoryUsage() const override {
+            return m_sparse.capacity() * sizeof(unsigned int) + m_dense.capacity() * sizeof(unsigned int) + m_components.capacity() * sizeof(T);
+        }
+
         // TODO handle sorting
 
     private:
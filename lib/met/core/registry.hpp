@@ -2,6 +2,7 @@
 
 #include <vector>
 #include <deque>
+#include <algorithm>
 #include <unordered_map>
 #include <typeinfo>
 #include <cassert>
@@ -12,6 +13,15 @@
 #include "view.hpp"
 
 namespace met {
+    /**
+     * @brief Statistics of a component collection
+     */
+    struct CollectionInfo {
+        std::string typeName; // As given by typeid
+        size_t size;
+        size_t memoryUsage; // In bytes
+    };
+
     /**
      * @brief The global data handler and entry point of this library
      */
@@ -41,6 +51,16 @@ namespace met {
             }
         }
 
+        /**
+         * @brief Create as many entities as the size of the range
+         */
+        template<typename It>
+        void create(It first, It last) {
+            for (; first != last; ++first) {
+                *first = create();
+            }
+        }
+
         /**
          * @brief Assign the given components to the given entity
          */
@@ -60,6 +80,24 @@ namespace met {
             }
         }
 
+        /**
+         * @brief Assign a range of components to a range of entities, allocating the storage once
+         */
+        template<typename T, typename It, typename CompIt>
+        void assign(It first, It last, CompIt components) {
+            if (first == last) {
+                return;
+            }
+
+            const std::type_info& type = typeid(T);
+            if (m_componentCollectionIndices.find(type.name()) == m_componentCollectionIndices.end()) {
+                assign<T>(*first, *components);
+                ++first;
+                ++components;
+            }
+            getCollection<T>()->insert(first, last, components);
+        }
+
         /**
          * @brief Says wether the entity has the given component or not
          */
@@ -142,6 +180,29 @@ namespace met {
             return view;
         }
 
+        /**
+         * @brief Get the number of entities which are not destroyed
+         */
+        size_t alive() const {
+            return m_lastMaxEntityId - m_unusedEntityIndices.size();
+        }
+
+        /**
+         * @brief Get the size and memory usage of each component type
+         * @note The vector is reused, so no memory is allocated once it has the right size
+         */
+        void collections(std::vector<CollectionInfo>& infos) const {
+            infos.resize(m_componentCollectionIndices.size());
+            size_t i = 0;
+            for (const auto& index : m_componentCollectionIndices) {
+                const IComponentCollection* collection = m_componentCollections.at(index.second);
+                infos.at(i).typeName = index.first;
+                infos.at(i).size = collection->size();
+                infos.at(i).memoryUsage = collection->memoryUsage();
+                i++;
+            }
+        }
+
         /**
          * @brief Get the asked component for the given entity
          */
@@ -171,12 +232,10 @@ namespace met {
         template<typename Comp>
         void removeUnmatchingEntities() {
             const ComponentCollection<Comp>* collection = getCollection<Comp>();
-            for (size_t i = 0; i < m_tempMatchingEntities.size(); ++i) {
-                const entity id = m_tempMatchingEntities.at(i);
-                if (!collection->has(id)) {
-                    m_tempMatchingEntities.erase(m_tempMatchingEntities.begin() + i);
-                }
-            }
+            // Erasing one by one was quadratic, and skipped the entity following each erased one
+            m_tempMatchingEntities.erase(std::remove_if(m_tempMatchingEntities.begin(), m_tempMatchingEntities.end(), [collection](entity id) {
+                return !collection->has(id);
+            }), m_tempMatchingEntities.end());
         }
 
         /**
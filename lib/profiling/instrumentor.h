@@ -2,15 +2,38 @@
 
 #include <string>
 #include <chrono>
-#include <algorithm>
 #include <fstream>
 #include <thread>
+#include <atomic>
+#include <mutex>
+#include <memory>
+#include <vector>
+#include <unordered_map>
+#include <deque>
+#include <ctime>
+#include <cstdint>
+#include <cstdio>
+#include <algorithm>
+#if (defined(__x86_64__) || defined(_M_X64)) && !defined(__EMSCRIPTEN__)
+    #define PROFILE_USE_TSC
+    #ifdef _MSC_VER
+        #include <intrin.h>
+    #else
+        #include <x86intrin.h>
+    #endif
+#endif
 
 // https://gist.github.com/TheCherno/31f135eea6ee729ab5f26a6908eb3a5e
 // Basic instrumentation profiler by Cherno. Modified for this project.
 // Open Google chrome and go to chrome://tracing/
 // Then you just have to drag'drop the json file generated
 
+// Scopes are stored as fixed-size events in a ring buffer owned by their thread, without locks.
+// A background thread drains them to keep the last frames in memory, and to a binary trace during a session.
+// Traces are converted to json when they are closed.
+
+// Scopes are always compiled, and only timed while the instrumentor is enabled.
+// Define BVE_PROFILE to record a session from the start of the application.
 // #define BVE_PROFILE
 
 #define CONCAT_(x,y) x##y
@@ -19,69 +42,460 @@
 #ifdef BVE_PROFILE
     #define PROFILE_BEGIN_SESSION(name, filepath) Instrumentor::get().beginSession(name, filepath)
     #define PROFILE_END_SESSION() Instrumentor::get().endSession()
-    #define PROFILE_SCOPE(name) InstrumentationTimer CONCAT(timer, __LINE__)(name)
 #else
     #define PROFILE_BEGIN_SESSION(name, filepath)
     #define PROFILE_END_SESSION()
-    #define PROFILE_SCOPE(name)
 #endif
+#define PROFILE_SCOPE(name) InstrumentationTimer CONCAT(timer, __LINE__)(name)
 
-struct ProfileResult {
-    std::string name;
-    long long start, end;
-    uint32_t threadID;
+/**
+ * @brief Scope timing. The name must outlive the session, like a string literal.
+ */
+struct ProfileEvent {
+    const char* name;
+    std::int64_t start; // Ticks of Instrumentor::ticks()
+    std::int64_t end;
 };
 
-struct InstrumentationSession {
-    std::string name;
+/**
+ * @brief Single producer single consumer queue of events. Events pushed when it is full are dropped.
+ */
+class ProfileRingBuffer {
+public:
+    static constexpr std::size_t CAPACITY = 1 << 14;
+
+    explicit ProfileRingBuffer(std::uint32_t threadId)
+        : m_events(CAPACITY), m_head(0), m_tail(0), m_dropped(0), m_released(false), m_threadId(threadId) {}
+
+    /**
+     * @brief Called by the owner thread only
+     */
+    void push(const ProfileEvent& event) {
+        const std::size_t head = m_head.load(std::memory_order_relaxed);
+        if (head - m_tail.load(std::memory_order_acquire) == CAPACITY) {
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        m_events[head & (CAPACITY - 1)] = event;
+        m_head.store(head + 1, std::memory_order_release);
+    }
+
+    /**
+     * @brief Called by the writer thread only
+     */
+    template<typename Function>
+    void drain(Function&& function) {
+        const std::size_t head = m_head.load(std::memory_order_acquire);
+        std::size_t tail = m_tail.load(std::memory_order_relaxed);
+        for (; tail != head; tail++) {
+            function(m_events[tail & (CAPACITY - 1)]);
+        }
+        m_tail.store(tail, std::memory_order_release);
+    }
+
+    void release() { m_released.store(true, std::memory_order_release); }
+    bool isReleased() const { return m_released.load(std::memory_order_acquire); }
+    std::uint64_t droppedCount() const { return m_dropped.load(std::memory_order_relaxed); }
+    std::uint32_t threadId() const { return m_threadId; }
+
+private:
+    std::vector<ProfileEvent> m_events;
+    alignas(64) std::atomic<std::size_t> m_head;
+    alignas(64) std::atomic<std::size_t> m_tail;
+    std::atomic<std::uint64_t> m_dropped;
+    std::atomic<bool> m_released; // The thread exited, the buffer can be removed once drained
+    std::uint32_t m_threadId;
+};
+
+/**
+ * @brief Binary trace records. Names are written once, then referenced by their id.
+ */
+namespace trace {
+    const char MAGIC[4] = { 'B', 'V', 'E', 'T' };
+    const std::uint32_t VERSION = 1;
+    const std::uint32_t GPU_THREAD_ID = 0xFFFF; // Track of the gpu timer queries, shown after the threads
+
+    enum class RecordType : std::uint8_t { NAME = 1, EVENT = 2, CLOCK = 3 };
+
+    struct EventRecord {
+        std::uint32_t nameId;
+        std::uint32_t threadId;
+        std::int64_t start;
+        std::int64_t end;
+    };
+
+    /**
+     * @brief Written last, to convert ticks to nanoseconds
+     */
+    struct ClockRecord {
+        std::int64_t startTicks;
+        std::int64_t startNs;
+        std::int64_t endTicks;
+        std::int64_t endNs;
+    };
+
+    /**
+     * @brief Convert a binary trace to the json format of chrome://tracing
+     * @param processName - Shown as the name of the process track, if not empty
+     * @return false if the trace cannot be read or the json cannot be written
+     */
+    inline bool convertToJson(const std::string& tracePath, const std::string& jsonPath, std::string processName = "") {
+        std::ifstream input(tracePath, std::ios::binary);
+        std::ofstream output(jsonPath);
+        if (!input || !output)
+            return false;
+
+        char magic[4];
+        std::uint32_t version = 0;
+        input.read(magic, sizeof(magic));
+        input.read(reinterpret_cast<char*>(&version), sizeof(version));
+        if (!input || std::string(magic, 4) != std::string(MAGIC, 4) || version != VERSION)
+            return false;
+
+        // Without a clock record, the session did not end properly and ticks are kept as is
+        double nsPerTick = 1.0;
+        std::int64_t startTicks = 0;
+        std::int64_t startNs = 0;
+        const std::streamoff dataStart = input.tellg();
+        input.seekg(-static_cast<std::streamoff>(sizeof(ClockRecord) + 1), std::ios::end);
+        std::uint8_t lastType = 0;
+        ClockRecord clock;
+        if (input.tellg() >= dataStart && input.read(reinterpret_cast<char*>(&lastType), sizeof(lastType))
+            && lastType == static_cast<std::uint8_t>(RecordType::CLOCK) && input.read(reinterpret_cast<char*>(&clock), sizeof(clock))
+            && clock.endTicks > clock.startTicks) {
+            nsPerTick = static_cast<double>(clock.endNs - clock.startNs) / (clock.endTicks - clock.startTicks);
+            startTicks = clock.startTicks;
+            startNs = clock.startNs;
+        }
+        input.clear();
+        input.seekg(dataStart);
+
+        std::vector<std::string> names;
+        std::string buffer = "{\"otherData\": {},\"traceEvents\":[";
+        bool isFirst = true;
+        if (!processName.empty()) {
+            for (char& c : processName) {
+                if (c == '"' || c == '\\')
+                    c = '\'';
+            }
+            buffer += "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":0,\"args\":{\"name\":\"" + processName + "\"}}";
+            isFirst = false;
+        }
+        bool hasGpuTrack = false;
+        std::uint8_t type = 0;
+        while (input.read(reinterpret_cast<char*>(&type), sizeof(type))) {
+            if (type == static_cast<std::uint8_t>(RecordType::NAME)) {
+                std::uint32_t length = 0;
+                input.read(reinterpret_cast<char*>(&length), sizeof(length));
+                std::string name(length, '\0');
+                input.read(&name[0], length);
+                for (char& c : name) {
+                    if (c == '"' || c == '\\')
+                        c = '\'';
+                }
+                names.push_back(name);
+            } else if (type == static_cast<std::uint8_t>(RecordType::EVENT)) {
+                EventRecord record;
+                input.read(reinterpret_cast<char*>(&record), sizeof(record));
+                if (!input || record.nameId >= names.size())
+                    return false;
+
+                const double start = startNs + (record.start - startTicks) * nsPerTick;
+                const double duration = (record.end - record.start) * nsPerTick;
+                char line[128];
+                if (record.threadId == GPU_THREAD_ID && !hasGpuTrack) {
+                    std::snprintf(line, sizeof(line), "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":%u,\"args\":{\"name\":\"GPU\"}}", GPU_THREAD_ID);
+                    buffer += isFirst ? "" : ",";
+                    buffer += line;
+                    isFirst = false;
+                    hasGpuTrack = true;
+                }
+                std::snprintf(line, sizeof(line), "\"dur\":%.3f,", duration / 1000.0);
+                buffer += isFirst ? "{" : ",{";
+                buffer += "\"cat\":\"function\",";
+                buffer += line;
+                buffer += "\"name\":\"" + names.at(record.nameId) + "\",";
+                std::snprintf(line, sizeof(line), "\"ph\":\"X\",\"pid\":0,\"tid\":%u,\"ts\":%.3f}", record.threadId, start / 1000.0);
+                buffer += line;
+                isFirst = false;
+
+                if (buffer.size() > (1 << 20)) {
+                    output << buffer;
+                    buffer.clear();
+                }
+            } else if (type == static_cast<std::uint8_t>(RecordType::CLOCK)) {
+                break;
+            } else {
+                return false;
+            }
+        }
+
+        buffer += "]}";
+        output << buffer;
+        return output.good();
+    }
+
+    /**
+     * @brief Write events to a binary trace, and names the first time they are used
+     */
+    class Writer {
+    public:
+        bool open(const std::string& tracePath) {
+            m_file.open(tracePath, std::ios::binary);
+            m_file.write(MAGIC, sizeof(MAGIC));
+            m_file.write(reinterpret_cast<const char*>(&VERSION), sizeof(VERSION));
+            m_nameIds.clear();
+            return m_file.good();
+        }
+
+        bool isOpen() const { return m_file.is_open(); }
+
+        void write(const char* name, std::uint32_t threadId, std::int64_t start, std::int64_t end) {
+            const EventRecord record = { nameId(name), threadId, start, end };
+            const RecordType type = RecordType::EVENT;
+            m_file.write(reinterpret_cast<const char*>(&type), sizeof(type));
+            m_file.write(reinterpret_cast<const char*>(&record), sizeof(record));
+        }
+
+        void close(const ClockRecord& clock) {
+            const RecordType type = RecordType::CLOCK;
+            m_file.write(reinterpret_cast<const char*>(&type), sizeof(type));
+            m_file.write(reinterpret_cast<const char*>(&clock), sizeof(clock));
+            m_file.close();
+        }
+
+    private:
+        std::uint32_t nameId(const char* name) {
+            const auto it = m_nameIds.find(name);
+            if (it != m_nameIds.end())
+                return it->second;
+
+            const std::uint32_t id = static_cast<std::uint32_t>(m_nameIds.size());
+            const std::uint32_t length = static_cast<std::uint32_t>(std::char_traits<char>::length(name));
+            const RecordType type = RecordType::NAME;
+            m_file.write(reinterpret_cast<const char*>(&type), sizeof(type));
+            m_file.write(reinterpret_cast<const char*>(&length), sizeof(length));
+            m_file.write(name, length);
+            m_nameIds.emplace(name, id);
+            return id;
+        }
+
+    private:
+        std::ofstream m_file;
+        std::unordered_map<const char*, std::uint32_t> m_nameIds;
+    };
+}
+
+/**
+ * @brief Time spent in all the scopes of a name
+ */
+struct ScopeDuration {
+    const char* name;
+    double milliseconds;
 };
 
 class Instrumentor {
 public:
-    Instrumentor() : m_currentSession(nullptr), m_profileCount(0) {}
+    Instrumentor() : m_isEnabled(false), m_isWriting(false), m_sessionId(0), m_nextThreadId(0), m_lastFrame({ nullptr, 0, 0, 0 }), m_capturedFrameCount(300), m_lastFrameStart(0) {}
+
+    ~Instrumentor() {
+        setEnabled(false);
+    }
 
+    /**
+     * @brief Start or stop timing the scopes. While enabled, the last frames are kept in memory.
+     */
+    void setEnabled(bool enabled) {
+        if (enabled == m_isEnabled.load())
+            return;
+
+        if (enabled) {
+            std::lock_guard<std::mutex> lock(m_writerMutex);
+            m_history.clear();
+            m_frameStarts.clear();
+            m_lastFrame = { nullptr, 0, 0, 0 };
+            m_clock.startTicks = ticks();
+            m_clock.startNs = nanoseconds();
+            m_lastFrameStart = m_clock.startTicks;
+            m_sessionId++;
+            {
+                std::lock_guard<std::mutex> buffersLock(m_buffersMutex);
+                m_gpuBuffer = std::make_shared<ProfileRingBuffer>(trace::GPU_THREAD_ID);
+                m_buffers.push_back(m_gpuBuffer);
+            }
+            m_isEnabled = true;
+
+            // Without threads, events are drained once per frame
+#ifndef __EMSCRIPTEN__
+            m_isWriting = true;
+            m_writer = std::thread([this]() {
+                while (m_isWriting.load(std::memory_order_acquire)) {
+                    drain();
+                    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+                }
+            });
+#endif
+        } else {
+            m_isEnabled = false;
+            m_isWriting = false;
+            if (m_writer.joinable())
+                m_writer.join();
+            drain();
+            closeSession();
+
+            std::lock_guard<std::mutex> lock(m_buffersMutex);
+            m_buffers.clear();
+            m_gpuBuffer.reset();
+            m_nextThreadId = 0;
+        }
+    }
+
+    bool isEnabled() const { return m_isEnabled.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Also write every event to a binary trace, converted to json by endSession.
+     * @param name - Name of the process in the json trace
+     */
     void beginSession(const std::string& name, const std::string& filepath = "beast-voxel-editor-profiling.json") {
-        m_outputStream.open(filepath);
-        writeHeader();
-        m_currentSession = new InstrumentationSession{ name };
+        setEnabled(true);
+
+        std::lock_guard<std::mutex> lock(m_writerMutex);
+        closeSession();
+        m_sessionName = name;
+        m_jsonPath = filepath;
+        m_session.open(tracePathOf(filepath));
     }
 
     void endSession() {
-        writeFooter();
-        m_outputStream.close();
-        delete m_currentSession;
-        m_currentSession = nullptr;
-        m_profileCount = 0;
+        setEnabled(false);
     }
 
-    void writeProfile(const ProfileResult& result) {
-        if (m_profileCount++ > 0)
-            m_outputStream << ",";
+    /**
+     * @brief Called by the main thread at the start of each frame. Frames are kept in the captures.
+     */
+    void markFrame() {
+        if (!isEnabled())
+            return;
+
+        const std::int64_t now = ticks();
+        record({ FRAME_NAME, m_lastFrameStart, now });
+        m_lastFrameStart = now;
+#ifdef __EMSCRIPTEN__
+        drain();
+#endif
+    }
 
-        std::string name = result.name;
-        std::replace(name.begin(), name.end(), '"', '\'');
+    void setCapturedFrameCount(unsigned int count) { m_capturedFrameCount = count; }
+    unsigned int capturedFrameCount() const { return m_capturedFrameCount; }
 
-        m_outputStream << "{";
-        m_outputStream << "\"cat\":\"function\",";
-        m_outputStream << "\"dur\":" << (result.end - result.start) << ',';
-        m_outputStream << "\"name\":\"" << name << "\",";
-        m_outputStream << "\"ph\":\"X\",";
-        m_outputStream << "\"pid\":0,";
-        m_outputStream << "\"tid\":" << result.threadID << ",";
-        m_outputStream << "\"ts\":" << result.start;
-        m_outputStream << "}";
+    /**
+     * @brief Write the last frames kept in memory to a json file for chrome://tracing
+     * @return false if there is nothing to write or the file cannot be written
+     */
+    bool saveCapture(const std::string& jsonPath) {
+        drain();
 
-        m_outputStream.flush();
+        std::lock_guard<std::mutex> lock(m_writerMutex);
+        if (m_history.empty())
+            return false;
+
+        const std::string tracePath = tracePathOf(jsonPath);
+        trace::Writer writer;
+        if (!writer.open(tracePath))
+            return false;
+        for (const CapturedEvent& event : m_history) {
+            writer.write(event.name, event.threadId, event.start, event.end);
+        }
+        writer.close(currentClock());
+
+        const bool success = trace::convertToJson(tracePath, jsonPath);
+        std::remove(tracePath.c_str());
+        return success;
+    }
+
+    /**
+     * @brief Save the capture in the working directory, named after the current date
+     * @return The path of the json file, empty if it could not be written
+     */
+    std::string saveCapture() {
+        const std::time_t time = std::time(nullptr);
+        char fileName[64];
+        std::strftime(fileName, sizeof(fileName), "bve-capture-%Y%m%d-%H%M%S.json", std::localtime(&time));
+        return saveCapture(fileName) ? fileName : "";
+    }
+
+    /**
+     * @brief Time spent in each scope name, on every thread, during the last frame fully drained
+     * @note Nested scopes are counted in their parents too. The vector is reused, to not allocate each frame.
+     */
+    void lastFrameDurations(std::vector<ScopeDuration>& durations) {
+        durations.clear();
+        std::lock_guard<std::mutex> lock(m_writerMutex);
+        if (m_lastFrame.name == nullptr || m_history.empty())
+            return;
+
+        const trace::ClockRecord clock = currentClock();
+        const double msPerTick = clock.endTicks > clock.startTicks ? (clock.endNs - clock.startNs) / 1e6 / (clock.endTicks - clock.startTicks) : 1e-6;
+
+        // Events are only sorted by thread, so older ones are scanned up to a margin
+        const std::int64_t scanLimit = m_lastFrame.start - static_cast<std::int64_t>(50.0 / msPerTick);
+        for (auto it = m_history.rbegin(); it != m_history.rend() && it->end >= scanLimit; ++it) {
+            if (it->name == FRAME_NAME || it->threadId == trace::GPU_THREAD_ID || it->start < m_lastFrame.start || it->end > m_lastFrame.end)
+                continue;
+
+            const double milliseconds = (it->end - it->start) * msPerTick;
+            const auto duration = std::find_if(durations.begin(), durations.end(), [it](const ScopeDuration& d) { return d.name == it->name; });
+            if (duration != durations.end())
+                duration->milliseconds += milliseconds;
+            else
+                durations.push_back({ it->name, milliseconds });
+        }
+    }
+
+    /**
+     * @brief Store an event in the buffer of the calling thread
+     */
+    void record(const ProfileEvent& event) {
+        if (!isEnabled())
+            return;
+
+        ThreadBuffer& local = threadBuffer();
+        if (local.buffer == nullptr || local.sessionId != m_sessionId.load(std::memory_order_relaxed))
+            registerThread(local);
+        local.buffer->push(event);
     }
 
-    void writeHeader() {
-        m_outputStream << "{\"otherData\": {},\"traceEvents\":[";
-        m_outputStream.flush();
+    /**
+     * @brief Store an event measured by the gpu, on its own track. Called by the main thread only.
+     */
+    void recordGpu(const ProfileEvent& event) {
+        if (isEnabled() && m_gpuBuffer != nullptr)
+            m_gpuBuffer->push(event);
     }
 
-    void writeFooter() {
-        m_outputStream << "]}";
-        m_outputStream.flush();
+    /**
+     * @brief Ratio between ticks() and nanoseconds(), measured since the instrumentor was enabled
+     */
+    double ticksPerNanosecond() const {
+        const std::int64_t elapsedNs = nanoseconds() - m_clock.startNs;
+        if (!isEnabled() || elapsedNs <= 0)
+            return 1.0;
+        return static_cast<double>(ticks() - m_clock.startTicks) / elapsedNs;
+    }
+
+    /**
+     * @brief Timestamp counter of the cpu when available, as it is cheaper to read than the system clock
+     */
+    static std::int64_t ticks() {
+#ifdef PROFILE_USE_TSC
+        return static_cast<std::int64_t>(__rdtsc());
+#else
+        return nanoseconds();
+#endif
+    }
+
+    static std::int64_t nanoseconds() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
     }
 
     static Instrumentor& get() {
@@ -89,37 +503,170 @@ public:
         return instance;
     }
 
+public:
+    static constexpr const char* FRAME_NAME = "Frame";
+    static constexpr std::size_t MAX_HISTORY_SIZE = 1 << 20; // In case frames are not marked
+
+private:
+    struct ThreadBuffer {
+        ~ThreadBuffer() {
+            if (buffer != nullptr)
+                buffer->release();
+        }
+
+        std::shared_ptr<ProfileRingBuffer> buffer;
+        std::uint32_t sessionId = 0;
+    };
+
+    struct CapturedEvent {
+        const char* name;
+        std::uint32_t threadId;
+        std::int64_t start;
+        std::int64_t end;
+    };
+
+    static ThreadBuffer& threadBuffer() {
+        static thread_local ThreadBuffer local;
+        return local;
+    }
+
+    static std::string tracePathOf(const std::string& jsonPath) {
+        return jsonPath.substr(0, jsonPath.find_last_of('.')) + ".trace";
+    }
+
+    trace::ClockRecord currentClock() const {
+        trace::ClockRecord clock = m_clock;
+        clock.endTicks = ticks();
+        clock.endNs = nanoseconds();
+        return clock;
+    }
+
+    /**
+     * @brief Called once per thread each time the instrumentor is enabled
+     */
+    void registerThread(ThreadBuffer& local) {
+        std::lock_guard<std::mutex> lock(m_buffersMutex);
+        if (local.buffer != nullptr)
+            local.buffer->release();
+        local.buffer = std::make_shared<ProfileRingBuffer>(m_nextThreadId++);
+        local.sessionId = m_sessionId;
+        m_buffers.push_back(local.buffer);
+    }
+
+    /**
+     * @brief Move the pending events of every thread to the history and to the session trace
+     */
+    void drain() {
+        std::vector<std::shared_ptr<ProfileRingBuffer>> buffers;
+        {
+            std::lock_guard<std::mutex> lock(m_buffersMutex);
+            buffers = m_buffers;
+        }
+
+        std::lock_guard<std::mutex> lock(m_writerMutex);
+        for (const auto& buffer : buffers) {
+            // Checked before draining, so the last events of an exited thread are not lost
+            const bool isReleased = buffer->isReleased();
+            buffer->drain([this, &buffer](const ProfileEvent& event) {
+                m_history.push_back({ event.name, buffer->threadId(), event.start, event.end });
+                if (event.name == FRAME_NAME) {
+                    m_frameStarts.push_back(event.start);
+                    m_lastFrame = m_history.back();
+                }
+                if (m_session.isOpen())
+                    m_session.write(event.name, buffer->threadId(), event.start, event.end);
+            });
+
+            if (isReleased) {
+                std::lock_guard<std::mutex> buffersLock(m_buffersMutex);
+                m_buffers.erase(std::remove(m_buffers.begin(), m_buffers.end(), buffer), m_buffers.end());
+            }
+        }
+
+        // Only the last frames are kept
+        while (m_frameStarts.size() > m_capturedFrameCount) {
+            m_frameStarts.pop_front();
+        }
+        if (!m_frameStarts.empty()) {
+            while (!m_history.empty() && m_history.front().end <= m_frameStarts.front()) {
+                m_history.pop_front();
+            }
+        }
+        while (m_history.size() > MAX_HISTORY_SIZE) {
+            m_history.pop_front();
+        }
+    }
+
+    /**
+     * @brief Must be called with the writer mutex locked, or once the writer thread stopped
+     */
+    void closeSession() {
+        if (!m_session.isOpen())
+            return;
+
+        m_session.close(currentClock());
+        trace::convertToJson(tracePathOf(m_jsonPath), m_jsonPath, m_sessionName);
+
+        std::uint64_t droppedCount = 0;
+        std::lock_guard<std::mutex> lock(m_buffersMutex);
+        for (const auto& buffer : m_buffers) {
+            droppedCount += buffer->droppedCount();
+        }
+        if (droppedCount > 0)
+            std::fprintf(stderr, "[Profiling] %llu events dropped, the writer thread could not keep up\n", static_cast<unsigned long long>(droppedCount));
+    }
+
 private:
-    InstrumentationSession* m_currentSession;
-    std::ofstream m_outputStream;
-    int m_profileCount;
+    std::atomic<bool> m_isEnabled;
+    std::atomic<bool> m_isWriting;
+    std::atomic<std::uint32_t> m_sessionId;
+    std::thread m_writer;
+
+    std::mutex m_buffersMutex;
+    std::vector<std::shared_ptr<ProfileRingBuffer>> m_buffers;
+    std::shared_ptr<ProfileRingBuffer> m_gpuBuffer;
+    std::uint32_t m_nextThreadId;
+
+    // Locked by the writer mutex
+    std::mutex m_writerMutex;
+    std::deque<CapturedEvent> m_history;
+    std::deque<std::int64_t> m_frameStarts;
+    CapturedEvent m_lastFrame;
+    std::atomic<unsigned int> m_capturedFrameCount;
+    trace::Writer m_session;
+    std::string m_sessionName;
+    std::string m_jsonPath;
+    trace::ClockRecord m_clock;
+
+    // Only used by the main thread
+    std::int64_t m_lastFrameStart;
 };
 
+/**
+ * @brief Time the scope while the instrumentor is enabled
+ */
 class InstrumentationTimer {
 public:
-    InstrumentationTimer(const char* name) : m_name(name), m_stopped(false) {
-        m_startTimepoint = std::chrono::high_resolution_clock::now();
+    InstrumentationTimer(const char* name) : m_name(nullptr), m_start(0) {
+        if (Instrumentor::get().isEnabled()) {
+            m_name = name;
+            m_start = Instrumentor::ticks();
+        }
     }
 
     ~InstrumentationTimer() {
-        if (!m_stopped)
-            stop();
+        stop();
     }
 
     void stop() {
-        auto endTimepoint = std::chrono::high_resolution_clock::now();
-
-        long long start = std::chrono::time_point_cast<std::chrono::microseconds>(m_startTimepoint).time_since_epoch().count();
-        long long end = std::chrono::time_point_cast<std::chrono::microseconds>(endTimepoint).time_since_epoch().count();
-
-        uint32_t threadID = std::hash<std::thread::id>{}(std::this_thread::get_id());
-        Instrumentor::get().writeProfile({ m_name, start, end, threadID });
+        if (m_name == nullptr)
+            return;
 
-        m_stopped = true;
+        Instrumentor::get().record({ m_name, m_start, Instrumentor::ticks() });
+        m_name = nullptr;
     }
 
 private:
     const char* m_name;
-    std::chrono::time_point<std::chrono::high_resolution_clock> m_startTimepoint;
-    bool m_stopped;
+    std::int64_t m_start;
 };
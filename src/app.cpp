@@ -7,16 +7,23 @@
 #include <imgui/imgui_impl_opengl3.h>
 #include <stb_image/stb_image.h>
 #include <profiling/instrumentor.h>
+#include <algorithm>
+#include <fstream>
+#include <numeric>
 #ifdef __EMSCRIPTEN__
 	#include <emscripten.h>
 #endif
 
 #include "graphics/gl-exception.h"
+#include "graphics/gpu-profiler.h"
 
 #include "systems/render-system.h"
 #include "systems/camera-system.h"
 #include "systems/selection-system.h"
 #include "systems/brush-system.h"
+#include "systems/autosave-system.h"
+#include "systems/loading-system.h"
+#include "systems/command-system.h"
 
 #include "gui/font-ruda.h"
 #include "gui/font-awesome.h"
@@ -24,22 +31,28 @@
 #include "gui/icons.h"
 #include "gui/brush-gui.h"
 #include "gui/context-info-bar-gui.h"
+#include "gui/csg-gui.h"
 #include "gui/generation-gui.h"
 #include "gui/main-menu-bar-gui.h"
 #include "gui/palette-gui.h"
+#include "gui/performance-gui.h"
 #include "gui/scene-outline-gui.h"
+#include "gui/selection-gui.h"
 #include "gui/viewport-gui.h"
 #include "gui/viewport-option-bar-gui.h"
+#include "recording/input-recording.h"
+#include "memory/allocation-counter.h"
 
 bool App::m_instanciated = false;
 
-App::App() : m_running(true), m_ctx(m_scomps) {
+App::App(const AppOptions& options) : m_running(true), m_options(options), m_ctx(m_scomps) {
 	// Ensure that there is only one app
     assert(!m_instanciated && "Application already instanciated !");
 	m_instanciated = true;
     
 	// Start application
 	spdlog::set_pattern("[%l] %^ %v %$");
+	Instrumentor::get().setEnabled(true);
 	PROFILE_BEGIN_SESSION("Beast voxel editor", "bve-profiling.json");
 	PROFILE_SCOPE("Init application");
 	initSDL();
@@ -57,10 +70,13 @@ App::App() : m_running(true), m_ctx(m_scomps) {
 		new MainMenuBarGui(m_ctx, m_scomps),
         new ViewportGui(m_ctx, m_scomps),
 		new BrushGui(m_ctx, m_scomps),
+		new SelectionGui(m_ctx, m_scomps),
+		new CsgGui(m_ctx, m_scomps),
 		new ContextInfoBarGui(m_ctx, m_scomps),
 		new GenerationGui(m_ctx, m_scomps),
 		new PaletteGui(m_ctx, m_scomps),
 		new SceneOutlineGui(m_ctx, m_scomps),
+		new PerformanceGui(m_ctx, m_scomps),
 		new ViewportOptionBarGui(m_ctx, m_scomps)
     };
 
@@ -73,11 +89,26 @@ App::App() : m_running(true), m_ctx(m_scomps) {
 
 	// Order system updates
 	m_systems = {
+		new CommandSystem(m_ctx, m_scomps),
 		new RenderSystem(m_ctx, m_scomps),
 		new SelectionSystem(m_ctx, m_scomps),
 		new CameraSystem(m_scomps),
 		new BrushSystem(m_ctx, m_scomps)
 	};
+#ifndef __EMSCRIPTEN__
+	m_systems.insert(m_systems.begin(), new LoadingSystem(m_ctx, m_scomps));
+	m_systems.push_back(new AutosaveSystem(m_ctx, m_scomps));
+#endif
+
+	// Record or replay editing sessions
+	if (!m_options.recordPath.empty() && m_recorder.open(m_options.recordPath))
+		spdlog::info("[App] Recording inputs to {}", m_options.recordPath);
+	if (!m_options.replayPath.empty()) {
+		if (m_replay.open(m_options.replayPath))
+			spdlog::info("[App] Replaying inputs from {}", m_options.replayPath);
+		else
+			exit();
+	}
 }
 
 App::~App() {
@@ -109,14 +140,31 @@ App::~App() {
 
 
 void App::update() {
+	const std::int64_t frameStart = Instrumentor::nanoseconds();
+	allocation::markFrame();
+	Instrumentor::get().markFrame();
+	GpuProfiler::get().markFrame();
 	PROFILE_SCOPE("Update application");
+	m_ctx.rcommand.resetStats();
 
 	// Feed inputs
 	handleSDLEvents();
+	if (m_replay.isReplaying()) {
+		InputFrame frame;
+		if (!m_replay.next(frame)) {
+			endReplay();
+			return;
+		}
+		applyInputs(frame);
+	}
 	ImGui_ImplOpenGL3_NewFrame();
 	ImGui_ImplSDL2_NewFrame(m_window);
 	ImGui::NewFrame();
 
+	// Inputs are recorded as the systems will read them
+	if (m_recorder.isRecording())
+		m_recorder.record(captureInputs());
+
 	// Update our app
 	for (ISystem* system : m_systems) {
 		system->update();
@@ -143,8 +191,13 @@ void App::update() {
 	// Reset input deltas
 	m_scomps.inputs.m_posDelta = glm::vec2(0.0f);
 	m_scomps.inputs.m_wheelDelta = 0;
+	m_scomps.inputs.m_ndcMouseSamples.clear();
 
 	SDL_GL_SwapWindow(m_window);
+	m_ctx.frameArena.reset();
+
+	if (m_replay.isReplaying())
+		m_frameTimes.push_back((Instrumentor::nanoseconds() - frameStart) / 1e6);
 }
 
 /////////////////////////////////////////////////////////////////////////////
@@ -154,6 +207,13 @@ void App::update() {
 void App::handleSDLEvents() {
     SDL_Event e;
     while (SDL_PollEvent(&e)) {
+		// The recording replaces the user inputs
+		if (m_replay.isReplaying()) {
+			if (e.type == SDL_QUIT)
+				exit();
+			continue;
+		}
+
         ImGui_ImplSDL2_ProcessEvent(&e);
         switch (e.type) {
         case SDL_QUIT: exit(); break;
@@ -170,6 +230,7 @@ void App::handleSDLEvents() {
             m_scomps.inputs.m_mousePos.y = static_cast<float>(e.button.y - m_scomps.viewport.posTopLeft().y);
 			m_scomps.inputs.m_ndcMousePos.x = ((float) m_scomps.inputs.mousePos().x / m_scomps.viewport.size().x) * 2.0f - 1.0f;
 			m_scomps.inputs.m_ndcMousePos.y = -(((float) m_scomps.inputs.mousePos().y / m_scomps.viewport.size().y) * 2.0f - 1.0f);
+			m_scomps.inputs.m_ndcMouseSamples.push_back(m_scomps.inputs.ndcMousePos());
             break;
         
         case SDL_MOUSEBUTTONDOWN:
@@ -193,6 +254,10 @@ void App::handleSDLEvents() {
 		case SDL_KEYDOWN:
 			if (e.key.keysym.sym == SDLK_s) {
 				m_scomps.inputs.m_actionState.at(static_cast<unsigned int>(InputAction::DEBUG)) = true;
+			} else if (e.key.keysym.sym == SDLK_F12) {
+				const std::string filePath = Instrumentor::get().saveCapture();
+				if (!filePath.empty())
+					spdlog::info("[Profiling] Last frames saved to {}", filePath);
 			}
 
         default: break;
@@ -203,6 +268,86 @@ void App::handleSDLEvents() {
     }
 }
 
+InputFrame App::captureInputs() const {
+	InputFrame frame;
+	frame.mousePos = m_scomps.inputs.mousePos();
+	frame.ndcMousePos = m_scomps.inputs.ndcMousePos();
+	frame.posDelta = m_scomps.inputs.posDelta();
+	frame.ndcMouseSamples = m_scomps.inputs.ndcMouseSamples();
+	frame.wheelDelta = m_scomps.inputs.wheelDelta();
+	frame.actionState = m_scomps.inputs.m_actionState;
+	frame.brushType = m_scomps.brush.type();
+	frame.brushUsage = m_scomps.brush.usage();
+	frame.brushStarted = m_scomps.brush.started();
+	frame.brushSize = m_scomps.brush.size();
+	frame.brushFlat = m_scomps.brush.isFlat();
+	frame.brushSameMaterial = m_scomps.brush.isSameMaterial();
+	frame.fillLimit = m_scomps.brush.fillLimit();
+	frame.selectionMode = m_scomps.brush.selectionMode();
+	frame.stampTurns = m_scomps.brush.stampTurns();
+	frame.stampMirrored = m_scomps.brush.isStampMirrored();
+	frame.symmetry = m_scomps.brush.symmetry();
+	frame.symmetryCenter = m_scomps.brush.symmetryCenter();
+	frame.filter = m_scomps.brush.filter();
+	frame.filterRadius = m_scomps.brush.filterRadius();
+	frame.material = m_scomps.materials.selectedIndex();
+	frame.viewportSize = m_scomps.viewport.size();
+	frame.viewportPosTopLeft = m_scomps.viewport.posTopLeft();
+	frame.viewportHovered = m_scomps.viewport.isHovered();
+	frame.commands = m_scomps.guiCommands.commands();
+	return frame;
+}
+
+void App::applyInputs(const InputFrame& frame) {
+	m_scomps.inputs.m_mousePos = frame.mousePos;
+	m_scomps.inputs.m_ndcMousePos = frame.ndcMousePos;
+	m_scomps.inputs.m_posDelta = frame.posDelta;
+	m_scomps.inputs.m_ndcMouseSamples = frame.ndcMouseSamples;
+	m_scomps.inputs.m_wheelDelta = frame.wheelDelta;
+	m_scomps.inputs.m_actionState = frame.actionState;
+	m_scomps.brush.m_type = frame.brushType;
+	m_scomps.brush.m_usage = frame.brushUsage;
+	m_scomps.brush.m_started = frame.brushStarted;
+	m_scomps.brush.m_size = frame.brushSize;
+	m_scomps.brush.m_isFlat = frame.brushFlat;
+	m_scomps.brush.m_isSameMaterial = frame.brushSameMaterial;
+	m_scomps.brush.m_fillLimit = frame.fillLimit;
+	m_scomps.brush.m_selectionMode = frame.selectionMode;
+	m_scomps.brush.m_stampTurns = frame.stampTurns;
+	m_scomps.brush.m_isStampMirrored = frame.stampMirrored;
+	m_scomps.brush.m_symmetry = frame.symmetry;
+	m_scomps.brush.m_symmetryCenter = frame.symmetryCenter;
+	m_scomps.brush.m_filter = frame.filter;
+	m_scomps.brush.m_filterRadius = frame.filterRadius;
+	if (frame.material < m_scomps.materials.size())
+		m_scomps.materials.m_selectedIndex = frame.material;
+	m_scomps.viewport.m_posTopLeft = frame.viewportPosTopLeft;
+	m_scomps.viewport.m_isHovered = frame.viewportHovered;
+	m_scomps.guiCommands.m_commands = frame.commands;
+
+	// Selection reads the render targets, so they must have the recorded size
+	ViewportGui::resizeViewport(m_ctx, m_scomps, frame.viewportSize);
+}
+
+void App::endReplay() {
+	exit();
+	if (m_frameTimes.empty())
+		return;
+
+	const std::string timingsPath = m_options.timingsPath.empty() ? m_options.replayPath + ".csv" : m_options.timingsPath;
+	std::ofstream file(timingsPath);
+	file << "frame,milliseconds\n";
+	for (size_t i = 0; i < m_frameTimes.size(); i++) {
+		file << i << "," << m_frameTimes.at(i) << "\n";
+	}
+
+	std::vector<double> sorted = m_frameTimes;
+	std::sort(sorted.begin(), sorted.end());
+	const double average = std::accumulate(sorted.begin(), sorted.end(), 0.0) / sorted.size();
+	spdlog::info("[App] Replayed {} frames, average {:.2f} ms, 95th percentile {:.2f} ms, max {:.2f} ms. Timings saved to {}",
+		sorted.size(), average, sorted.at(sorted.size() * 95 / 100), sorted.back(), timingsPath);
+}
+
 void App::initSDL() {
 	if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_TIMER) != 0) {
 		spdlog::critical("[SDL2] Unable to initialize SDL: {}", SDL_GetError());
@@ -233,7 +378,7 @@ void App::initSDL() {
 		"Cube Beast Editor",
 		SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED,
 		width, height,
-		SDL_WINDOW_OPENGL | SDL_WINDOW_ALLOW_HIGHDPI | SDL_WINDOW_RESIZABLE
+		SDL_WINDOW_OPENGL | SDL_WINDOW_ALLOW_HIGHDPI | SDL_WINDOW_RESIZABLE | (m_options.headless ? SDL_WINDOW_HIDDEN : 0)
     );
 	if (m_window == nullptr) {
         spdlog::critical("[SDL2] Window is null: {}", SDL_GetError());
@@ -247,7 +392,7 @@ void App::initSDL() {
     }
 
 	SDL_GL_MakeCurrent(m_window, m_glContext);
-	SDL_GL_SetSwapInterval(1);
+	SDL_GL_SetSwapInterval(m_options.replayPath.empty() ? 1 : 0); // Replays run as fast as possible
 
 	// Set icon
 	{
@@ -297,6 +442,9 @@ void App::initSDL() {
 		debug_break();
 	}
 #endif
+
+	if (!GpuProfiler::get().init(SDL_GL_GetProcAddress))
+		spdlog::info("[Profiling] GL_EXT_disjoint_timer_query not supported, render passes are only timed on the cpu");
 }
 
 ImFont* App::initImgui() const {
@@ -1,18 +1,31 @@
 #pragma once
 
 #include <SDL2/SDL.h>
+#include <string>
+#include <vector>
 
 #include "context.h"
 #include "scomponents/singleton-components.h"
 #include "gui/i-gui.h"
 #include "systems/i-system.h"
+#include "recording/input-recording.h"
+
+/**
+ * @brief Set from the command line
+ */
+struct AppOptions {
+    std::string recordPath; // Write the inputs of each frame to this file
+    std::string replayPath; // Use the inputs of a recording instead of the user ones, then exit
+    std::string timingsPath; // Per-frame timings of the replay as csv. Next to the recording by default.
+    bool headless = false; // Hide the window during the replay
+};
 
 /**
  * @brief Base root of the app
  */
 class App {
 public:
-    App();
+    App(const AppOptions& options = AppOptions());
     ~App();
 
     void update();
@@ -24,15 +37,23 @@ private:
     void initSDL();
     ImFont* initImgui() const;
     void handleSDLEvents();
+    InputFrame captureInputs() const;
+    void applyInputs(const InputFrame& frame);
+    void endReplay();
 
 private:
     SDL_Window* m_window;
     SDL_GLContext m_glContext;
     static bool m_instanciated;
     bool m_running;
+    AppOptions m_options;
     
     Context m_ctx;
     SingletonComponents m_scomps;
     std::vector<IGui*> m_guis;
     std::vector<ISystem*> m_systems;
+
+    InputRecorder m_recorder;
+    InputReplay m_replay;
+    std::vector<double> m_frameTimes; // In milliseconds, measured during the replay
 };
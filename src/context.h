@@ -6,15 +6,19 @@
 #include "graphics/debug-draw.h"
 #include "scomponents/singleton-components.h"
 #include "history/history-handler.h"
+#include "scene/voxel-editor.h"
+#include "memory/frame-arena.h"
 
 /**
  * @brief Global object used accross systems
  */
 struct Context {
-	Context(SingletonComponents& scomps) : ddraw(rcommand, scomps), history(scomps) {}
+	Context(SingletonComponents& scomps) : ddraw(rcommand, scomps), history(scomps), editor(registry, scomps.voxelGrid) {}
 
 	met::registry registry;
 	RenderCommand rcommand;
 	DebugDraw ddraw;
 	HistoryHandler history;
+	VoxelEditor editor;
+	FrameArena frameArena; // Reset at the end of each frame
 };
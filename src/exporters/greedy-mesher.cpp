@@ -0,0 +1,223 @@
+#include "greedy-mesher.h"
+
+#include <profiling/instrumentor.h>
+#include <algorithm>
+#include <array>
+#include <future>
+#include <thread>
+#include <unordered_map>
+
+#include "graphics/primitive-data.h"
+
+namespace {
+    using ChunkMesh = std::vector<SubMesh>; // Indexed by material
+
+    struct ChunkNeighbours {
+        const VoxelChunk* chunk;
+        std::array<const VoxelChunk*, 6> faces; // Chunks touching each face, in cubeData order
+    };
+
+    /**
+     * @brief Last vertex emitted at each corner of a chunk for each face direction, reused by the chunks meshed on a thread
+     */
+    struct VertexCache {
+        static constexpr int CORNERS = VoxelChunk::SIZE + 1;
+
+        struct Entry {
+            std::uint32_t chunk = 0;
+            std::uint32_t material = 0;
+            std::uint32_t index = 0;
+        };
+
+        VertexCache() : entries(CORNERS * CORNERS * CORNERS * 6) {}
+
+        Entry& at(const glm::ivec3& corner, unsigned int face) {
+            return entries[((corner.z * CORNERS + corner.y) * CORNERS + corner.x) * 6 + face];
+        }
+
+        std::vector<Entry> entries;
+        std::uint32_t chunk = 0; // Entries of other chunks are outdated
+    };
+
+    /**
+     * @brief Mesh the faces of a chunk which are not hidden by another voxel
+     */
+    void meshChunk(const ChunkNeighbours& input, VertexCache& cache, ChunkMesh& mesh) {
+        const VoxelChunk& chunk = *input.chunk;
+        const glm::vec3 chunkOrigin = glm::vec3(chunk.position * VoxelChunk::SIZE);
+        cache.chunk++;
+
+        std::array<unsigned short, VoxelChunk::SIZE * VoxelChunk::SIZE> mask;
+
+        for (unsigned int face = 0; face < 6; face++) {
+            const glm::ivec3 normal = glm::ivec3(cubeData::normals[face * 4]);
+            const int d = normal.x != 0 ? 0 : (normal.y != 0 ? 1 : 2);
+            const int u = (d + 1) % 3;
+            const int v = (d + 2) % 3;
+
+            for (int layer = 0; layer < VoxelChunk::SIZE; layer++) {
+                // Material + 1 of the visible faces of this layer, 0 if there is none
+                glm::ivec3 cell;
+                cell[d] = layer;
+                for (int j = 0; j < VoxelChunk::SIZE; j++) {
+                    for (int i = 0; i < VoxelChunk::SIZE; i++) {
+                        cell[u] = i;
+                        cell[v] = j;
+                        const unsigned int index = VoxelChunk::cellIndex(cell);
+                        unsigned short& value = mask[j * VoxelChunk::SIZE + i];
+                        value = 0;
+                        if (!chunk.has(index))
+                            continue;
+
+                        const glm::ivec3 next = cell + normal;
+                        const bool isInside = next[d] >= 0 && next[d] < VoxelChunk::SIZE;
+                        const VoxelChunk* nextChunk = isInside ? &chunk : input.faces[face];
+                        if (nextChunk != nullptr && nextChunk->has(VoxelChunk::cellIndex(next)))
+                            continue;
+
+                        value = chunk.materials[index] + 1;
+                    }
+                }
+
+                // Grow each quad along u then along v while the material stays the same
+                for (int j = 0; j < VoxelChunk::SIZE; j++) {
+                    for (int i = 0; i < VoxelChunk::SIZE;) {
+                        const unsigned short value = mask[j * VoxelChunk::SIZE + i];
+                        if (value == 0) {
+                            i++;
+                            continue;
+                        }
+
+                        int width = 1;
+                        while (i + width < VoxelChunk::SIZE && mask[j * VoxelChunk::SIZE + i + width] == value)
+                            width++;
+
+                        int height = 1;
+                        for (; j + height < VoxelChunk::SIZE; height++) {
+                            const auto row = mask.begin() + (j + height) * VoxelChunk::SIZE + i;
+                            if (std::any_of(row, row + width, [value](unsigned short other) { return other != value; }))
+                                break;
+                        }
+
+                        for (int h = 0; h < height; h++) {
+                            std::fill_n(mask.begin() + (j + h) * VoxelChunk::SIZE + i, width, 0);
+                        }
+
+                        // Emit the quad by scaling the face of a unit cube
+                        const unsigned int material = value - 1;
+                        if (mesh.size() <= material)
+                            mesh.resize(material + 1);
+                        SubMesh& subMesh = mesh.at(material);
+                        subMesh.material = material;
+
+                        glm::ivec3 origin;
+                        origin[d] = layer;
+                        origin[u] = i;
+                        origin[v] = j;
+                        glm::ivec3 scale;
+                        scale[d] = 1;
+                        scale[u] = width;
+                        scale[v] = height;
+
+                        // Vertices are shared by quads of the same face direction and material
+                        std::array<std::uint32_t, 4> corners;
+                        for (unsigned int k = 0; k < 4; k++) {
+                            const glm::ivec3 corner = origin + glm::ivec3(cubeData::positions[face * 4 + k]) * scale;
+                            VertexCache::Entry& cached = cache.at(corner, face);
+                            if (cached.chunk != cache.chunk || cached.material != material) {
+                                cached = { cache.chunk, material, static_cast<std::uint32_t>(subMesh.positions.size()) };
+                                subMesh.positions.push_back(chunkOrigin + glm::vec3(corner));
+                                subMesh.normals.push_back(cubeData::normals[face * 4]);
+                            }
+                            corners[k] = cached.index;
+                        }
+
+                        // The inverted indices of the cube are counter-clockwise when seen from outside
+                        for (unsigned int k = 0; k < 6; k++) {
+                            subMesh.indices.push_back(corners[cubeData::invertIndices[face * 6 + k] - face * 4]);
+                        }
+
+                        i += width;
+                    }
+                }
+            }
+        }
+    }
+}
+
+GreedyMesher::GreedyMesher(unsigned int threadCount) : m_threadCount(threadCount) {
+    if (m_threadCount == 0)
+        m_threadCount = std::max(1u, std::thread::hardware_concurrency());
+}
+
+GreedyMesher::~GreedyMesher() {}
+
+VoxelMesh GreedyMesher::build(const VoxelGrid::Snapshot& chunks) const {
+    PROFILE_SCOPE("GreedyMesher build");
+    std::unordered_map<std::uint64_t, const VoxelChunk*> chunkByKey;
+    chunkByKey.reserve(chunks.size());
+    for (const auto& chunk : chunks) {
+        chunkByKey.emplace(VoxelGrid::chunkKey(chunk->position), chunk.get());
+    }
+
+    // Sorted so the output does not depend on the hash map order
+    std::vector<ChunkNeighbours> inputs;
+    inputs.reserve(chunks.size());
+    for (const auto& chunk : chunks) {
+        ChunkNeighbours input;
+        input.chunk = chunk.get();
+        for (unsigned int face = 0; face < 6; face++) {
+            const auto it = chunkByKey.find(VoxelGrid::chunkKey(chunk->position + glm::ivec3(cubeData::normals[face * 4])));
+            input.faces[face] = it != chunkByKey.end() ? it->second : nullptr;
+        }
+        inputs.push_back(input);
+    }
+    std::sort(inputs.begin(), inputs.end(), [](const ChunkNeighbours& a, const ChunkNeighbours& b) {
+        const glm::ivec3& pa = a.chunk->position;
+        const glm::ivec3& pb = b.chunk->position;
+        return pa.z != pb.z ? pa.z < pb.z : (pa.y != pb.y ? pa.y < pb.y : pa.x < pb.x);
+    });
+
+    // Chunks are interleaved between the threads to balance dense and empty areas
+    std::vector<ChunkMesh> chunkMeshes(inputs.size());
+    const unsigned int threadCount = std::min<unsigned int>(m_threadCount, static_cast<unsigned int>(inputs.size()));
+    std::vector<std::future<void>> jobs;
+    for (unsigned int t = 0; t < threadCount; t++) {
+        jobs.push_back(std::async(std::launch::async, [&inputs, &chunkMeshes, t, threadCount]() {
+            PROFILE_SCOPE("GreedyMesher mesh chunks");
+            VertexCache cache;
+            for (size_t i = t; i < inputs.size(); i += threadCount) {
+                meshChunk(inputs[i], cache, chunkMeshes[i]);
+            }
+        }));
+    }
+    for (auto& job : jobs) {
+        job.get();
+    }
+
+    // Concatenate the chunks into one sub mesh per material
+    VoxelMesh mesh;
+    for (const ChunkMesh& chunkMesh : chunkMeshes) {
+        if (mesh.subMeshes.size() < chunkMesh.size())
+            mesh.subMeshes.resize(chunkMesh.size());
+
+        for (const SubMesh& chunkSubMesh : chunkMesh) {
+            if (chunkSubMesh.indices.empty())
+                continue;
+
+            SubMesh& subMesh = mesh.subMeshes.at(chunkSubMesh.material);
+            subMesh.material = chunkSubMesh.material;
+            const std::uint32_t offset = static_cast<std::uint32_t>(subMesh.positions.size());
+            subMesh.positions.insert(subMesh.positions.end(), chunkSubMesh.positions.begin(), chunkSubMesh.positions.end());
+            subMesh.normals.insert(subMesh.normals.end(), chunkSubMesh.normals.begin(), chunkSubMesh.normals.end());
+            for (std::uint32_t index : chunkSubMesh.indices) {
+                subMesh.indices.push_back(index + offset);
+            }
+        }
+    }
+
+    mesh.subMeshes.erase(std::remove_if(mesh.subMeshes.begin(), mesh.subMeshes.end(), [](const SubMesh& subMesh) {
+        return subMesh.indices.empty();
+    }), mesh.subMeshes.end());
+    return mesh;
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <glm/glm.hpp>
+
+#include "scomponents/scene/voxel-grid.h"
+
+/**
+ * @brief Triangles of the voxels sharing a material
+ */
+struct SubMesh {
+    unsigned int material = 0;
+    std::vector<glm::vec3> positions;
+    std::vector<glm::vec3> normals;
+    std::vector<std::uint32_t> indices; // Counter-clockwise when seen from outside
+};
+
+/**
+ * @brief Surface of the voxel grid, with one sub mesh per material used
+ */
+struct VoxelMesh {
+    std::vector<SubMesh> subMeshes;
+};
+
+/**
+ * @brief Build the surface of the voxels, merging coplanar faces of the same material into larger quads
+ * @note Each chunk is meshed on its own so the work is split between threads.
+ *       Vertices are shared inside a chunk, not between chunks.
+ */
+class GreedyMesher {
+public:
+    explicit GreedyMesher(unsigned int threadCount = 0);
+    ~GreedyMesher();
+
+    /**
+     * @brief Does not use the context so it can run on another thread
+     * 
+     * @param chunks - Snapshot of the voxel grid
+     */
+    VoxelMesh build(const VoxelGrid::Snapshot& chunks) const;
+
+private:
+    unsigned int m_threadCount;
+};
@@ -0,0 +1,282 @@
+#include "mesh-exporter.h"
+
+#include <spdlog/spdlog.h>
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+
+#include "graphics/primitive-data.h"
+
+namespace {
+    glm::vec3 materialColor(const std::vector<cb::perMaterialChange>& palette, unsigned int material) {
+        return material < palette.size() ? palette.at(material).albedo : glm::vec3(1.0f);
+    }
+
+    /**
+     * @brief Buffer text lines and write them by large blocks
+     */
+    class TextStream {
+    public:
+        explicit TextStream(std::ofstream& file) : m_file(file) { m_buffer.reserve(BLOCK_SIZE + 256); }
+        ~TextStream() { flush(); }
+
+        template<typename... Args>
+        void print(const char* format, Args... args) {
+            char line[256];
+            const int length = std::snprintf(line, sizeof(line), format, args...);
+            m_buffer.append(line, std::min<size_t>(length, sizeof(line) - 1));
+            if (m_buffer.size() >= BLOCK_SIZE)
+                flush();
+        }
+
+        void flush() {
+            m_file.write(m_buffer.data(), m_buffer.size());
+            m_buffer.clear();
+        }
+
+    private:
+        static constexpr size_t BLOCK_SIZE = 1 << 20;
+        std::ofstream& m_file;
+        std::string m_buffer;
+    };
+
+    /**
+     * @brief 1-based index of the normal in the list written at the start of .obj files
+     */
+    unsigned int normalIndex(const glm::vec3& normal) {
+        for (unsigned int face = 0; face < 6; face++) {
+            if (cubeData::normals[face * 4] == normal)
+                return face + 1;
+        }
+        return 1;
+    }
+
+    template<typename T>
+    void writeBinary(std::ofstream& file, const std::vector<T>& data) {
+        file.write(reinterpret_cast<const char*>(data.data()), data.size() * sizeof(T));
+    }
+}
+
+MeshExporter::MeshExporter(unsigned int threadCount) : m_mesher(threadCount) {}
+
+MeshExporter::~MeshExporter() {}
+
+bool MeshExporter::writeFile(const char* filePath, const VoxelGrid::Snapshot& chunks, const std::vector<cb::perMaterialChange>& palette) {
+    if (!isSupported(filePath)) {
+        spdlog::error("[Mesh] Unsupported export format for {}", filePath);
+        return false;
+    }
+
+    // An empty glTF mesh or buffer is invalid, and the other formats would only have a header
+    const VoxelMesh mesh = m_mesher.build(chunks);
+    if (mesh.subMeshes.empty()) {
+        spdlog::error("[Mesh] The scene is empty, nothing to export to {}", filePath);
+        return false;
+    }
+
+    const std::string extension = std::filesystem::path(filePath).extension().string();
+    bool success = false;
+    if (extension == ".obj")
+        success = writeObj(filePath, mesh, palette);
+    else if (extension == ".ply")
+        success = writePly(filePath, mesh, palette);
+    else
+        success = writeGltf(filePath, mesh, palette);
+
+    if (!success)
+        spdlog::error("[Mesh] Cannot write {}", filePath);
+    return success;
+}
+
+bool MeshExporter::isSupported(const std::string& filePath) {
+    const std::string extension = std::filesystem::path(filePath).extension().string();
+    return extension == ".obj" || extension == ".ply" || extension == ".gltf";
+}
+
+bool MeshExporter::writeObj(const std::string& filePath, const VoxelMesh& mesh, const std::vector<cb::perMaterialChange>& palette) {
+    const std::filesystem::path mtlPath = std::filesystem::path(filePath).replace_extension(".mtl");
+    {
+        std::ofstream mtlFile(mtlPath);
+        if (!mtlFile)
+            return false;
+
+        TextStream mtl(mtlFile);
+        for (const SubMesh& subMesh : mesh.subMeshes) {
+            const glm::vec3 color = materialColor(palette, subMesh.material);
+            mtl.print("newmtl material_%u\nKd %.4f %.4f %.4f\n\n", subMesh.material, color.r, color.g, color.b);
+        }
+    }
+
+    std::ofstream file(filePath);
+    if (!file)
+        return false;
+
+    TextStream obj(file);
+    obj.print("# cube-beast-editor\nmtllib %s\n", mtlPath.filename().string().c_str());
+
+    // Each vertex has the normal of its face, so normals are only written once
+    for (unsigned int face = 0; face < 6; face++) {
+        const glm::vec3& normal = cubeData::normals[face * 4];
+        obj.print("vn %g %g %g\n", normal.x, normal.y, normal.z);
+    }
+
+    std::uint32_t vertexOffset = 1;
+    for (const SubMesh& subMesh : mesh.subMeshes) {
+        // Corners of voxels are always on integer coordinates
+        for (const glm::vec3& position : subMesh.positions) {
+            obj.print("v %d %d %d\n", static_cast<int>(position.x), static_cast<int>(position.y), static_cast<int>(position.z));
+        }
+
+        obj.print("usemtl material_%u\n", subMesh.material);
+        for (size_t i = 0; i < subMesh.indices.size(); i += 3) {
+            const unsigned int n = normalIndex(subMesh.normals[subMesh.indices[i]]);
+            obj.print("f %u//%u %u//%u %u//%u\n",
+                subMesh.indices[i] + vertexOffset, n,
+                subMesh.indices[i + 1] + vertexOffset, n,
+                subMesh.indices[i + 2] + vertexOffset, n
+            );
+        }
+        vertexOffset += static_cast<std::uint32_t>(subMesh.positions.size());
+    }
+
+    obj.flush();
+    return file.good();
+}
+
+bool MeshExporter::writePly(const std::string& filePath, const VoxelMesh& mesh, const std::vector<cb::perMaterialChange>& palette) {
+    std::ofstream file(filePath, std::ios::binary);
+    if (!file)
+        return false;
+
+    size_t vertexCount = 0;
+    size_t faceCount = 0;
+    for (const SubMesh& subMesh : mesh.subMeshes) {
+        vertexCount += subMesh.positions.size();
+        faceCount += subMesh.indices.size() / 3;
+    }
+
+    // PLY has no sub meshes, so the material is stored as a vertex color
+    file << "ply\n"
+         << "format binary_little_endian 1.0\n"
+         << "comment cube-beast-editor\n"
+         << "element vertex " << vertexCount << "\n"
+         << "property float x\nproperty float y\nproperty float z\n"
+         << "property float nx\nproperty float ny\nproperty float nz\n"
+         << "property uchar red\nproperty uchar green\nproperty uchar blue\n"
+         << "element face " << faceCount << "\n"
+         << "property list uchar uint vertex_indices\n"
+         << "end_header\n";
+
+#pragma pack(push, 1)
+    struct PlyVertex { glm::vec3 position; glm::vec3 normal; unsigned char color[3]; };
+    struct PlyFace { unsigned char count; std::uint32_t indices[3]; };
+#pragma pack(pop)
+
+    std::vector<PlyVertex> vertices;
+    for (const SubMesh& subMesh : mesh.subMeshes) {
+        const glm::vec3 color = glm::clamp(materialColor(palette, subMesh.material), 0.0f, 1.0f) * 255.0f + 0.5f;
+        vertices.resize(subMesh.positions.size());
+        for (size_t i = 0; i < vertices.size(); i++) {
+            vertices[i] = { subMesh.positions[i], subMesh.normals[i], {
+                static_cast<unsigned char>(color.r), static_cast<unsigned char>(color.g), static_cast<unsigned char>(color.b)
+            } };
+        }
+        writeBinary(file, vertices);
+    }
+
+    std::vector<PlyFace> faces;
+    std::uint32_t vertexOffset = 0;
+    for (const SubMesh& subMesh : mesh.subMeshes) {
+        faces.resize(subMesh.indices.size() / 3);
+        for (size_t i = 0; i < faces.size(); i++) {
+            faces[i] = { 3, {
+                subMesh.indices[i * 3] + vertexOffset, subMesh.indices[i * 3 + 1] + vertexOffset, subMesh.indices[i * 3 + 2] + vertexOffset
+            } };
+        }
+        writeBinary(file, faces);
+        vertexOffset += static_cast<std::uint32_t>(subMesh.positions.size());
+    }
+
+    return file.good();
+}
+
+bool MeshExporter::writeGltf(const std::string& filePath, const VoxelMesh& mesh, const std::vector<cb::perMaterialChange>& palette) {
+    const std::filesystem::path binPath = std::filesystem::path(filePath).replace_extension(".bin");
+    std::ofstream binFile(binPath, std::ios::binary);
+    if (!binFile)
+        return false;
+
+    nlohmann::json json;
+    json["asset"] = { { "version", "2.0" }, { "generator", "cube-beast-editor" } };
+    json["scene"] = 0;
+    json["scenes"] = { { { "nodes", { 0 } } } };
+    json["nodes"] = { { { "mesh", 0 } } };
+    if (mesh.subMeshes.empty())
+        json["nodes"] = { nlohmann::json::object() };
+    json["bufferViews"] = nlohmann::json::array();
+    json["accessors"] = nlohmann::json::array();
+    json["materials"] = nlohmann::json::array();
+
+    const unsigned int ARRAY_BUFFER = 34962;
+    const unsigned int ELEMENT_ARRAY_BUFFER = 34963;
+    const unsigned int FLOAT = 5126;
+    const unsigned int UNSIGNED_INT = 5125;
+
+    // Each sub mesh is a primitive with its own vertices, stored one after the other in the .bin
+    size_t byteOffset = 0;
+    nlohmann::json primitives = nlohmann::json::array();
+    for (const SubMesh& subMesh : mesh.subMeshes) {
+        const size_t vertexBytes = subMesh.positions.size() * sizeof(glm::vec3);
+        const size_t indexBytes = subMesh.indices.size() * sizeof(std::uint32_t);
+        const size_t firstView = json["bufferViews"].size();
+
+        json["bufferViews"].push_back({ { "buffer", 0 }, { "byteOffset", byteOffset }, { "byteLength", vertexBytes }, { "target", ARRAY_BUFFER } });
+        json["bufferViews"].push_back({ { "buffer", 0 }, { "byteOffset", byteOffset + vertexBytes }, { "byteLength", vertexBytes }, { "target", ARRAY_BUFFER } });
+        json["bufferViews"].push_back({ { "buffer", 0 }, { "byteOffset", byteOffset + 2 * vertexBytes }, { "byteLength", indexBytes }, { "target", ELEMENT_ARRAY_BUFFER } });
+        writeBinary(binFile, subMesh.positions);
+        writeBinary(binFile, subMesh.normals);
+        writeBinary(binFile, subMesh.indices);
+        byteOffset += 2 * vertexBytes + indexBytes;
+
+        glm::vec3 min = subMesh.positions.front();
+        glm::vec3 max = subMesh.positions.front();
+        for (const glm::vec3& position : subMesh.positions) {
+            min = glm::min(min, position);
+            max = glm::max(max, position);
+        }
+
+        const size_t firstAccessor = json["accessors"].size();
+        json["accessors"].push_back({
+            { "bufferView", firstView }, { "componentType", FLOAT }, { "count", subMesh.positions.size() }, { "type", "VEC3" },
+            { "min", { min.x, min.y, min.z } }, { "max", { max.x, max.y, max.z } }
+        });
+        json["accessors"].push_back({ { "bufferView", firstView + 1 }, { "componentType", FLOAT }, { "count", subMesh.normals.size() }, { "type", "VEC3" } });
+        json["accessors"].push_back({ { "bufferView", firstView + 2 }, { "componentType", UNSIGNED_INT }, { "count", subMesh.indices.size() }, { "type", "SCALAR" } });
+
+        const glm::vec3 color = materialColor(palette, subMesh.material);
+        json["materials"].push_back({
+            { "name", "material_" + std::to_string(subMesh.material) },
+            { "pbrMetallicRoughness", { { "baseColorFactor", { color.r, color.g, color.b, 1.0f } }, { "metallicFactor", 0.0f } } }
+        });
+
+        primitives.push_back({
+            { "attributes", { { "POSITION", firstAccessor }, { "NORMAL", firstAccessor + 1 } } },
+            { "indices", firstAccessor + 2 },
+            { "material", json["materials"].size() - 1 }
+        });
+    }
+
+    if (!primitives.empty())
+        json["meshes"] = { { { "primitives", primitives } } };
+    json["buffers"] = { { { "uri", binPath.filename().string() }, { "byteLength", byteOffset } } };
+    if (!binFile.good())
+        return false;
+
+    std::ofstream file(filePath);
+    if (!file)
+        return false;
+    file << json.dump(4);
+    return file.good();
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <vector>
+#include <string>
+
+#include "greedy-mesher.h"
+#include "graphics/constant-buffer.h"
+
+/**
+ * @brief Write the surface of the voxels as a triangle mesh, to be used in other softwares
+ * @note The format is chosen from the extension of the file : .obj (with a .mtl), .ply (binary) or .gltf (with a .bin).
+ */
+class MeshExporter {
+public:
+    explicit MeshExporter(unsigned int threadCount = 0);
+    ~MeshExporter();
+
+    /**
+     * @brief Does not use the context so it can run on another thread
+     * 
+     * @param filePath 
+     * @param chunks - Snapshot of the voxel grid
+     * @param palette - Materials used by the voxels
+     * @return false if the scene is empty, if the format is not supported or if the file cannot be written
+     */
+    bool writeFile(const char* filePath, const VoxelGrid::Snapshot& chunks, const std::vector<cb::perMaterialChange>& palette);
+
+    static bool isSupported(const std::string& filePath);
+
+private:
+    bool writeObj(const std::string& filePath, const VoxelMesh& mesh, const std::vector<cb::perMaterialChange>& palette);
+    bool writePly(const std::string& filePath, const VoxelMesh& mesh, const std::vector<cb::perMaterialChange>& palette);
+    bool writeGltf(const std::string& filePath, const VoxelMesh& mesh, const std::vector<cb::perMaterialChange>& palette);
+
+private:
+    GreedyMesher m_mesher;
+};
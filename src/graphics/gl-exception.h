@@ -9,6 +9,8 @@
 	#include <glad/gles2.h>
 #endif
 
+#include "gpu-profiler.h"
+
 /**
  * @brief Assertion and logger handling for opengl functions
  */
@@ -20,12 +22,12 @@
 #endif
 
 /**
- * @brief Send event to group openGl calls
+ * @brief Send event to group openGl calls, and time them on the cpu and the gpu
  */
 #if defined(NDEBUG) || defined(__EMSCRIPTEN__)
-    #define OGL_SCOPE(x)
+    #define OGL_SCOPE(name) PROFILE_SCOPE(name); GpuScope CONCAT(gpuScope, __LINE__)(name)
 #else
-    #define OGL_SCOPE(name) PROFILE_SCOPE(name); glexp::DebugGroup CONCAT(dgroup, __LINE__)(name)
+    #define OGL_SCOPE(name) PROFILE_SCOPE(name); glexp::DebugGroup CONCAT(dgroup, __LINE__)(name); GpuScope CONCAT(gpuScope, __LINE__)(name)
 #endif
 
 namespace glexp {
@@ -0,0 +1,157 @@
+#include "gpu-profiler.h"
+
+#include <algorithm>
+#include <cstring>
+
+#ifndef __EMSCRIPTEN__
+namespace {
+    // GL_EXT_disjoint_timer_query is not part of the generated glad loader
+    constexpr GLenum GL_TIME_ELAPSED_EXT = 0x88BF;
+    constexpr GLenum GL_GPU_DISJOINT_EXT = 0x8FBB;
+    constexpr GLenum GL_QUERY_RESULT_EXT = 0x8866;
+    constexpr GLenum GL_QUERY_RESULT_AVAILABLE_EXT = 0x8867;
+
+    typedef void (GLAD_API_PTR *PFNGLGENQUERIESEXTPROC)(GLsizei n, GLuint* ids);
+    typedef void (GLAD_API_PTR *PFNGLBEGINQUERYEXTPROC)(GLenum target, GLuint id);
+    typedef void (GLAD_API_PTR *PFNGLENDQUERYEXTPROC)(GLenum target);
+    typedef void (GLAD_API_PTR *PFNGLGETQUERYOBJECTUIVEXTPROC)(GLuint id, GLenum pname, GLuint* params);
+    typedef void (GLAD_API_PTR *PFNGLGETQUERYOBJECTUI64VEXTPROC)(GLuint id, GLenum pname, GLuint64* params);
+
+    PFNGLGENQUERIESEXTPROC genQueries = nullptr;
+    PFNGLBEGINQUERYEXTPROC beginQuery = nullptr;
+    PFNGLENDQUERYEXTPROC endQuery = nullptr;
+    PFNGLGETQUERYOBJECTUIVEXTPROC getQueryObjectuiv = nullptr;
+    PFNGLGETQUERYOBJECTUI64VEXTPROC getQueryObjectui64v = nullptr;
+
+    bool hasExtension(const char* name) {
+        GLint count = 0;
+        glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+        for (GLint i = 0; i < count; i++) {
+            const char* extension = reinterpret_cast<const char*>(glGetStringi(GL_EXTENSIONS, i));
+            if (extension != nullptr && std::strcmp(extension, name) == 0)
+                return true;
+        }
+        return false;
+    }
+}
+#endif
+
+GpuProfiler::GpuProfiler() 
+    : m_isSupported(false), m_isEnabled(true), m_isQueryRunning(false), m_oldestFrame(0), m_frameCount(1), m_gpuCursor(0)
+{}
+
+bool GpuProfiler::init(LoadFunction load) {
+#ifndef __EMSCRIPTEN__
+    if (!hasExtension("GL_EXT_disjoint_timer_query"))
+        return false;
+
+    genQueries = reinterpret_cast<PFNGLGENQUERIESEXTPROC>(load("glGenQueriesEXT"));
+    beginQuery = reinterpret_cast<PFNGLBEGINQUERYEXTPROC>(load("glBeginQueryEXT"));
+    endQuery = reinterpret_cast<PFNGLENDQUERYEXTPROC>(load("glEndQueryEXT"));
+    getQueryObjectuiv = reinterpret_cast<PFNGLGETQUERYOBJECTUIVEXTPROC>(load("glGetQueryObjectuivEXT"));
+    getQueryObjectui64v = reinterpret_cast<PFNGLGETQUERYOBJECTUI64VEXTPROC>(load("glGetQueryObjectui64vEXT"));
+    m_isSupported = genQueries && beginQuery && endQuery && getQueryObjectuiv && getQueryObjectui64v;
+#endif
+    return m_isSupported;
+}
+
+void GpuProfiler::markFrame() {
+#ifndef __EMSCRIPTEN__
+    if (!m_isSupported)
+        return;
+
+    // The results of the queries in flight are meaningless if the gpu clock changed, or after a reset
+    GLint isDisjoint = 0;
+    if (m_frameCount > 1 || !currentFrame().empty())
+        glGetIntegerv(GL_GPU_DISJOINT_EXT, &isDisjoint);
+
+    while (m_frameCount > 0) {
+        PendingFrame& frame = m_frames[m_oldestFrame];
+        if (!frame.empty() && !isDisjoint) {
+            // Queries complete in order, so the frame is ready once its last one is
+            GLuint isAvailable = 0;
+            getQueryObjectuiv(frame.back().query, GL_QUERY_RESULT_AVAILABLE_EXT, &isAvailable);
+            if (!isAvailable && m_frameCount < MAX_FRAMES_IN_FLIGHT)
+                break;
+            if (isAvailable)
+                resolve(frame);
+        }
+        recycle(frame);
+        m_oldestFrame = (m_oldestFrame + 1) % MAX_FRAMES_IN_FLIGHT;
+        m_frameCount--;
+    }
+    m_frameCount++;
+#endif
+}
+
+bool GpuProfiler::begin(const char* name) {
+#ifndef __EMSCRIPTEN__
+    if (m_isQueryRunning)
+        return false;
+
+    GLuint query = 0;
+    if (m_freeQueries.empty()) {
+        genQueries(1, &query);
+    } else {
+        query = m_freeQueries.back();
+        m_freeQueries.pop_back();
+    }
+
+    beginQuery(GL_TIME_ELAPSED_EXT, query);
+    currentFrame().push_back({ name, query, Instrumentor::ticks() });
+    m_isQueryRunning = true;
+    return true;
+#else
+    return false;
+#endif
+}
+
+void GpuProfiler::end() {
+#ifndef __EMSCRIPTEN__
+    endQuery(GL_TIME_ELAPSED_EXT);
+    m_isQueryRunning = false;
+#endif
+}
+
+GpuProfiler& GpuProfiler::get() {
+    static GpuProfiler instance;
+    return instance;
+}
+
+void GpuProfiler::resolve(const PendingFrame& frame) {
+#ifndef __EMSCRIPTEN__
+    const double ticksPerNanosecond = Instrumentor::get().ticksPerNanosecond();
+    const std::int64_t now = Instrumentor::ticks();
+    m_lastFrameDurations.clear();
+
+    for (const TimedScope& scope : frame) {
+        GLuint64 elapsedNs = 0;
+        getQueryObjectui64v(scope.query, GL_QUERY_RESULT_EXT, &elapsedNs);
+
+        // Some drivers return garbage for their first query. A scope cannot last longer than the time since it was submitted.
+        const std::int64_t elapsedTicks = static_cast<std::int64_t>(elapsedNs * ticksPerNanosecond);
+        if (elapsedTicks > now - scope.cpuStart)
+            continue;
+
+        // Only durations are measured. The gpu runs the commands in order, so a scope
+        // is placed once it is submitted and once the previous one ended.
+        const std::int64_t start = std::max(scope.cpuStart, m_gpuCursor);
+        m_gpuCursor = std::min(start + elapsedTicks, now);
+        Instrumentor::get().recordGpu({ scope.name, start, m_gpuCursor });
+
+        const double milliseconds = elapsedNs / 1e6;
+        const auto duration = std::find_if(m_lastFrameDurations.begin(), m_lastFrameDurations.end(), [&scope](const ScopeDuration& d) { return d.name == scope.name; });
+        if (duration != m_lastFrameDurations.end())
+            duration->milliseconds += milliseconds;
+        else
+            m_lastFrameDurations.push_back({ scope.name, milliseconds });
+    }
+#endif
+}
+
+void GpuProfiler::recycle(PendingFrame& frame) {
+    for (const TimedScope& scope : frame) {
+        m_freeQueries.push_back(scope.query);
+    }
+    frame.clear();
+}
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <array>
+#include <vector>
+#include <cstdint>
+#include <profiling/instrumentor.h>
+#ifdef __EMSCRIPTEN__
+	#include <GLES3/gl3.h>
+#else
+	#include <glad/gles2.h>
+#endif
+
+/**
+ * @brief Time the OpenGl scopes on the gpu with the GL_EXT_disjoint_timer_query extension
+ * @note Results are read a few frames later, so the cpu never waits for the gpu. They are sent to the instrumentor on a separate track.
+ */
+class GpuProfiler {
+public:
+    using LoadFunction = void* (*)(const char* name);
+
+    GpuProfiler();
+
+    /**
+     * @brief Load the extension. Must be called once the OpenGl context is current.
+     * @return false if timer queries are not supported
+     */
+    bool init(LoadFunction load);
+
+    bool isSupported() const { return m_isSupported; }
+    void setEnabled(bool enabled) { m_isEnabled = enabled; }
+    bool isEnabled() const { return m_isEnabled; }
+
+    /**
+     * @brief Scopes are only timed while the instrumentor is enabled
+     */
+    bool isActive() const { return m_isSupported && m_isEnabled && Instrumentor::get().isEnabled(); }
+
+    /**
+     * @brief Called by the main thread at the start of each frame, to read the results of the previous ones
+     */
+    void markFrame();
+
+    /**
+     * @brief Start a query, unless one is already running as queries of the same target cannot be nested
+     * @return true if the scope is timed, and end() must be called
+     */
+    bool begin(const char* name);
+    void end();
+
+    /**
+     * @brief Time spent on the gpu by each scope name, during the last frame read back
+     */
+    const std::vector<ScopeDuration>& lastFrameDurations() const { return m_lastFrameDurations; }
+
+    static GpuProfiler& get();
+
+public:
+    static constexpr std::size_t MAX_FRAMES_IN_FLIGHT = 4;
+
+private:
+    struct TimedScope {
+        const char* name;
+        GLuint query;
+        std::int64_t cpuStart; // Ticks of Instrumentor::ticks()
+    };
+
+    using PendingFrame = std::vector<TimedScope>;
+
+    void resolve(const PendingFrame& frame);
+    void recycle(PendingFrame& frame);
+    PendingFrame& currentFrame() { return m_frames[(m_oldestFrame + m_frameCount - 1) % MAX_FRAMES_IN_FLIGHT]; }
+
+private:
+    bool m_isSupported;
+    bool m_isEnabled;
+    bool m_isQueryRunning;
+    std::array<PendingFrame, MAX_FRAMES_IN_FLIGHT> m_frames; // Ring buffer, so that frames are not allocated while profiling
+    std::size_t m_oldestFrame;
+    std::size_t m_frameCount; // Including the current frame
+    std::vector<GLuint> m_freeQueries;
+    std::int64_t m_gpuCursor; // End of the last scope on the gpu track
+    std::vector<ScopeDuration> m_lastFrameDurations;
+};
+
+/**
+ * @brief Time the scope on the gpu while the profiler is active
+ */
+class GpuScope {
+public:
+    GpuScope(const char* name) : m_isTimed(GpuProfiler::get().isActive() && GpuProfiler::get().begin(name)) {}
+
+    ~GpuScope() {
+        if (m_isTimed)
+            GpuProfiler::get().end();
+    }
+
+private:
+    bool m_isTimed;
+};
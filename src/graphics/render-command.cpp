@@ -420,10 +420,10 @@ void RenderCommand::bindTexture(const Texture& tex) const {
 	GLCall(glBindTexture(GL_TEXTURE_2D, tex.id));
 }
 
-void RenderCommand::bindTextureIds(const std::vector<unsigned int>& textureIds) const {
-	for (size_t i = 0; i < textureIds.size(); i++) {
+void RenderCommand::bindTextureIds(const unsigned int* textureIds, size_t count) const {
+	for (size_t i = 0; i < count; i++) {
 		GLCall(glActiveTexture(GL_TEXTURE0 + i));
-        GLCall(glBindTexture(GL_TEXTURE_2D, textureIds.at(i)));
+        GLCall(glBindTexture(GL_TEXTURE_2D, textureIds[i]));
 	}
 }
 
@@ -456,6 +456,7 @@ void RenderCommand::updateConstantBuffer(const ConstantBuffer& cb, const void* d
 	GLCall(glBindBuffer(GL_UNIFORM_BUFFER, cb.bufferId));
 	GLCall(glBufferSubData(GL_UNIFORM_BUFFER, 0, dataByteWidth, data));
 	GLCall(glBindBuffer(GL_UNIFORM_BUFFER, 0));
+	m_stats.uploadedBytes += dataByteWidth;
 }
 
 void RenderCommand::updateAttributeBuffer(const AttributeBuffer& buffer, const void* data, unsigned int dataByteWidth) const {
@@ -463,6 +464,7 @@ void RenderCommand::updateAttributeBuffer(const AttributeBuffer& buffer, const v
 	GLCall(glBindBuffer(GL_ARRAY_BUFFER, buffer.bufferId));
 	GLCall(glBufferSubData(GL_ARRAY_BUFFER, 0, dataByteWidth, data));
 	GLCall(glBindBuffer(GL_ARRAY_BUFFER, 0));
+	m_stats.uploadedBytes += dataByteWidth;
 }
 
 void RenderCommand::updateAttributeBufferAnySize(AttributeBuffer& buffer, const void* data, unsigned int dataByteWidth) const {
@@ -519,14 +521,19 @@ unsigned char* RenderCommand::readPixelBuffer(const PixelBuffer& buffer) const {
 
 void RenderCommand::drawLines(unsigned int count) const {
 	GLCall(glDrawArrays(GL_LINES, 0, count));
+	m_stats.drawCalls++;
 }
 
 void RenderCommand::drawIndexed(unsigned int count, IndexBuffer::dataType type) const {
 	GLCall(glDrawElements(GL_TRIANGLES, count, indexBufferDataTypeToOpenGLBaseType(type), (void*) 0));
+	m_stats.drawCalls++;
+	m_stats.instances++;
 }
 
 void RenderCommand::drawIndexedInstances(unsigned int indexCount, IndexBuffer::dataType type, unsigned int drawCount) const {
 	GLCall(glDrawElementsInstanced(GL_TRIANGLES, indexCount, indexBufferDataTypeToOpenGLBaseType(type), (void*)0, drawCount));
+	m_stats.drawCalls++;
+	m_stats.instances += drawCount;
 }
 
 ///////////////////////////////////////////////////////////////////////////
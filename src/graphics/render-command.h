@@ -16,6 +16,15 @@
 #include "graphics/pipeline-input-description.h"
 #include "graphics/pipeline-output-description.h"
 
+/**
+ * @brief Work submitted to the GPU since the last reset
+ */
+struct RenderStats {
+	unsigned int drawCalls = 0;
+	unsigned int instances = 0;
+	size_t uploadedBytes = 0;
+};
+
 class RenderCommand {
 public:
     RenderCommand();
@@ -88,7 +97,7 @@ public:
     void bindVertexBuffer(const VertexBuffer& vb) const;
 	void bindIndexBuffer(const IndexBuffer& ib) const;
 	void bindTexture(const Texture& tex) const;
-	void bindTextureIds(const std::vector<unsigned int>& textureIds) const;
+	void bindTextureIds(const unsigned int* textureIds, size_t count) const;
 
 	/**
 	 * @brief Will bind all the shaders of the said pipeline
@@ -143,6 +152,13 @@ public:
 	void deleteTexture(Texture& texture) const;
 	void deletePipeline(Pipeline& pip) const;
 
+	///////////////////////////////////////////////////////////////////////////
+	////////////////////////////////// STATS //////////////////////////////////
+	///////////////////////////////////////////////////////////////////////////
+
+	const RenderStats& stats() const { return m_stats; }
+	void resetStats() { m_stats = RenderStats(); }
+
 private:
 	bool hasShaderCompiled(unsigned int shaderId, unsigned int shaderType) const;
 	bool isShaderDataTypeIntegrer(ShaderDataType type) const;
@@ -152,4 +168,7 @@ private:
 	GLenum renderTargetChannelsToOpenGLBaseFormat(RenderTargetChannels channels) const;
 	GLenum renderTargetDataTypeToOpenGLBaseType(RenderTargetDataType dataType) const;
 	GLenum attributeBufferUsageToOpenGLBaseType(AttributeBufferUsage usage) const;
+
+private:
+	mutable RenderStats m_stats; // Counted by the const drawing and updating functions
 };
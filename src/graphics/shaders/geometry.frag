@@ -39,7 +39,11 @@ float getFaceNumber(vec3 normal) {
 void main() {
 	g_id = vec4(v_id, getFaceNumber(v_normal));
 	g_normal = vec4(v_normal, 1.0);
-	g_albedo = vec4(materials[v_materialId].albedo, 1.0);
+	// Selected cubes have the bit after the material index set
+	vec3 albedo = materials[v_materialId & 255u].albedo;
+	if (v_materialId > 255u)
+		albedo = mix(albedo, vec3(1.0, 0.55, 0.1), 0.6);
+	g_albedo = vec4(albedo, 1.0);
 	g_lightSpacePosition = v_lightSpacePosition;
 }
 
@@ -2,6 +2,7 @@
 
 #include <imgui/imgui.h>
 #include <imgui_internal.h>
+#include <glm/gtc/type_ptr.hpp>
 
 #include "gui/icons-awesome.h"
 
@@ -16,11 +17,19 @@ void BrushGui::update() {
         ImGui::Text("  Usage");
         ImGui::PushStyleVar(ImGuiStyleVar_FrameRounding, m_scomps.uiStyle.largeButtonRounding());
         {
-            /*
             if (drawButton(ICON_FA_MOUSE_POINTER, "Select", m_scomps.brush.usage() == BrushUse::SELECT)) {
                 m_scomps.brush.m_usage = BrushUse::SELECT;
             }
-            */
+
+            // Screen selections cannot edit voxels, and stamps can only add them
+            const BrushType type = m_scomps.brush.type();
+            if (m_scomps.brush.usage() != BrushUse::SELECT && (type == BrushType::MARQUEE || type == BrushType::LASSO)) {
+                m_scomps.brush.m_type = BrushType::VOXEL;
+            } else if (m_scomps.brush.usage() != BrushUse::ADD && type == BrushType::STAMP) {
+                m_scomps.brush.m_type = BrushType::VOXEL;
+            } else if (m_scomps.brush.usage() == BrushUse::SELECT && type == BrushType::FILTER) {
+                m_scomps.brush.m_type = BrushType::VOXEL;
+            }
             if (drawButton(ICON_FA_PEN, "Add", m_scomps.brush.usage() == BrushUse::ADD)) {
                 m_scomps.brush.m_usage = BrushUse::ADD;
             }
@@ -43,28 +52,94 @@ void BrushGui::update() {
             if (drawButton(ICON_FA_CUBES, "Box", m_scomps.brush.type() == BrushType::BOX)) {
                 m_scomps.brush.m_type = BrushType::BOX;
             }
-            /*
-            if (drawButton(ICON_FA_TH, "Face", m_scomps.brush.type() == BrushType::FACE)) {
-                m_scomps.brush.m_type = BrushType::FACE;
-            }
             if (drawButton(ICON_FA_SLASH, "Line", m_scomps.brush.type() == BrushType::LINE)) {
                 m_scomps.brush.m_type = BrushType::LINE;
             }
             if (drawButton(ICON_FA_STOP_CIRCLE, "Circle", m_scomps.brush.type() == BrushType::CIRCLE)) {
                 m_scomps.brush.m_type = BrushType::CIRCLE;
             }
-            */
+            if (drawButton(ICON_FA_TH, "Face", m_scomps.brush.type() == BrushType::FACE)) {
+                m_scomps.brush.m_type = BrushType::FACE;
+            }
+            if (drawButton(ICON_FA_FILL, "Fill", m_scomps.brush.type() == BrushType::FILL)) {
+                m_scomps.brush.m_type = BrushType::FILL;
+            }
+            if (m_scomps.brush.usage() == BrushUse::SELECT) {
+                if (drawButton(ICON_FA_VECTOR_SQUARE, "Marquee", m_scomps.brush.type() == BrushType::MARQUEE)) {
+                    m_scomps.brush.m_type = BrushType::MARQUEE;
+                }
+                if (drawButton(ICON_FA_DRAW_POLYGON, "Lasso", m_scomps.brush.type() == BrushType::LASSO)) {
+                    m_scomps.brush.m_type = BrushType::LASSO;
+                }
+            }
+            if (m_scomps.brush.usage() == BrushUse::ADD) {
+                if (drawButton(ICON_FA_STAMP, "Stamp clipboard", m_scomps.brush.type() == BrushType::STAMP)) {
+                    m_scomps.brush.m_type = BrushType::STAMP;
+                }
+            }
+            if (m_scomps.brush.usage() != BrushUse::SELECT) {
+                if (drawButton(ICON_FA_MAGIC, "Filter", m_scomps.brush.type() == BrushType::FILTER)) {
+                    m_scomps.brush.m_type = BrushType::FILTER;
+                }
+            }
         }
         ImGui::PopStyleVar(1);
 
-        /*
-        ImGui::Spacing();
-        ImGui::Spacing();
-        ImGui::Separator();
-        ImGui::Spacing();
+        const BrushType type = m_scomps.brush.type();
+        const bool isSelecting = m_scomps.brush.usage() == BrushUse::SELECT;
+
+        // Screen selections and stamps do not use cells of the brush
+        if (type != BrushType::MARQUEE && type != BrushType::LASSO && type != BrushType::STAMP && type != BrushType::FILTER) {
+            ImGui::Spacing();
+            ImGui::Spacing();
+            ImGui::Separator();
+            ImGui::Spacing();
+
+            ImGui::Text("  Symmetry");
+            ImGui::Checkbox("X", &m_scomps.brush.m_symmetry.x);
+            ImGui::SameLine();
+            ImGui::Checkbox("Y", &m_scomps.brush.m_symmetry.y);
+            ImGui::SameLine();
+            ImGui::Checkbox("Z", &m_scomps.brush.m_symmetry.z);
+            if (glm::any(m_scomps.brush.symmetry()))
+                ImGui::InputInt3("Center", glm::value_ptr(m_scomps.brush.m_symmetryCenter));
+        }
+        if (isSelecting || type == BrushType::LINE || type == BrushType::CIRCLE || type == BrushType::FACE || type == BrushType::FILL || type == BrushType::STAMP || type == BrushType::FILTER) {
+            ImGui::Spacing();
+            ImGui::Spacing();
+            ImGui::Separator();
+            ImGui::Spacing();
+
+            ImGui::Text("  Options");
+            if (isSelecting) {
+                int mode = static_cast<int>(m_scomps.brush.selectionMode());
+                ImGui::RadioButton("Replace", &mode, static_cast<int>(SelectionMode::REPLACE));
+                ImGui::SameLine();
+                ImGui::RadioButton("Add", &mode, static_cast<int>(SelectionMode::UNITE));
+                ImGui::RadioButton("Subtract", &mode, static_cast<int>(SelectionMode::SUBTRACT));
+                ImGui::SameLine();
+                ImGui::RadioButton("Intersect", &mode, static_cast<int>(SelectionMode::INTERSECT));
+                m_scomps.brush.m_selectionMode = static_cast<SelectionMode>(mode);
+            }
 
-        ImGui::Text("Options");   
-        */
+            if (type == BrushType::LINE)
+                ImGui::SliderInt("Size", &m_scomps.brush.m_size, 1, 16);
+            else if (type == BrushType::CIRCLE)
+                ImGui::Checkbox("Flat", &m_scomps.brush.m_isFlat);
+            else if (type == BrushType::FACE)
+                ImGui::Checkbox("Same material", &m_scomps.brush.m_isSameMaterial);
+            else if (type == BrushType::FILL)
+                ImGui::SliderInt("Limit", &m_scomps.brush.m_fillLimit, 8, 256);
+            else if (type == BrushType::STAMP) {
+                const glm::ivec3 size = m_scomps.clipboard.size(m_scomps.brush.stampTurns());
+                ImGui::Text("%zu voxels, %d x %d x %d", m_scomps.clipboard.voxelCount(), size.x, size.y, size.z);
+                ImGui::SliderInt("Quarter turns", &m_scomps.brush.m_stampTurns, 0, 3);
+                ImGui::Checkbox("Mirror", &m_scomps.brush.m_isStampMirrored);
+            } else if (type == BrushType::FILTER) {
+                drawFilterCombo(m_scomps.brush.m_filter);
+                ImGui::SliderInt("Radius", &m_scomps.brush.m_filterRadius, 1, 32);
+            }
+        }
     }
     ImGui::End();
 }
@@ -73,6 +148,13 @@ void BrushGui::onEvent(GuiEvent e) {
 
 }
 
+void BrushGui::drawFilterCombo(MorphologyFilter& filter) {
+    const char* names[] = { "Dilate", "Erode", "Open", "Close", "Smooth" };
+    int index = static_cast<int>(filter);
+    ImGui::Combo("Filter", &index, names, IM_ARRAYSIZE(names));
+    filter = static_cast<MorphologyFilter>(index);
+}
+
 bool BrushGui::drawButton(const char* text, const char* tooltip, bool toggled) {
     bool isPressed = false;
 
@@ -12,6 +12,11 @@ public:
     virtual void update() override;
     virtual void onEvent(GuiEvent e) override;
 
+    /**
+     * @brief Pick a morphological filter, shared with the selection window
+     */
+    static void drawFilterCombo(MorphologyFilter& filter);
+
 private:
     bool drawButton(const char* text, const char* tooltip, bool toggled = false);
 
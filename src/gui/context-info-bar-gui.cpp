@@ -33,6 +33,13 @@ void ContextInfoBarGui::update() {
         ImGui::Text("| M: Pan "); 
         ImGui::SameLine(0, 0);
         ImGui::Text("| R: Move ");
+
+        if (m_scomps.loading.isLoading()) {
+            ImGui::SameLine(0, 0);
+            ImGui::Text("| Loading ");
+            ImGui::SameLine(0, 0);
+            ImGui::ProgressBar(m_scomps.loading.progress(), ImVec2(100.0f, 0.0f));
+        }
         
         // Right part
         ImGui::SameLine(ImGui::GetWindowContentRegionMax().x - 135.0f, 0);
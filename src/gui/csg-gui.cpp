@@ -0,0 +1,47 @@
+#include "csg-gui.h"
+
+#include <imgui/imgui.h>
+#include <glm/gtc/type_ptr.hpp>
+
+#include "gui/icons-awesome.h"
+
+CsgGui::CsgGui(Context& ctx, SingletonComponents& scomps) 
+    : m_ctx(ctx), m_scomps(scomps), m_offset(0), m_isReplacing(true) {}
+
+CsgGui::~CsgGui() {}
+
+void CsgGui::update() {
+    ImGui::Begin(ICON_FA_OBJECT_GROUP "  CSG", 0);
+    {
+        const Clipboard& clipboard = m_scomps.clipboard;
+        if (clipboard.empty()) {
+            ImGui::TextWrapped("Copy a selection to combine it with the scene");
+        } else {
+            const glm::ivec3 size = clipboard.size();
+            ImGui::Text("Clipboard of %zu voxels, %d x %d x %d", clipboard.voxelCount(), size.x, size.y, size.z);
+            ImGui::InputInt3("Position", glm::value_ptr(m_offset));
+            ImGui::Checkbox("Clipboard materials on overlap", &m_isReplacing);
+
+            // The scene is replaced when loading ends
+            if (!m_scomps.loading.isLoading()) {
+                if (ImGui::Button("Unite"))
+                    apply(GuiCommandType::CSG_UNITE);
+                ImGui::SameLine();
+                if (ImGui::Button("Subtract"))
+                    apply(GuiCommandType::CSG_SUBTRACT);
+                ImGui::SameLine();
+                if (ImGui::Button("Intersect"))
+                    apply(GuiCommandType::CSG_INTERSECT);
+            }
+        }
+    }
+    ImGui::End();
+}
+
+void CsgGui::onEvent(GuiEvent e) {
+
+}
+
+void CsgGui::apply(GuiCommandType operation) {
+    m_scomps.guiCommands.push({ operation, m_offset, m_isReplacing });
+}
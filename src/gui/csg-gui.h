@@ -0,0 +1,29 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include "i-gui.h"
+#include "context.h"
+#include "scomponents/singleton-components.h"
+
+/**
+ * @brief Boolean operations between the scene and the clipboard
+ */
+class CsgGui : public IGui {
+public:
+    CsgGui(Context& ctx, SingletonComponents& scomps);
+    virtual ~CsgGui();
+
+    virtual void update() override;
+    virtual void onEvent(GuiEvent e) override;
+
+private:
+    void apply(GuiCommandType operation);
+
+private:
+    Context& m_ctx;
+    SingletonComponents& m_scomps;
+
+    glm::ivec3 m_offset;
+    bool m_isReplacing;
+};
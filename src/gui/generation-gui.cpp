@@ -7,7 +7,6 @@
 
 #include "gui/icons-awesome.h"
 #include "maths/rbf.h"
-#include "components/graphics/material.h"
 #include "components/physics/transform.h"
 
 GenerationGui::GenerationGui(Context& ctx, SingletonComponents& scomps) 
@@ -47,24 +46,24 @@ void GenerationGui::update() {
         ImGui::Separator();
         ImGui::Spacing();
 
-        if (ImGui::Button("Generate")) {
+        if (ImGui::Button("Generate") && !m_scomps.loading.isLoading()) {
             Eigen::VectorXd controlPointWeights(m_controlPointsXYZ.size());
             for (unsigned int i = 0; i < m_controlPointsWeights.size(); i++) {
                 controlPointWeights[i] = m_controlPointsWeights.at(i);
             }
 
+            // Sized once, as rbfInterpolate and move need std::vector
             std::vector<glm::ivec3> coordWithYtoFind;
             std::vector<met::entity> entityToChange;
+            coordWithYtoFind.reserve(m_scomps.voxelGrid.size());
+            entityToChange.reserve(m_scomps.voxelGrid.size());
             m_ctx.registry.view<comp::Transform>().each([&](met::entity id, comp::Transform& transform){
                 coordWithYtoFind.push_back(transform.position);
                 entityToChange.push_back(id);
             });
             voxmt::rbfInterpolate(coordWithYtoFind, m_controlPointsXYZ, controlPointWeights, voxmt::RBFType::LINEAR, 0.5f, voxmt::RBFTransformAxis::Y);
 
-            for (size_t i = 0; i < coordWithYtoFind.size(); i++) {
-                comp::Transform& trans =  m_ctx.registry.get<comp::Transform>(entityToChange.at(i));
-                trans.position = coordWithYtoFind.at(i);
-            }
+            m_ctx.editor.move(entityToChange, coordWithYtoFind);
             
         }
     ImGui::End();
@@ -1,19 +1,26 @@
 #include "main-menu-bar-gui.h"
 
 #include <imgui/imgui_internal.h>
+#include <spdlog/spdlog.h>
+#include <profiling/instrumentor.h>
 
 #ifndef __EMSCRIPTEN__
     #include <tinyfiledialogs/tinyfiledialogs.h>
 #endif
 
 #include "icons-awesome.h"
-#include "loaders/cbe-loader.h"
+#include "loaders/vox-writer.h"
+#include "exporters/mesh-exporter.h"
+#include "graphics/gpu-profiler.h"
 
 
 MainMenuBarGui::MainMenuBarGui(Context& ctx, SingletonComponents& scomps) 
     : m_ctx(ctx), m_scomps(scomps), m_setDefaultLayout(true) {}
 
-MainMenuBarGui::~MainMenuBarGui() {}
+MainMenuBarGui::~MainMenuBarGui() {
+    if (m_exportJob.valid())
+        m_exportJob.wait();
+}
 
 void MainMenuBarGui::update() {
     ImGuiViewport* viewport = ImGui::GetMainViewport();
@@ -40,17 +47,59 @@ void MainMenuBarGui::update() {
             if (ImGui::BeginMenu("File")) {
 
 #ifndef __EMSCRIPTEN__
-                if (ImGui::MenuItem("Open model")) {
-                    char const* filters[1] = { "*.cbe" };
-                    const char* filePath = tinyfd_openFileDialog("Load a .cbe model", "", 1, filters, 0, 0);
+                if (ImGui::MenuItem("Open model", nullptr, false, !m_scomps.loading.isLoading())) {
+                    char const* filters[2] = { "*.cbe", "*.vox" };
+                    const char* filePath = tinyfd_openFileDialog("Load a model", "", 2, filters, 0, 0);
                     if (filePath != nullptr) {
-                        CbeLoader loader(m_ctx);
-                        loader.loadFile(filePath);
+                        m_scomps.loading.m_filePath = filePath;
+                    }
+                }
+
+                const bool isExporting = m_exportJob.valid() && m_exportJob.wait_for(std::chrono::seconds(0)) != std::future_status::ready;
+                if (ImGui::MenuItem("Export .vox", nullptr, false, !isExporting)) {
+                    char const* filters[1] = { "*.vox" };
+                    const char* filePath = tinyfd_saveFileDialog("Export a .vox model", "model.vox", 1, filters, 0);
+                    if (filePath != nullptr) {
+                        // The grid snapshot and the palette copy can be read while the editor keeps running
+                        std::vector<cb::perMaterialChange> palette(m_scomps.materials.begin(), m_scomps.materials.end());
+                        m_exportJob = std::async(std::launch::async, [filePath = std::string(filePath), chunks = m_scomps.voxelGrid.snapshot(), palette = std::move(palette)]() {
+                            VoxWriter writer;
+                            writer.writeFile(filePath.c_str(), chunks, palette);
+                        });
+                    }
+                }
+
+                if (ImGui::MenuItem("Export mesh", nullptr, false, !isExporting)) {
+                    char const* filters[3] = { "*.obj", "*.ply", "*.gltf" };
+                    const char* filePath = tinyfd_saveFileDialog("Export a triangle mesh", "model.gltf", 3, filters, "Mesh (.obj, .ply, .gltf)");
+                    if (filePath != nullptr && MeshExporter::isSupported(filePath)) {
+                        std::vector<cb::perMaterialChange> palette(m_scomps.materials.begin(), m_scomps.materials.end());
+                        m_exportJob = std::async(std::launch::async, [filePath = std::string(filePath), chunks = m_scomps.voxelGrid.snapshot(), palette = std::move(palette)]() {
+                            MeshExporter exporter;
+                            exporter.writeFile(filePath.c_str(), chunks, palette);
+                        });
                     }
                 }
 #endif
                 ImGui::EndMenu();
             }
+
+            if (ImGui::BeginMenu("Profiling")) {
+                bool isRecording = Instrumentor::get().isEnabled();
+                if (ImGui::MenuItem("Record last frames", nullptr, &isRecording))
+                    Instrumentor::get().setEnabled(isRecording);
+
+                bool isTimingGpu = GpuProfiler::get().isEnabled();
+                if (ImGui::MenuItem("Time render passes on the gpu", nullptr, &isTimingGpu, GpuProfiler::get().isSupported()))
+                    GpuProfiler::get().setEnabled(isTimingGpu);
+
+                if (ImGui::MenuItem("Save capture", "F12", false, isRecording)) {
+                    const std::string filePath = Instrumentor::get().saveCapture();
+                    if (!filePath.empty())
+                        spdlog::info("[Profiling] Last frames saved to {}", filePath);
+                }
+                ImGui::EndMenu();
+            }
             ImGui::EndMainMenuBar();
         }
     }
@@ -95,8 +144,11 @@ void MainMenuBarGui::setDefaultLayout() {
     ImGui::DockBuilderDockWindow(ICON_FA_BRUSH "  Brush", dock_half_left_left_id);
 
     ImGui::DockBuilderDockWindow(ICON_FA_GLOBE_AMERICAS "  Scene Outline", dock_half_right_up_id);
+    ImGui::DockBuilderDockWindow(ICON_FA_CHART_LINE "  Performance", dock_half_right_up_id);
     ImGui::DockBuilderDockWindow(ICON_FA_PALETTE "  Palette", dock_half_right_down_id);
     ImGui::DockBuilderDockWindow(ICON_FA_SEEDLING "  Generation", dock_half_right_down_id);
+    ImGui::DockBuilderDockWindow(ICON_FA_VECTOR_SQUARE "  Selection", dock_half_right_down_id);
+    ImGui::DockBuilderDockWindow(ICON_FA_OBJECT_GROUP "  CSG", dock_half_right_down_id);
     
     // Set appearance
     ImGui::DockBuilderGetNode(dock_main_id)->LocalFlags |= ImGuiDockNodeFlags_NoSplit;
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <imgui.h>
+#include <future>
 
 #include "i-gui.h"
 #include "context.h"
@@ -24,4 +25,5 @@ private:
 
     ImGuiID m_dockspaceId;
     bool m_setDefaultLayout;
+    std::future<void> m_exportJob;
 };
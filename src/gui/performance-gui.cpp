@@ -0,0 +1,163 @@
+#include "performance-gui.h"
+
+#include <imgui/imgui.h>
+#include <profiling/instrumentor.h>
+#include <algorithm>
+#include <numeric>
+#include <cstring>
+#ifdef __GNUG__
+    #include <cxxabi.h>
+    #include <cstdlib>
+#endif
+
+#include "gui/icons-awesome.h"
+#include "graphics/gpu-profiler.h"
+#include "memory/allocation-counter.h"
+
+namespace {
+    /**
+     * @brief Names are compared as strings, as each translation unit can have its own copy of a literal
+     * @return -1 if there is no scope of this name
+     */
+    double totalDuration(const std::vector<ScopeDuration>& durations, const char* name) {
+        double milliseconds = -1.0;
+        for (const ScopeDuration& duration : durations) {
+            if (std::strcmp(duration.name, name) == 0)
+                milliseconds = std::max(milliseconds, 0.0) + duration.milliseconds;
+        }
+        return milliseconds;
+    }
+
+    const char* systemScopes[] = { "RenderSystem update", "SelectionSystem update", "CameraSystem update", "BrushSystem update" };
+    const char* passScopes[] = { "Geometry pass", "Shadow map pass", "Lighting pass", "Grid pass", "GUI pass" };
+}
+
+PerformanceGui::PerformanceGui(Context& ctx, SingletonComponents& scomps) 
+    : m_ctx(ctx), m_scomps(scomps), m_frameTimeOffset(0)
+{
+    m_frameTimes.fill(0.0f);
+}
+
+PerformanceGui::~PerformanceGui() {}
+
+void PerformanceGui::update() {
+    m_frameTimes.at(m_frameTimeOffset) = ImGui::GetIO().DeltaTime * 1000.0f;
+    m_frameTimeOffset = (m_frameTimeOffset + 1) % m_frameTimes.size();
+
+    ImGui::Begin(ICON_FA_CHART_LINE "  Performance", 0);
+    {
+        // Frame times
+        const float average = std::accumulate(m_frameTimes.begin(), m_frameTimes.end(), 0.0f) / m_frameTimes.size();
+        const float maximum = *std::max_element(m_frameTimes.begin(), m_frameTimes.end());
+        char overlay[64];
+        snprintf(overlay, sizeof(overlay), "%.2f ms (%.0f fps), max %.2f ms", average, average > 0.0f ? 1000.0f / average : 0.0f, maximum);
+        ImGui::SetNextItemWidth(-1.0f);
+        ImGui::PlotLines("##Frame times", m_frameTimes.data(), static_cast<int>(m_frameTimes.size()), static_cast<int>(m_frameTimeOffset), overlay, 0.0f, std::max(maximum, 1000.0f / 30.0f), ImVec2(0.0f, 60.0f));
+
+        // Timings of the last frame
+        ImGui::Spacing();
+        if (Instrumentor::get().isEnabled()) {
+            Instrumentor::get().lastFrameDurations(m_scopeDurations);
+            drawTimings("Systems", systemScopes, IM_ARRAYSIZE(systemScopes), false);
+            drawTimings("Render passes", passScopes, IM_ARRAYSIZE(passScopes), GpuProfiler::get().isActive());
+        } else {
+            ImGui::TextDisabled("Enable Profiling > Record last frames to get timings");
+        }
+
+        // Counters
+        const RenderStats& stats = m_ctx.rcommand.stats();
+        if (ImGui::CollapsingHeader("Rendering", ImGuiTreeNodeFlags_DefaultOpen)) {
+            ImGui::Columns(2, "Rendering", false);
+            ImGui::Text("Draw calls"); ImGui::NextColumn(); ImGui::Text("%u", stats.drawCalls); ImGui::NextColumn();
+            ImGui::Text("Instances"); ImGui::NextColumn(); ImGui::Text("%u", stats.instances); ImGui::NextColumn();
+            ImGui::Text("Uploaded"); ImGui::NextColumn(); ImGui::Text("%.1f KB", stats.uploadedBytes / 1024.0f); ImGui::NextColumn();
+            ImGui::Columns(1);
+        }
+
+        if (ImGui::CollapsingHeader("Memory", ImGuiTreeNodeFlags_DefaultOpen)) {
+            ImGui::Columns(2, "Memory", false);
+            ImGui::Text("Heap allocations"); ImGui::NextColumn();
+            if (allocation::isCounted())
+                ImGui::Text("%llu per frame", static_cast<unsigned long long>(allocation::lastFrameCount()));
+            else
+                ImGui::TextDisabled("Counted in debug builds");
+            ImGui::NextColumn();
+            ImGui::Text("Frame arena"); ImGui::NextColumn();
+            ImGui::Text("%.1f / %.1f KB", m_ctx.frameArena.peak() / 1024.0f, m_ctx.frameArena.capacity() / 1024.0f); ImGui::NextColumn();
+            ImGui::Columns(1);
+        }
+
+        if (ImGui::CollapsingHeader("Scene", ImGuiTreeNodeFlags_DefaultOpen)) {
+            ImGui::Columns(3, "Scene", false);
+            ImGui::Text("Entities"); ImGui::NextColumn(); ImGui::Text("%zu", m_ctx.registry.alive()); ImGui::NextColumn(); ImGui::NextColumn();
+            ImGui::Text("Voxel chunks"); ImGui::NextColumn(); ImGui::Text("%zu", m_scomps.voxelGrid.chunkCount()); ImGui::NextColumn();
+            ImGui::Text("%.1f KB", m_scomps.voxelGrid.chunkCount() * sizeof(VoxelChunk) / 1024.0f); ImGui::NextColumn();
+
+            m_ctx.registry.collections(m_collections);
+            std::sort(m_collections.begin(), m_collections.end(), [](const met::CollectionInfo& a, const met::CollectionInfo& b) {
+                return a.memoryUsage > b.memoryUsage;
+            });
+            for (const met::CollectionInfo& collection : m_collections) {
+                ImGui::Text("%s", readableTypeName(collection.typeName).c_str()); ImGui::NextColumn();
+                ImGui::Text("%zu", collection.size); ImGui::NextColumn();
+                ImGui::Text("%.1f KB", collection.memoryUsage / 1024.0f); ImGui::NextColumn();
+            }
+            ImGui::Columns(1);
+        }
+    }
+    ImGui::End();
+}
+
+void PerformanceGui::onEvent(GuiEvent e) {
+
+}
+
+void PerformanceGui::drawTimings(const char* label, const char* const* scopeNames, size_t count, bool withGpu) const {
+    if (!ImGui::CollapsingHeader(label, ImGuiTreeNodeFlags_DefaultOpen))
+        return;
+
+    auto drawDuration = [](const std::vector<ScopeDuration>& durations, const char* name) {
+        const double milliseconds = totalDuration(durations, name);
+        if (milliseconds >= 0.0)
+            ImGui::Text("%.3f ms", milliseconds);
+        else
+            ImGui::TextDisabled("-");
+        ImGui::NextColumn();
+    };
+
+    ImGui::Columns(withGpu ? 3 : 2, label, false);
+    ImGui::TextDisabled("Scope"); ImGui::NextColumn();
+    ImGui::TextDisabled("CPU"); ImGui::NextColumn();
+    if (withGpu) {
+        ImGui::TextDisabled("GPU"); ImGui::NextColumn();
+    }
+    for (size_t i = 0; i < count; i++) {
+        ImGui::Text("%s", scopeNames[i]);
+        ImGui::NextColumn();
+        drawDuration(m_scopeDurations, scopeNames[i]);
+        if (withGpu)
+            drawDuration(GpuProfiler::get().lastFrameDurations(), scopeNames[i]);
+    }
+    ImGui::Columns(1);
+}
+
+const std::string& PerformanceGui::readableTypeName(const std::string& typeName) {
+    const auto it = m_readableTypeNames.find(typeName);
+    if (it != m_readableTypeNames.end())
+        return it->second;
+
+#ifdef __GNUG__
+    std::string name = typeName;
+    int status = 0;
+    char* demangled = abi::__cxa_demangle(typeName.c_str(), nullptr, nullptr, &status);
+    if (status == 0 && demangled != nullptr) {
+        name = demangled;
+        std::free(demangled);
+    }
+#else
+    // Visual studio names are already readable, like "struct comp::Transform"
+    const size_t space = typeName.find(' ');
+    const std::string name = space != std::string::npos ? typeName.substr(space + 1) : typeName;
+#endif
+    return m_readableTypeNames.emplace(typeName, name).first->second;
+}
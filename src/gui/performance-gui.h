@@ -0,0 +1,40 @@
+#pragma once
+
+#include <array>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <profiling/instrumentor.h>
+
+#include "i-gui.h"
+#include "context.h"
+#include "scomponents/singleton-components.h"
+
+/**
+ * @brief Frame times, time spent in systems and render passes, and memory usage of the scene
+ * @note Timings come from the profiling scopes, so they are only shown while profiling is recording.
+ */
+class PerformanceGui : public IGui {
+public:
+    PerformanceGui(Context& ctx, SingletonComponents& scomps);
+    virtual ~PerformanceGui();
+
+    virtual void update() override;
+    virtual void onEvent(GuiEvent e) override;
+
+private:
+    void drawTimings(const char* label, const char* const* scopeNames, size_t count, bool withGpu) const;
+    const std::string& readableTypeName(const std::string& typeName);
+
+private:
+    Context& m_ctx;
+    SingletonComponents& m_scomps;
+
+    std::array<float, 120> m_frameTimes;
+    size_t m_frameTimeOffset;
+
+    // Kept between frames, so the panel does not allocate each frame
+    std::vector<ScopeDuration> m_scopeDurations;
+    std::vector<met::CollectionInfo> m_collections;
+    std::unordered_map<std::string, std::string> m_readableTypeNames;
+};
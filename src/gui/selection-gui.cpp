@@ -0,0 +1,55 @@
+#include "selection-gui.h"
+
+#include <imgui/imgui.h>
+#include <glm/gtc/type_ptr.hpp>
+
+#include "gui/icons-awesome.h"
+#include "gui/brush-gui.h"
+
+SelectionGui::SelectionGui(Context& ctx, SingletonComponents& scomps) 
+    : m_ctx(ctx), m_scomps(scomps), m_offset(0, 1, 0), m_filter(MorphologyFilter::SMOOTH) {}
+
+SelectionGui::~SelectionGui() {}
+
+void SelectionGui::update() {
+    ImGui::Begin(ICON_FA_VECTOR_SQUARE "  Selection", 0);
+    {
+        Selection& selection = m_scomps.selection;
+        ImGui::Text("%zu cells selected", selection.size());
+
+        if (ImGui::Button("Select all"))
+            m_scomps.guiCommands.push({ GuiCommandType::SELECT_ALL });
+        ImGui::SameLine();
+        if (ImGui::Button("Deselect"))
+            m_scomps.guiCommands.push({ GuiCommandType::DESELECT });
+
+        // The scene is replaced when loading ends
+        if (!selection.empty() && !m_scomps.loading.isLoading()) {
+            ImGui::Spacing();
+            ImGui::Separator();
+            ImGui::Spacing();
+
+            if (ImGui::Button(ICON_FA_COPY "  Copy"))
+                m_scomps.guiCommands.push({ GuiCommandType::COPY_SELECTION });
+            ImGui::SameLine();
+            if (ImGui::Button(ICON_FA_ERASER "  Delete"))
+                m_scomps.guiCommands.push({ GuiCommandType::DELETE_SELECTION });
+            ImGui::SameLine();
+            if (ImGui::Button(ICON_FA_PAINT_BRUSH "  Paint"))
+                m_scomps.guiCommands.push({ GuiCommandType::PAINT_SELECTION });
+
+            ImGui::InputInt3("Offset", glm::value_ptr(m_offset));
+            if (ImGui::Button(ICON_FA_ARROWS_ALT "  Move"))
+                m_scomps.guiCommands.push({ GuiCommandType::MOVE_SELECTION, m_offset });
+
+            BrushGui::drawFilterCombo(m_filter);
+            if (ImGui::Button(ICON_FA_MAGIC "  Filter"))
+                m_scomps.guiCommands.push({ GuiCommandType::FILTER_SELECTION, glm::ivec3(0), static_cast<int>(m_filter) });
+        }
+    }
+    ImGui::End();
+}
+
+void SelectionGui::onEvent(GuiEvent e) {
+
+}
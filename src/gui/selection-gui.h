@@ -0,0 +1,23 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include "i-gui.h"
+#include "context.h"
+#include "scomponents/singleton-components.h"
+
+class SelectionGui : public IGui {
+public:
+    SelectionGui(Context& ctx, SingletonComponents& scomps);
+    virtual ~SelectionGui();
+
+    virtual void update() override;
+    virtual void onEvent(GuiEvent e) override;
+
+private:
+    Context& m_ctx;
+    SingletonComponents& m_scomps;
+
+    glm::ivec3 m_offset;
+    MorphologyFilter m_filter;
+};
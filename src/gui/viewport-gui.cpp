@@ -4,9 +4,7 @@
 #include <glm/glm.hpp>
 #include <imgui.h>
 #include <spdlog/spdlog.h>
-
-#include "components/graphics/material.h"
-#include "components/physics/transform.h"
+#include <vector>
 
 // Temp
 #ifdef __EMSCRIPTEN__
@@ -15,16 +13,12 @@
 	#include <glad/gles2.h>
 #endif
 
-ViewportGui::ViewportGui(Context& ctx, SingletonComponents& scomps) : m_ctx(ctx), m_scomps(scomps) {
-    comp::Material material;
-
+ViewportGui::ViewportGui(Context& ctx, SingletonComponents& scomps) : m_ctx(ctx), m_scomps(scomps), m_windowSize(0) {
     for (size_t x = 0; x < 1; x++)
     {
         for (size_t z = 0; z < 1; z++)
         {
-            met::entity entity = m_ctx.registry.create();
-            m_ctx.registry.assign<comp::Material>(entity, material);
-            m_ctx.registry.assign<comp::Transform>(entity, glm::ivec3(x, 0, z));
+            m_ctx.editor.add(glm::ivec3(x, 0, z), 0);
         }
         
     }
@@ -48,17 +42,11 @@ void ViewportGui::update() {
 			m_scomps.viewport.m_isHovered = false;
 		}
 
-        // Handle framebuffer
+        // Handle framebuffer. Only follows the window, as an input replay can force another size.
         ImVec2 viewportSize = ImGui::GetWindowSize();
-        if (viewportSize.x != m_scomps.viewport.size().x || viewportSize.y != m_scomps.viewport.size().y) {
-            m_scomps.viewport.m_size = glm::ivec2(viewportSize.x, viewportSize.y);
-            glViewport(0, 0, viewportSize.x, viewportSize.y);
-            m_scomps.camera.m_proj = glm::perspectiveFovLH(glm::quarter_pi<float>(), (float) viewportSize.x, (float) viewportSize.y, 0.1f, 100.0f);
-            
-			// Remake Framebuffers
-            // TODO do it only after a delay
-            m_scomps.renderTargets.destroy(m_ctx.rcommand);
-            m_scomps.renderTargets.init(m_ctx.rcommand, m_scomps.viewport);
+        if (viewportSize.x != m_windowSize.x || viewportSize.y != m_windowSize.y) {
+            m_windowSize = glm::ivec2(viewportSize.x, viewportSize.y);
+            resizeViewport(m_ctx, m_scomps, m_windowSize);
         }
 
         // Update viewport position & draw framebuffer
@@ -71,6 +59,20 @@ void ViewportGui::update() {
 				ImVec2(viewportPosTopLeft.x + viewportSize.x, viewportPosTopLeft.y + viewportSize.y),
 				ImVec2(0, 1), ImVec2(1, 0)
 			);
+
+            // Marquee and lasso are drawn over the scene, from normalized device coordinates
+            const std::vector<glm::vec2>& outline = m_scomps.brushPreview.outline();
+            if (outline.size() > 1) {
+                std::vector<ImVec2> points;
+                points.reserve(outline.size());
+                for (const glm::vec2& p : outline) {
+                    points.push_back(ImVec2(
+                        viewportPosTopLeft.x + (p.x + 1.0f) * 0.5f * viewportSize.x,
+                        viewportPosTopLeft.y + (1.0f - p.y) * 0.5f * viewportSize.y
+                    ));
+                }
+                ImGui::GetWindowDrawList()->AddPolyline(points.data(), static_cast<int>(points.size()), IM_COL32(255, 140, 25, 255), true, 1.5f);
+            }
         }
     }
     ImGui::End();
@@ -81,3 +83,17 @@ void ViewportGui::onEvent(GuiEvent e) {
         default: break;
     }
 }
+
+void ViewportGui::resizeViewport(Context& ctx, SingletonComponents& scomps, const glm::ivec2& size) {
+    if (size == scomps.viewport.size())
+        return;
+
+    scomps.viewport.m_size = size;
+    glViewport(0, 0, size.x, size.y);
+    scomps.camera.m_proj = glm::perspectiveFovLH(glm::quarter_pi<float>(), (float) size.x, (float) size.y, 0.1f, 100.0f);
+
+    // Remake Framebuffers
+    // TODO do it only after a delay
+    scomps.renderTargets.destroy(ctx.rcommand);
+    scomps.renderTargets.init(ctx.rcommand, scomps.viewport);
+}
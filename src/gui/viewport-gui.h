@@ -1,5 +1,7 @@
 #pragma once
 
+#include <glm/glm.hpp>
+
 #include "i-gui.h"
 #include "context.h"
 #include "scomponents/singleton-components.h"
@@ -12,7 +14,13 @@ public:
     virtual void update() override;
     virtual void onEvent(GuiEvent e) override;
 
+    /**
+     * @brief Change the size of the viewport and of its render targets
+     */
+    static void resizeViewport(Context& ctx, SingletonComponents& scomps, const glm::ivec2& size);
+
 private:
     Context& m_ctx;
     SingletonComponents& m_scomps;
+    glm::ivec2 m_windowSize;
 };
@@ -23,11 +23,11 @@ void ViewportOptionBarGui::update() {
 
         ImGui::SameLine();
         if (drawButton(ICON_FA_UNDO, "Undo")) {
-            m_ctx.history.undo();
+            m_scomps.guiCommands.push({ GuiCommandType::UNDO });
         }
         ImGui::SameLine();
         if (drawButton(ICON_FA_REDO, "Redo")) {
-            m_ctx.history.redo();
+            m_scomps.guiCommands.push({ GuiCommandType::REDO });
         }
     }
     ImGui::End();
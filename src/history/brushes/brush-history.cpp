@@ -0,0 +1,29 @@
+#include "brush-history.h"
+
+#include <cassert>
+
+BrushHistory::BrushHistory(VoxelEditor& editor, BrushUse usage, const std::vector<glm::ivec3>& positions, const std::vector<unsigned int>& previousMaterials, unsigned int material)
+    : m_editor(editor), m_usage(usage), m_positions(positions), m_previousMaterials(previousMaterials), m_materials(positions.size(), material)
+{
+    assert((usage == BrushUse::ADD || previousMaterials.size() == positions.size()) && "Each removed or painted voxel needs its previous material");
+}
+
+BrushHistory::~BrushHistory() {}
+
+void BrushHistory::undo() {
+    switch (m_usage) {
+    case BrushUse::ADD: m_editor.remove(m_positions); break;
+    case BrushUse::REMOVE: m_editor.add(m_positions, m_previousMaterials); break;
+    case BrushUse::PAINT: m_editor.paint(m_positions, m_previousMaterials); break;
+    default: break;
+    }
+}
+
+void BrushHistory::redo() {
+    switch (m_usage) {
+    case BrushUse::ADD: m_editor.add(m_positions, m_materials); break;
+    case BrushUse::REMOVE: m_editor.remove(m_positions); break;
+    case BrushUse::PAINT: m_editor.paint(m_positions, m_materials); break;
+    default: break;
+    }
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "history/i-history.h"
+#include "scene/voxel-editor.h"
+#include "scomponents/io/brush.h"
+
+/**
+ * @brief Edit of a brush, from the press to the release of the mouse
+ * @note Voxels are found by position, as their entities change when they are added back.
+ */
+class BrushHistory : public IHistory {
+public:
+    /**
+     * @param previousMaterials - Materials of the voxels before they were removed or painted. Empty when adding.
+     */
+    BrushHistory(VoxelEditor& editor, BrushUse usage, const std::vector<glm::ivec3>& positions, const std::vector<unsigned int>& previousMaterials, unsigned int material);
+    virtual ~BrushHistory();
+
+    void undo() override;
+    void redo() override;
+
+private:
+    VoxelEditor& m_editor;
+    BrushUse m_usage;
+    std::vector<glm::ivec3> m_positions;
+    std::vector<unsigned int> m_previousMaterials;
+    std::vector<unsigned int> m_materials;
+};
@@ -0,0 +1,69 @@
+#include "csg-history.h"
+
+#include "maths/bits.h"
+
+CsgHistory::CsgHistory(VoxelEditor& editor, const VoxelGrid& grid, const VoxelGrid& result)
+    : m_editor(editor)
+{
+    // Only the chunks copied by the operation can differ, and they are compared one word of 64 cells at a time
+    for (const auto& chunk : result.snapshot()) {
+        const glm::ivec3 origin = chunk->position * VoxelChunk::SIZE;
+        const VoxelChunk* current = grid.findChunk(origin);
+        if (current == chunk.get())
+            continue;
+
+        for (int i = 0; i < VoxelChunk::WORD_COUNT; i++) {
+            const std::uint64_t before = current != nullptr ? current->occupancy[i] : 0;
+            const std::uint64_t after = chunk->occupancy[i];
+            std::uint64_t changed = before ^ after;
+            std::uint64_t kept = before & after;
+            while (changed != 0) {
+                const unsigned int index = (i << 6) | voxmt::lowestBitIndex(changed);
+                if ((after >> (index & 63)) & 1) {
+                    m_addedPositions.push_back(chunk->cellPosition(index));
+                    m_addedMaterials.push_back(chunk->materials[index]);
+                } else {
+                    m_removedPositions.push_back(chunk->cellPosition(index));
+                    m_removedMaterials.push_back(current->materials[index]);
+                }
+                changed &= changed - 1;
+            }
+            while (kept != 0) {
+                const unsigned int index = (i << 6) | voxmt::lowestBitIndex(kept);
+                if (chunk->materials[index] != current->materials[index]) {
+                    m_paintedPositions.push_back(chunk->cellPosition(index));
+                    m_paintedMaterials.push_back(chunk->materials[index]);
+                    m_previousMaterials.push_back(current->materials[index]);
+                }
+                kept &= kept - 1;
+            }
+        }
+    }
+
+    // Chunks emptied by the operation are not in the result anymore
+    for (const auto& chunk : grid.snapshot()) {
+        if (result.findChunk(chunk->position * VoxelChunk::SIZE) != nullptr)
+            continue;
+
+        for (unsigned int index = 0; index < VoxelChunk::VOLUME; index++) {
+            if (chunk->has(index)) {
+                m_removedPositions.push_back(chunk->cellPosition(index));
+                m_removedMaterials.push_back(chunk->materials[index]);
+            }
+        }
+    }
+}
+
+CsgHistory::~CsgHistory() {}
+
+void CsgHistory::undo() {
+    m_editor.remove(m_addedPositions);
+    m_editor.add(m_removedPositions, m_removedMaterials);
+    m_editor.paint(m_paintedPositions, m_previousMaterials);
+}
+
+void CsgHistory::redo() {
+    m_editor.remove(m_removedPositions);
+    m_editor.add(m_addedPositions, m_addedMaterials);
+    m_editor.paint(m_paintedPositions, m_paintedMaterials);
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "history/i-history.h"
+#include "scene/voxel-editor.h"
+
+/**
+ * @brief Change of the scene by a boolean operation or a filter, stored as the cells it changed
+ * @note Voxels are found by position, as their entities change when they are added back.
+ */
+class CsgHistory : public IHistory {
+public:
+    /**
+     * @param grid - Scene before the operation
+     * @param result - Scene after the operation, computed on a grid sharing the chunks of the scene. The shared chunks are skipped.
+     */
+    CsgHistory(VoxelEditor& editor, const VoxelGrid& grid, const VoxelGrid& result);
+    virtual ~CsgHistory();
+
+    void undo() override;
+    void redo() override;
+
+    /**
+     * @brief The operation does not change the scene
+     */
+    bool empty() const { return m_addedPositions.empty() && m_removedPositions.empty() && m_paintedPositions.empty(); }
+
+private:
+    VoxelEditor& m_editor;
+    std::vector<glm::ivec3> m_addedPositions;
+    std::vector<unsigned int> m_addedMaterials;
+    std::vector<glm::ivec3> m_removedPositions;
+    std::vector<unsigned int> m_removedMaterials;
+    std::vector<glm::ivec3> m_paintedPositions;
+    std::vector<unsigned int> m_paintedMaterials;
+    std::vector<unsigned int> m_previousMaterials;
+};
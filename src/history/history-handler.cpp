@@ -3,12 +3,16 @@
 HistoryHandler::HistoryHandler(SingletonComponents& scomps) : m_scomps(scomps), m_current(0) {}
 
 HistoryHandler::~HistoryHandler() {
-    for (IHistory* history : m_history) {
-        delete history;
-    }
+    clear();
 }
 
 void HistoryHandler::pushHistory(IHistory* history) {
+    // The undone changes cannot be redone after a new one
+    while (m_history.size() > m_current) {
+        delete m_history.back();
+        m_history.pop_back();
+    }
+
     m_history.push_back(history);
     m_current++;
 }
@@ -24,11 +28,19 @@ bool HistoryHandler::undo() {
 }
 
 bool HistoryHandler::redo() {
-    if (m_current < m_history.size() - 1) {
-        m_history.at(m_current - 1)->redo();
+    if (m_current < m_history.size()) {
+        m_history.at(m_current)->redo();
         m_current++;
         return true;
     } else {
         return false;
     }
 }
+
+void HistoryHandler::clear() {
+    for (IHistory* history : m_history) {
+        delete history;
+    }
+    m_history.clear();
+    m_current = 0;
+}
@@ -14,6 +14,11 @@ public:
     bool undo();
     bool redo();
 
+    /**
+     * @brief Forget every change, when another scene is loaded
+     */
+    void clear();
+
     size_t size() const { return m_history.size(); }
 
 private:
@@ -0,0 +1,36 @@
+#include "move-history.h"
+
+MoveHistory::MoveHistory(VoxelEditor& editor, const VoxelGrid& grid, const Selection& selection, const glm::ivec3& offset)
+    : m_editor(editor), m_offset(offset)
+{
+    Selection moved = selection;
+    moved.intersect(grid);
+    m_positions.reserve(moved.size());
+    moved.positions(m_positions);
+
+    // The moved voxels free their cells before landing, so only the other ones are replaced
+    for (const glm::ivec3& position : m_positions) {
+        const glm::ivec3 target = position + offset;
+        if (grid.has(target) && !moved.has(target)) {
+            m_replacedPositions.push_back(target);
+            m_replacedMaterials.push_back(grid.material(target));
+        }
+    }
+}
+
+MoveHistory::~MoveHistory() {}
+
+void MoveHistory::undo() {
+    std::vector<glm::ivec3> targets;
+    targets.reserve(m_positions.size());
+    for (const glm::ivec3& position : m_positions) {
+        targets.push_back(position + m_offset);
+    }
+    m_editor.move(targets, -m_offset);
+    m_editor.add(m_replacedPositions, m_replacedMaterials);
+}
+
+void MoveHistory::redo() {
+    m_editor.remove(m_replacedPositions);
+    m_editor.move(m_positions, m_offset);
+}
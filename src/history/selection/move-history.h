@@ -0,0 +1,32 @@
+#pragma once
+
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "history/i-history.h"
+#include "scene/voxel-editor.h"
+#include "scomponents/scene/selection.h"
+
+/**
+ * @brief Move of a group of voxels. The voxels outside of the group on which they land are replaced.
+ * @note Voxels are found by position, as their entities change when they are added back.
+ */
+class MoveHistory : public IHistory {
+public:
+    /**
+     * @param grid - Scene before the move, to find the voxels which are moved and replaced
+     * @param selection - Cells of the voxels to move
+     */
+    MoveHistory(VoxelEditor& editor, const VoxelGrid& grid, const Selection& selection, const glm::ivec3& offset);
+    virtual ~MoveHistory();
+
+    void undo() override;
+    void redo() override;
+
+private:
+    VoxelEditor& m_editor;
+    std::vector<glm::ivec3> m_positions;
+    glm::ivec3 m_offset;
+    std::vector<glm::ivec3> m_replacedPositions;
+    std::vector<unsigned int> m_replacedMaterials;
+};
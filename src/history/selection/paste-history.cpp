@@ -0,0 +1,35 @@
+#include "paste-history.h"
+
+#include <cassert>
+
+PasteHistory::PasteHistory(VoxelEditor& editor, const VoxelGrid& grid, const std::vector<glm::ivec3>& positions, const std::vector<unsigned int>& materials)
+    : m_editor(editor)
+{
+    assert(positions.size() == materials.size() && "Each pasted voxel needs its material");
+
+    m_addedPositions.reserve(positions.size());
+    m_addedMaterials.reserve(positions.size());
+    for (size_t i = 0; i < positions.size(); i++) {
+        const glm::ivec3& position = positions[i];
+        if (!grid.has(position)) {
+            m_addedPositions.push_back(position);
+            m_addedMaterials.push_back(materials[i]);
+        } else if (grid.material(position) != materials[i]) {
+            m_paintedPositions.push_back(position);
+            m_paintedMaterials.push_back(materials[i]);
+            m_previousMaterials.push_back(grid.material(position));
+        }
+    }
+}
+
+PasteHistory::~PasteHistory() {}
+
+void PasteHistory::undo() {
+    m_editor.remove(m_addedPositions);
+    m_editor.paint(m_paintedPositions, m_previousMaterials);
+}
+
+void PasteHistory::redo() {
+    m_editor.add(m_addedPositions, m_addedMaterials);
+    m_editor.paint(m_paintedPositions, m_paintedMaterials);
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "history/i-history.h"
+#include "scene/voxel-editor.h"
+
+/**
+ * @brief Stamp of the clipboard. Empty cells are added and the used ones are painted.
+ * @note Voxels are found by position, as their entities change when they are added back.
+ */
+class PasteHistory : public IHistory {
+public:
+    /**
+     * @param grid - Scene before the paste, to find the voxels which are painted
+     * @param positions - Unique cells of the pasted voxels
+     */
+    PasteHistory(VoxelEditor& editor, const VoxelGrid& grid, const std::vector<glm::ivec3>& positions, const std::vector<unsigned int>& materials);
+    virtual ~PasteHistory();
+
+    void undo() override;
+    void redo() override;
+
+    /**
+     * @brief The paste does not change the scene
+     */
+    bool empty() const { return m_addedPositions.empty() && m_paintedPositions.empty(); }
+
+private:
+    VoxelEditor& m_editor;
+    std::vector<glm::ivec3> m_addedPositions;
+    std::vector<unsigned int> m_addedMaterials;
+    std::vector<glm::ivec3> m_paintedPositions;
+    std::vector<unsigned int> m_paintedMaterials;
+    std::vector<unsigned int> m_previousMaterials;
+};
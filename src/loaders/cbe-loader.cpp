@@ -1,42 +1,135 @@
 #include "cbe-loader.h"
 
 #include <spdlog/spdlog.h>
+#include <profiling/instrumentor.h>
 #include <vector>
 #include <Eigen/Dense>
 #include <glm/glm.hpp>
 #include <sstream>
 #include <fstream>
+#include <filesystem>
+#include <tuple>
 
-#include "components/physics/transform.h"
-#include "maths/rbf.h"
-#include "history/generation/rbf-history.h"
+#include "scene/generation.h"
 
-CbeLoader::CbeLoader(Context& ctx) : m_ctx(ctx) {}
+namespace {
+    /**
+     * @brief Voxel chunks are read from files written since version 0.5.0. Before, the key was a placeholder with another layout.
+     */
+    bool hasVoxelChunks(const nlohmann::json& json) {
+        if (!json.contains("version"))
+            return false;
+
+        int major = 0, minor = 0, patch = 0;
+        char dot;
+        std::istringstream version(json["version"].get<std::string>());
+        version >> major >> dot >> minor >> dot >> patch;
+        return std::make_tuple(major, minor, patch) >= std::make_tuple(0, 5, 0);
+    }
+}
+
+CbeLoader::CbeLoader() {}
 
 CbeLoader::~CbeLoader() {}
 
-void CbeLoader::loadFile(const char* cbeFilePath) {
+bool CbeLoader::loadFile(const char* cbeFilePath, StagingScene& scene, std::atomic<float>& progress) {
+    PROFILE_SCOPE("CbeLoader loadFile");
+    progress = 0.0f;
     std::ifstream fileStream(cbeFilePath);
     if (!fileStream) {
 		spdlog::error("[CBEloader] Cannot load file : {}", cbeFilePath);
-		assert(false);
+		return false;
 	}
 
-    const nlohmann::json parsed = nlohmann::json::parse(fileStream);
-    fileStream.close();
+    try {
+        const nlohmann::json parsed = nlohmann::json::parse(fileStream);
+        fileStream.close();
+        progress = 0.1f;
 
-    for (const auto& element : parsed.items()) {
-        if (element.key() == "geometry") {
+        // Geometry is loaded first so that generation is applied on it
+        if (parsed.contains("geometry")) {
+            scene.voxels.clear();
+            geometry(parsed, std::filesystem::path(cbeFilePath).parent_path().string(), hasVoxelChunks(parsed), scene.voxels, progress);
+        }
+        progress = 0.8f;
 
-        } else if (element.key() == "palette") {
+        for (const auto& element : parsed.items()) {
+            if (element.key() == "palette") {
+                palette(parsed, scene.palette);
+            } else if (element.key() == "generation") {
+                generation(parsed, scene);
+            }
+        }
+    } catch (const nlohmann::json::exception& e) {
+        spdlog::error("[CBEloader] Invalid file {} : {}", cbeFilePath, e.what());
+        return false;
+    }
+
+    progress = 1.0f;
+    return true;
+}
 
-        } else if (element.key() == "generation") {
-            generation(parsed);
+void CbeLoader::geometry(const nlohmann::json& json, const std::string& directory, bool hasVoxelChunks, VoxelGrid& staged, std::atomic<float>& progress) {
+    const auto& elements = json["geometry"];
+    for (size_t elementIndex = 0; elementIndex < elements.size(); elementIndex++) {
+        const auto& element = elements.at(elementIndex);
+        progress = 0.1f + 0.7f * elementIndex / elements.size();
+
+        if (element.contains("cube")) {
+            const auto& cube = element["cube"];
+            const glm::ivec3 from = glm::ivec3(cube["from"].at(0), cube["from"].at(1), cube["from"].at(2));
+            const glm::ivec3 to = glm::ivec3(cube["to"].at(0), cube["to"].at(1), cube["to"].at(2));
+            const unsigned int paletteIndex = cube["paletteIndex"];
+            for (int x = from.x; x < to.x; x++) {
+                for (int y = from.y; y < to.y; y++) {
+                    for (int z = from.z; z < to.z; z++) {
+                        staged.insert(glm::ivec3(x, y, z), met::null, paletteIndex);
+                    }
+                }
+            }
+        }
+
+        if (element.contains("voxel")) {
+            const auto& voxel = element["voxel"];
+            const glm::ivec3 pos = glm::ivec3(voxel["position"].at(0), voxel["position"].at(1), voxel["position"].at(2));
+            staged.insert(pos, met::null, voxel["paletteIndex"]);
+        }
+
+        // One material index + 1 per byte, 0 for empty cells
+        if (hasVoxelChunks && element.contains("voxelChunk")) {
+            const auto& voxelChunk = element["voxelChunk"];
+            const std::string& uri = voxelChunk["uri"];
+            const unsigned int byteLength = voxelChunk["byteLength"];
+            glm::ivec3 chunkPos = glm::ivec3(0);
+            if (voxelChunk.contains("position"))
+                chunkPos = glm::ivec3(voxelChunk["position"].at(0), voxelChunk["position"].at(1), voxelChunk["position"].at(2));
+
+            std::ifstream binStream((std::filesystem::path(directory) / uri).string(), std::ios::binary);
+            std::vector<unsigned char> cells(VoxelChunk::VOLUME, 0);
+            if (!binStream || byteLength != VoxelChunk::VOLUME || !binStream.read((char*) cells.data(), cells.size())) {
+                spdlog::error("[CBEloader] Cannot load voxel chunk : {}", uri);
+                continue;
+            }
+
+            for (unsigned int i = 0; i < cells.size(); i++) {
+                if (cells.at(i) != 0)
+                    staged.insert(chunkPos * VoxelChunk::SIZE + VoxelChunk::cellOffset(i), met::null, cells.at(i) - 1);
+            }
         }
     }
 }
 
-void CbeLoader::generation(const nlohmann::json& json) {
+void CbeLoader::palette(const nlohmann::json& json, std::vector<cb::perMaterialChange>& palette) {
+    for (const auto& element : json["palette"]) {
+        const auto& color = element["color"];
+        cb::perMaterialChange material;
+        material.albedo = glm::vec3(color.at(0), color.at(1), color.at(2)) / 255.0f;
+        material.emissiveFactor = 0.0f;
+        palette.push_back(material);
+    }
+}
+
+void CbeLoader::generation(const nlohmann::json& json, StagingScene& scene) {
     const std::string& type = json["generation"].at(0)["type"];
     const std::string& interpolation = json["generation"].at(0)["interpolation"];
     const std::string& mode = json["generation"].at(0)["mode"];
@@ -53,20 +146,5 @@ void CbeLoader::generation(const nlohmann::json& json) {
         controlPointsXYZ.at(i) = pos;
     }
 
-    // Get entities
-    std::vector<glm::ivec3> coordWithYtoFind;
-    std::vector<met::entity> entityToChange;
-    m_ctx.registry.view<comp::Transform>().each([&](met::entity id, comp::Transform& transform){
-        coordWithYtoFind.push_back(transform.position);
-        entityToChange.push_back(id);
-    });
-
-    m_ctx.history.pushHistory(new RBFHistory(m_ctx.registry, coordWithYtoFind));
-    voxmt::rbfInterpolate(coordWithYtoFind, controlPointsXYZ, controlPointWeights, voxmt::RBFType::LINEAR, 0.5f, voxmt::RBFTransformAxis::Y);
-
-    // Changes entities
-    for (size_t i = 0; i < coordWithYtoFind.size(); i++) {
-        comp::Transform& trans =  m_ctx.registry.get<comp::Transform>(entityToChange.at(i));
-        trans.position = coordWithYtoFind.at(i);
-    }
-}
\ No newline at end of file
+    generateRbf(scene, controlPointsXYZ, controlPointWeights);
+}
@@ -1,23 +1,32 @@
 #pragma once
 
+#include <atomic>
+#include <string>
 #include <nlohmann/json.hpp>
-#include "context.h"
+
+#include "scene/staging-scene.h"
 
 class CbeLoader {
 public:
-    CbeLoader(Context& ctx);
+    CbeLoader();
     ~CbeLoader();
 
     /**
-     * @brief Empty scene and add fill it with .cbe file data
+     * @brief Fill the staging scene with .cbe file data. Does not use the context so it can run on another thread.
+     * @note The voxels of the staging scene are kept if the file does not have geometry
      * 
      * @param cbeFilePath 
+     * @param scene - Filled with the current voxels by the caller
+     * @param progress - Goes from 0 to 1 while loading
+     * @return false if the file cannot be read
      */
-    void loadFile(const char* cbeFilePath);
-
-private:
-    void generation(const nlohmann::json& json);
+    bool loadFile(const char* cbeFilePath, StagingScene& scene, std::atomic<float>& progress);
 
 private:
-    Context& m_ctx;
+    /**
+     * @param hasVoxelChunks - False for the files older than the chunk files, which are then ignored
+     */
+    void geometry(const nlohmann::json& json, const std::string& directory, bool hasVoxelChunks, VoxelGrid& staged, std::atomic<float>& progress);
+    void palette(const nlohmann::json& json, std::vector<cb::perMaterialChange>& palette);
+    void generation(const nlohmann::json& json, StagingScene& scene);
 };
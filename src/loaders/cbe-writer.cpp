@@ -0,0 +1,102 @@
+#include "cbe-writer.h"
+
+#include <spdlog/spdlog.h>
+#include <profiling/instrumentor.h>
+#include <nlohmann/json.hpp>
+#include <filesystem>
+#include <fstream>
+#include <unordered_set>
+
+CbeWriter::CbeWriter(const std::string& cbeFilePath) : m_filePath(cbeFilePath) {}
+
+CbeWriter::~CbeWriter() {}
+
+bool CbeWriter::writeFile(const VoxelGrid::Snapshot& chunks, const std::vector<cb::perMaterialChange>& palette) {
+    PROFILE_SCOPE("CbeWriter writeFile");
+    const std::filesystem::path directory = std::filesystem::path(m_filePath).parent_path();
+    if (!directory.empty()) {
+        std::error_code error;
+        std::filesystem::create_directories(directory, error);
+        if (error) {
+            spdlog::error("[CbeWriter] Cannot create directory : {}", directory.string());
+            return false;
+        }
+    }
+
+    nlohmann::json json;
+    json["software"] = "cube-beast-editor";
+    json["version"] = "0.5.0";
+    json["geometry"] = nlohmann::json::array();
+    json["palette"] = nlohmann::json::array();
+
+    // Chunk files
+    std::unordered_set<std::uint64_t> writtenKeys;
+    bool isWritten = true;
+    std::vector<unsigned char> cells(VoxelChunk::VOLUME);
+    for (const auto& chunk : chunks) {
+        const std::string fileName = chunkFileName(chunk->position);
+        const std::uint64_t key = VoxelGrid::chunkKey(chunk->position);
+        writtenKeys.insert(key);
+
+        nlohmann::json voxelChunk;
+        voxelChunk["position"] = { chunk->position.x, chunk->position.y, chunk->position.z };
+        voxelChunk["byteLength"] = VoxelChunk::VOLUME;
+        voxelChunk["uri"] = fileName;
+        json["geometry"].push_back({ { "voxelChunk", voxelChunk } });
+
+        const auto written = m_writtenChunks.find(key);
+        if (written != m_writtenChunks.end() && written->second.version == chunk->version)
+            continue;
+
+        for (unsigned int i = 0; i < VoxelChunk::VOLUME; i++) {
+            cells.at(i) = chunk->has(i) ? chunk->materials[i] + 1 : 0;
+        }
+
+        std::ofstream binStream(directory / fileName, std::ios::binary | std::ios::trunc);
+        if (!binStream.write((const char*) cells.data(), cells.size())) {
+            spdlog::error("[CbeWriter] Cannot write file : {}", fileName);
+            isWritten = false;
+            continue;
+        }
+        m_writtenChunks[key] = { chunk->position, chunk->version };
+    }
+
+    // Remove the chunks which are now empty
+    for (auto it = m_writtenChunks.begin(); it != m_writtenChunks.end();) {
+        if (writtenKeys.find(it->first) == writtenKeys.end()) {
+            std::error_code error;
+            std::filesystem::remove(directory / chunkFileName(it->second.position), error);
+            it = m_writtenChunks.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    for (const cb::perMaterialChange& material : palette) {
+        const glm::ivec3 color = glm::ivec3(glm::round(material.albedo * 255.0f));
+        json["palette"].push_back({ { "color", { color.r, color.g, color.b } } });
+    }
+
+    // Written aside first so that a crash does not leave a partial file
+    const std::string tempPath = m_filePath + ".tmp";
+    {
+        std::ofstream fileStream(tempPath, std::ios::trunc);
+        if (!fileStream) {
+            spdlog::error("[CbeWriter] Cannot write file : {}", m_filePath);
+            return false;
+        }
+        fileStream << json.dump(4);
+    }
+    std::error_code error;
+    std::filesystem::rename(tempPath, m_filePath, error);
+    if (error) {
+        spdlog::error("[CbeWriter] Cannot write file : {}", m_filePath);
+        return false;
+    }
+    return isWritten;
+}
+
+std::string CbeWriter::chunkFileName(const glm::ivec3& chunkPos) const {
+    const std::string stem = std::filesystem::path(m_filePath).stem().string();
+    return stem + "_" + std::to_string(chunkPos.x) + "_" + std::to_string(chunkPos.y) + "_" + std::to_string(chunkPos.z) + ".bin";
+}
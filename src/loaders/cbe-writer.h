@@ -0,0 +1,40 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+
+#include "scomponents/scene/voxel-grid.h"
+#include "graphics/constant-buffer.h"
+
+/**
+ * @brief Save a scene as a .cbe file, with one .bin file per chunk of the voxel grid next to it
+ * @note Does not use the context so it can run on another thread than the one doing the edits.
+ */
+class CbeWriter {
+public:
+    CbeWriter(const std::string& cbeFilePath);
+    ~CbeWriter();
+
+    /**
+     * @brief Write the scene. The chunks which kept the same version since the previous call are not written again.
+     * 
+     * @param chunks - Snapshot of the voxel grid
+     * @param palette - Materials used by the voxels
+     * @return false if the .cbe file or one of the chunk files cannot be written
+     */
+    bool writeFile(const VoxelGrid::Snapshot& chunks, const std::vector<cb::perMaterialChange>& palette);
+
+private:
+    std::string chunkFileName(const glm::ivec3& chunkPos) const;
+
+private:
+    struct WrittenChunk {
+        glm::ivec3 position;
+        unsigned int version;
+    };
+
+    std::string m_filePath;
+    std::unordered_map<std::uint64_t, WrittenChunk> m_writtenChunks;
+};
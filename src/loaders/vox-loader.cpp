@@ -0,0 +1,348 @@
+#include "vox-loader.h"
+
+#include <spdlog/spdlog.h>
+#include <profiling/instrumentor.h>
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <sstream>
+#include <string>
+
+namespace {
+    /**
+     * @brief Little endian cursor over the file content, throws when reading out of bound
+     */
+    class VoxReader {
+    public:
+        VoxReader(const std::vector<char>& data) : m_data(data), m_offset(0) {}
+
+        size_t offset() const { return m_offset; }
+        bool hasData() const { return m_offset < m_data.size(); }
+
+        void seek(size_t offset) {
+            if (offset > m_data.size())
+                throw std::out_of_range("Chunk goes past the end of the file");
+            m_offset = offset;
+        }
+
+        const char* read(size_t byteWidth) {
+            if (m_offset + byteWidth > m_data.size())
+                throw std::out_of_range("Unexpected end of file");
+            const char* data = m_data.data() + m_offset;
+            m_offset += byteWidth;
+            return data;
+        }
+
+        std::int32_t readInt() {
+            std::uint32_t value = 0;
+            const unsigned char* bytes = reinterpret_cast<const unsigned char*>(read(4));
+            for (int i = 3; i >= 0; i--) {
+                value = (value << 8) | bytes[i];
+            }
+            return static_cast<std::int32_t>(value);
+        }
+
+        std::string readString() {
+            const std::int32_t length = readInt();
+            if (length < 0)
+                throw std::out_of_range("Negative string length");
+            return std::string(read(length), length);
+        }
+
+        std::unordered_map<std::string, std::string> readDict() {
+            std::unordered_map<std::string, std::string> dict;
+            const std::int32_t count = readInt();
+            for (std::int32_t i = 0; i < count; i++) {
+                std::string key = readString();
+                dict[key] = readString();
+            }
+            return dict;
+        }
+
+    private:
+        const std::vector<char>& m_data;
+        size_t m_offset;
+    };
+
+    /**
+     * @brief Colors used by MagicaVoxel for the files without RGBA chunk, as 0xAABBGGRR by color index
+     */
+    const std::array<std::uint32_t, 256> DEFAULT_PALETTE = {
+        0x00000000, 0xffffffff, 0xffccffff, 0xff99ffff, 0xff66ffff, 0xff33ffff, 0xff00ffff, 0xffffccff,
+        0xffccccff, 0xff99ccff, 0xff66ccff, 0xff33ccff, 0xff00ccff, 0xffff99ff, 0xffcc99ff, 0xff9999ff,
+        0xff6699ff, 0xff3399ff, 0xff0099ff, 0xffff66ff, 0xffcc66ff, 0xff9966ff, 0xff6666ff, 0xff3366ff,
+        0xff0066ff, 0xffff33ff, 0xffcc33ff, 0xff9933ff, 0xff6633ff, 0xff3333ff, 0xff0033ff, 0xffff00ff,
+        0xffcc00ff, 0xff9900ff, 0xff6600ff, 0xff3300ff, 0xff0000ff, 0xffffffcc, 0xffccffcc, 0xff99ffcc,
+        0xff66ffcc, 0xff33ffcc, 0xff00ffcc, 0xffffcccc, 0xffcccccc, 0xff99cccc, 0xff66cccc, 0xff33cccc,
+        0xff00cccc, 0xffff99cc, 0xffcc99cc, 0xff9999cc, 0xff6699cc, 0xff3399cc, 0xff0099cc, 0xffff66cc,
+        0xffcc66cc, 0xff9966cc, 0xff6666cc, 0xff3366cc, 0xff0066cc, 0xffff33cc, 0xffcc33cc, 0xff9933cc,
+        0xff6633cc, 0xff3333cc, 0xff0033cc, 0xffff00cc, 0xffcc00cc, 0xff9900cc, 0xff6600cc, 0xff3300cc,
+        0xff0000cc, 0xffffff99, 0xffccff99, 0xff99ff99, 0xff66ff99, 0xff33ff99, 0xff00ff99, 0xffffcc99,
+        0xffcccc99, 0xff99cc99, 0xff66cc99, 0xff33cc99, 0xff00cc99, 0xffff9999, 0xffcc9999, 0xff999999,
+        0xff669999, 0xff339999, 0xff009999, 0xffff6699, 0xffcc6699, 0xff996699, 0xff666699, 0xff336699,
+        0xff006699, 0xffff3399, 0xffcc3399, 0xff993399, 0xff663399, 0xff333399, 0xff003399, 0xffff0099,
+        0xffcc0099, 0xff990099, 0xff660099, 0xff330099, 0xff000099, 0xffffff66, 0xffccff66, 0xff99ff66,
+        0xff66ff66, 0xff33ff66, 0xff00ff66, 0xffffcc66, 0xffcccc66, 0xff99cc66, 0xff66cc66, 0xff33cc66,
+        0xff00cc66, 0xffff9966, 0xffcc9966, 0xff999966, 0xff669966, 0xff339966, 0xff009966, 0xffff6666,
+        0xffcc6666, 0xff996666, 0xff666666, 0xff336666, 0xff006666, 0xffff3366, 0xffcc3366, 0xff993366,
+        0xff663366, 0xff333366, 0xff003366, 0xffff0066, 0xffcc0066, 0xff990066, 0xff660066, 0xff330066,
+        0xff000066, 0xffffff33, 0xffccff33, 0xff99ff33, 0xff66ff33, 0xff33ff33, 0xff00ff33, 0xffffcc33,
+        0xffcccc33, 0xff99cc33, 0xff66cc33, 0xff33cc33, 0xff00cc33, 0xffff9933, 0xffcc9933, 0xff999933,
+        0xff669933, 0xff339933, 0xff009933, 0xffff6633, 0xffcc6633, 0xff996633, 0xff666633, 0xff336633,
+        0xff006633, 0xffff3333, 0xffcc3333, 0xff993333, 0xff663333, 0xff333333, 0xff003333, 0xffff0033,
+        0xffcc0033, 0xff990033, 0xff660033, 0xff330033, 0xff000033, 0xffffff00, 0xffccff00, 0xff99ff00,
+        0xff66ff00, 0xff33ff00, 0xff00ff00, 0xffffcc00, 0xffcccc00, 0xff99cc00, 0xff66cc00, 0xff33cc00,
+        0xff00cc00, 0xffff9900, 0xffcc9900, 0xff999900, 0xff669900, 0xff339900, 0xff009900, 0xffff6600,
+        0xffcc6600, 0xff996600, 0xff666600, 0xff336600, 0xff006600, 0xffff3300, 0xffcc3300, 0xff993300,
+        0xff663300, 0xff333300, 0xff003300, 0xffff0000, 0xffcc0000, 0xff990000, 0xff660000, 0xff330000,
+        0xff0000ee, 0xff0000dd, 0xff0000bb, 0xff0000aa, 0xff000088, 0xff000077, 0xff000055, 0xff000044,
+        0xff000022, 0xff000011, 0xff00ee00, 0xff00dd00, 0xff00bb00, 0xff00aa00, 0xff008800, 0xff007700,
+        0xff005500, 0xff004400, 0xff002200, 0xff001100, 0xffee0000, 0xffdd0000, 0xffbb0000, 0xffaa0000,
+        0xff880000, 0xff770000, 0xff550000, 0xff440000, 0xff220000, 0xff110000, 0xffeeeeee, 0xffdddddd,
+        0xffbbbbbb, 0xffaaaaaa, 0xff888888, 0xff777777, 0xff555555, 0xff444444, 0xff222222, 0xff111111
+    };
+
+    glm::ivec3 voxToEditorAxes(const glm::ivec3& pos) {
+        return glm::ivec3(pos.x, pos.z, pos.y);
+    }
+
+    glm::vec3 colorToVec3(std::uint32_t color) {
+        return glm::vec3(color & 0xFF, (color >> 8) & 0xFF, (color >> 16) & 0xFF) / 255.0f;
+    }
+}
+
+VoxLoader::VoxLoader(unsigned int paletteCapacity) : m_paletteCapacity(paletteCapacity) {}
+
+VoxLoader::~VoxLoader() {}
+
+bool VoxLoader::loadFile(const char* voxFilePath, StagingScene& scene, std::atomic<float>& progress) {
+    PROFILE_SCOPE("VoxLoader loadFile");
+    progress = 0.0f;
+    std::ifstream fileStream(voxFilePath, std::ios::binary | std::ios::ate);
+    if (!fileStream) {
+        spdlog::error("[VoxLoader] Cannot load file : {}", voxFilePath);
+        return false;
+    }
+
+    // Read at once, chunks are then parsed from memory
+    std::vector<char> data(static_cast<size_t>(fileStream.tellg()));
+    fileStream.seekg(0);
+    fileStream.read(data.data(), data.size());
+    fileStream.close();
+
+    m_models.clear();
+    m_nodes.clear();
+    m_colorToMaterial.fill(0);
+    m_palette = DEFAULT_PALETTE;
+
+    try {
+        VoxReader reader(data);
+        if (std::strncmp(reader.read(4), "VOX ", 4) != 0)
+            throw std::runtime_error("Not a .vox file");
+        reader.readInt(); // Version
+
+        if (std::strncmp(reader.read(4), "MAIN", 4) != 0)
+            throw std::runtime_error("Missing MAIN chunk");
+        const std::int32_t mainContentSize = reader.readInt();
+        const std::int32_t mainChildrenSize = reader.readInt();
+        if (mainContentSize < 0 || mainChildrenSize < 0)
+            throw std::runtime_error("Negative MAIN chunk size");
+        reader.seek(reader.offset() + mainContentSize);
+        const size_t mainEnd = reader.offset() + mainChildrenSize;
+        if (mainEnd > data.size())
+            throw std::runtime_error("MAIN chunk goes past the end of the file");
+
+        while (reader.offset() < mainEnd) {
+            const size_t chunkStart = reader.offset();
+            const std::string id(reader.read(4), 4);
+            const std::int32_t contentSize = reader.readInt();
+            const std::int32_t childrenSize = reader.readInt();
+            if (contentSize < 0 || childrenSize < 0)
+                throw std::runtime_error("Negative size of " + id + " chunk");
+
+            // Each chunk must move the reader forward, or a malformed file would be read forever
+            const size_t chunkEnd = reader.offset() + static_cast<size_t>(contentSize) + static_cast<size_t>(childrenSize);
+            if (chunkEnd <= chunkStart || chunkEnd > mainEnd)
+                throw std::runtime_error(id + " chunk goes past the end of the MAIN chunk");
+
+            if (id == "SIZE") {
+                Model model;
+                model.size.x = reader.readInt();
+                model.size.y = reader.readInt();
+                model.size.z = reader.readInt();
+                m_models.push_back(std::move(model));
+
+            } else if (id == "XYZI") {
+                if (m_models.empty())
+                    throw std::runtime_error("XYZI chunk without SIZE chunk");
+                const std::int32_t count = reader.readInt();
+                if (count < 0)
+                    throw std::runtime_error("Negative voxel count");
+                const char* xyzi = reader.read(static_cast<size_t>(count) * 4);
+                m_models.back().xyzi.assign(xyzi, xyzi + static_cast<size_t>(count) * 4);
+
+            } else if (id == "RGBA") {
+                // Color i of the chunk is used by the color index i + 1
+                for (unsigned int i = 0; i < 255; i++) {
+                    m_palette.at(i + 1) = static_cast<std::uint32_t>(reader.readInt());
+                }
+
+            } else if (id == "nTRN") {
+                const int nodeId = reader.readInt();
+                Node& node = m_nodes[nodeId];
+                node.type = Node::Type::TRANSFORM;
+                reader.readDict();
+                node.children.push_back(reader.readInt());
+                reader.readInt(); // Reserved
+                reader.readInt(); // Layer
+                const std::int32_t frameCount = reader.readInt();
+                for (std::int32_t i = 0; i < frameCount; i++) {
+                    const auto frame = reader.readDict();
+                    const auto translation = frame.find("_t");
+                    if (i == 0 && translation != frame.end()) {
+                        std::istringstream values(translation->second);
+                        values >> node.translation.x >> node.translation.y >> node.translation.z;
+                    }
+                }
+
+            } else if (id == "nGRP") {
+                const int nodeId = reader.readInt();
+                Node& node = m_nodes[nodeId];
+                node.type = Node::Type::GROUP;
+                reader.readDict();
+                const std::int32_t childCount = reader.readInt();
+                for (std::int32_t i = 0; i < childCount; i++) {
+                    node.children.push_back(reader.readInt());
+                }
+
+            } else if (id == "nSHP") {
+                const int nodeId = reader.readInt();
+                Node& node = m_nodes[nodeId];
+                node.type = Node::Type::SHAPE;
+                reader.readDict();
+                const std::int32_t modelCount = reader.readInt();
+                for (std::int32_t i = 0; i < modelCount; i++) {
+                    node.children.push_back(reader.readInt());
+                    reader.readDict();
+                }
+            }
+
+            reader.seek(chunkEnd);
+            progress = 0.5f * reader.offset() / data.size();
+        }
+
+        // Voxels
+        size_t voxelCount = 0;
+        for (const Model& model : m_models) {
+            voxelCount += model.xyzi.size() / 4;
+        }
+        scene.voxels.clear();
+        scene.palette.clear();
+        remapPalette(scene);
+        progress = 0.6f;
+
+        if (m_nodes.find(0) != m_nodes.end()) {
+            placeNode(0, glm::ivec3(0), 0, scene);
+        } else {
+            // Files without scene graph have their models at the origin
+            for (const Model& model : m_models) {
+                placeModel(model, model.size / 2, scene);
+            }
+        }
+
+        if (scene.voxels.size() < voxelCount)
+            spdlog::warn("[VoxLoader] {} voxels were overlapping and have been merged", voxelCount - scene.voxels.size());
+
+    } catch (const std::exception& e) {
+        spdlog::error("[VoxLoader] Invalid file {} : {}", voxFilePath, e.what());
+        return false;
+    }
+
+    progress = 1.0f;
+    return true;
+}
+
+void VoxLoader::placeNode(int nodeId, const glm::ivec3& translation, unsigned int depth, StagingScene& scene) {
+    const auto node = m_nodes.find(nodeId);
+    if (node == m_nodes.end())
+        throw std::runtime_error("Unknown node " + std::to_string(nodeId));
+    if (depth > 64)
+        throw std::runtime_error("Scene graph is too deep or has a cycle");
+
+    switch (node->second.type) {
+    case Node::Type::TRANSFORM:
+    case Node::Type::GROUP:
+        for (int childId : node->second.children) {
+            placeNode(childId, translation + node->second.translation, depth + 1, scene);
+        }
+        break;
+
+    case Node::Type::SHAPE:
+        for (int modelId : node->second.children) {
+            if (modelId < 0 || modelId >= static_cast<int>(m_models.size()))
+                throw std::runtime_error("Unknown model " + std::to_string(modelId));
+            placeModel(m_models.at(modelId), translation, scene);
+        }
+        break;
+
+    default: break;
+    }
+}
+
+void VoxLoader::placeModel(const Model& model, const glm::ivec3& translation, StagingScene& scene) {
+    // Models are centered on their translation
+    const glm::ivec3 origin = translation - model.size / 2;
+    const unsigned char* xyzi = model.xyzi.data();
+    for (size_t i = 0; i < model.xyzi.size(); i += 4) {
+        const glm::ivec3 pos = voxToEditorAxes(origin + glm::ivec3(xyzi[i], xyzi[i + 1], xyzi[i + 2]));
+        if (!scene.voxels.has(pos))
+            scene.voxels.insert(pos, met::null, m_colorToMaterial.at(xyzi[i + 3]));
+    }
+}
+
+void VoxLoader::remapPalette(StagingScene& scene) {
+    std::array<size_t, 256> usage;
+    usage.fill(0);
+    for (const Model& model : m_models) {
+        for (size_t i = 3; i < model.xyzi.size(); i += 4) {
+            usage.at(static_cast<unsigned char>(model.xyzi.at(i)))++;
+        }
+    }
+
+    // Most used colors are kept
+    std::vector<unsigned int> colorIndices;
+    for (unsigned int i = 0; i < usage.size(); i++) {
+        if (usage.at(i) > 0)
+            colorIndices.push_back(i);
+    }
+    std::stable_sort(colorIndices.begin(), colorIndices.end(), [&](unsigned int a, unsigned int b) {
+        return usage.at(a) > usage.at(b);
+    });
+    if (colorIndices.size() > m_paletteCapacity)
+        colorIndices.resize(m_paletteCapacity);
+
+    for (unsigned int colorIndex : colorIndices) {
+        m_colorToMaterial.at(colorIndex) = static_cast<unsigned int>(scene.palette.size());
+        scene.palette.push_back({ colorToVec3(m_palette.at(colorIndex)), 0.0f });
+    }
+
+    // Others use the closest kept color
+    for (unsigned int i = 0; i < usage.size(); i++) {
+        if (usage.at(i) == 0 || std::find(colorIndices.begin(), colorIndices.end(), i) != colorIndices.end())
+            continue;
+
+        const glm::vec3 color = colorToVec3(m_palette.at(i));
+        float minDistance = std::numeric_limits<float>::max();
+        for (unsigned int material = 0; material < scene.palette.size(); material++) {
+            const glm::vec3 delta = scene.palette.at(material).albedo - color;
+            const float distance = glm::dot(delta, delta);
+            if (distance < minDistance) {
+                minDistance = distance;
+                m_colorToMaterial.at(i) = material;
+            }
+        }
+    }
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <atomic>
+#include <array>
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+#include <glm/glm.hpp>
+
+#include "scene/staging-scene.h"
+
+/**
+ * @brief Read MagicaVoxel .vox files
+ * @link https://github.com/ephtracy/voxel-model/blob/master/MagicaVoxel-file-format-vox.txt
+ */
+class VoxLoader {
+public:
+    /**
+     * @param paletteCapacity - Maximum number of materials. The least used colors are replaced by the closest kept one.
+     */
+    VoxLoader(unsigned int paletteCapacity = 255);
+    ~VoxLoader();
+
+    /**
+     * @brief Replace the voxels of the staging scene with the models of the .vox file. Does not use the context so it can run on another thread.
+     * @note The z axis of MagicaVoxel is the y axis of the editor. Node rotations are not supported.
+     * 
+     * @param voxFilePath 
+     * @param scene 
+     * @param progress - Goes from 0 to 1 while loading
+     * @return false if the file cannot be read
+     */
+    bool loadFile(const char* voxFilePath, StagingScene& scene, std::atomic<float>& progress);
+
+private:
+    struct Model {
+        glm::ivec3 size;
+        std::vector<unsigned char> xyzi; // 4 bytes per voxel
+    };
+
+    struct Node {
+        enum class Type { TRANSFORM, GROUP, SHAPE };
+        Type type;
+        glm::ivec3 translation = glm::ivec3(0);
+        std::vector<int> children; // Model ids for shapes
+    };
+
+    void placeNode(int nodeId, const glm::ivec3& translation, unsigned int depth, StagingScene& scene);
+    void placeModel(const Model& model, const glm::ivec3& translation, StagingScene& scene);
+    void remapPalette(StagingScene& scene);
+
+private:
+    unsigned int m_paletteCapacity;
+    std::vector<Model> m_models;
+    std::unordered_map<int, Node> m_nodes;
+    std::array<std::uint32_t, 256> m_palette;
+    std::array<unsigned int, 256> m_colorToMaterial;
+};
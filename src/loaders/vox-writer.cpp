@@ -0,0 +1,173 @@
+#include "vox-writer.h"
+
+#include <spdlog/spdlog.h>
+#include <fstream>
+#include <map>
+#include <string>
+#include <tuple>
+#include <cstdint>
+#include <limits>
+
+namespace {
+    const int modelSizeShift = 8; // MagicaVoxel models are up to 256 voxels wide
+
+    void appendInt(std::vector<char>& out, std::int32_t value) {
+        const std::uint32_t bits = static_cast<std::uint32_t>(value);
+        for (int i = 0; i < 4; i++) {
+            out.push_back(static_cast<char>((bits >> (8 * i)) & 0xFF));
+        }
+    }
+
+    void appendString(std::vector<char>& out, const std::string& value) {
+        appendInt(out, static_cast<std::int32_t>(value.size()));
+        out.insert(out.end(), value.begin(), value.end());
+    }
+
+    void appendChunk(std::vector<char>& out, const char* id, const std::vector<char>& content) {
+        out.insert(out.end(), id, id + 4);
+        appendInt(out, static_cast<std::int32_t>(content.size()));
+        appendInt(out, 0);
+        out.insert(out.end(), content.begin(), content.end());
+    }
+
+    glm::ivec3 editorToVoxAxes(const glm::ivec3& pos) {
+        return glm::ivec3(pos.x, pos.z, pos.y);
+    }
+
+    /**
+     * @brief Voxels of a model, in MagicaVoxel axes
+     */
+    struct Model {
+        glm::ivec3 min = glm::ivec3(std::numeric_limits<int>::max());
+        glm::ivec3 max = glm::ivec3(std::numeric_limits<int>::min());
+        std::vector<std::shared_ptr<const VoxelChunk>> chunks;
+    };
+}
+
+VoxWriter::VoxWriter() {}
+
+VoxWriter::~VoxWriter() {}
+
+bool VoxWriter::writeFile(const char* voxFilePath, const VoxelGrid::Snapshot& chunks, const std::vector<cb::perMaterialChange>& palette) {
+    // Chunks are grouped by blocks of the maximum model size
+    std::map<std::tuple<int, int, int>, Model> models;
+    for (const auto& chunk : chunks) {
+        const glm::ivec3 block = editorToVoxAxes(chunk->position >> (modelSizeShift - VoxelChunk::SIZE_SHIFT));
+        Model& model = models[std::make_tuple(block.x, block.y, block.z)];
+        model.chunks.push_back(chunk);
+
+        for (unsigned int i = 0; i < VoxelChunk::VOLUME; i++) {
+            if (chunk->has(i)) {
+                const glm::ivec3 pos = editorToVoxAxes(chunk->cellPosition(i));
+                model.min = glm::min(model.min, pos);
+                model.max = glm::max(model.max, pos);
+            }
+        }
+    }
+
+    std::vector<char> children;
+    std::vector<char> content;
+    std::vector<glm::ivec3> translations;
+    for (const auto& element : models) {
+        const Model& model = element.second;
+        const glm::ivec3 size = model.max - model.min + 1;
+
+        content.clear();
+        appendInt(content, size.x);
+        appendInt(content, size.y);
+        appendInt(content, size.z);
+        appendChunk(children, "SIZE", content);
+
+        content.clear();
+        appendInt(content, 0); // Voxel count, set once known
+        std::int32_t count = 0;
+        for (const auto& chunk : model.chunks) {
+            for (unsigned int i = 0; i < VoxelChunk::VOLUME; i++) {
+                if (chunk->has(i)) {
+                    const glm::ivec3 pos = editorToVoxAxes(chunk->cellPosition(i)) - model.min;
+                    content.push_back(static_cast<char>(pos.x));
+                    content.push_back(static_cast<char>(pos.y));
+                    content.push_back(static_cast<char>(pos.z));
+                    content.push_back(static_cast<char>(chunk->materials[i] + 1));
+                    count++;
+                }
+            }
+        }
+        std::vector<char> countBytes;
+        appendInt(countBytes, count);
+        std::copy(countBytes.begin(), countBytes.end(), content.begin());
+        appendChunk(children, "XYZI", content);
+
+        // Models are centered on their translation
+        translations.push_back(model.min + size / 2);
+    }
+
+    // Scene graph : root transform -> group -> one transform and shape per model
+    content.clear();
+    appendInt(content, 0);
+    appendInt(content, 0);
+    appendInt(content, 1);
+    appendInt(content, -1);
+    appendInt(content, -1);
+    appendInt(content, 1);
+    appendInt(content, 0);
+    appendChunk(children, "nTRN", content);
+
+    content.clear();
+    appendInt(content, 1);
+    appendInt(content, 0);
+    appendInt(content, static_cast<std::int32_t>(translations.size()));
+    for (size_t i = 0; i < translations.size(); i++) {
+        appendInt(content, static_cast<std::int32_t>(2 + 2 * i));
+    }
+    appendChunk(children, "nGRP", content);
+
+    for (size_t i = 0; i < translations.size(); i++) {
+        const glm::ivec3& t = translations.at(i);
+        content.clear();
+        appendInt(content, static_cast<std::int32_t>(2 + 2 * i));
+        appendInt(content, 0);
+        appendInt(content, static_cast<std::int32_t>(3 + 2 * i));
+        appendInt(content, -1);
+        appendInt(content, 0);
+        appendInt(content, 1);
+        appendInt(content, 1);
+        appendString(content, "_t");
+        appendString(content, std::to_string(t.x) + " " + std::to_string(t.y) + " " + std::to_string(t.z));
+        appendChunk(children, "nTRN", content);
+
+        content.clear();
+        appendInt(content, static_cast<std::int32_t>(3 + 2 * i));
+        appendInt(content, 0);
+        appendInt(content, 1);
+        appendInt(content, static_cast<std::int32_t>(i));
+        appendInt(content, 0);
+        appendChunk(children, "nSHP", content);
+    }
+
+    // Color i of the chunk is used by the color index i + 1
+    content.clear();
+    for (unsigned int i = 0; i < 256; i++) {
+        std::uint32_t color = 0;
+        if (i < palette.size()) {
+            const glm::ivec3 rgb = glm::ivec3(glm::round(glm::clamp(palette.at(i).albedo, 0.0f, 1.0f) * 255.0f));
+            color = 0xFF000000 | (rgb.b << 16) | (rgb.g << 8) | rgb.r;
+        }
+        appendInt(content, static_cast<std::int32_t>(color));
+    }
+    appendChunk(children, "RGBA", content);
+
+    std::vector<char> file = { 'V', 'O', 'X', ' ' };
+    appendInt(file, 150);
+    file.insert(file.end(), { 'M', 'A', 'I', 'N' });
+    appendInt(file, 0);
+    appendInt(file, static_cast<std::int32_t>(children.size()));
+    file.insert(file.end(), children.begin(), children.end());
+
+    std::ofstream fileStream(voxFilePath, std::ios::binary | std::ios::trunc);
+    if (!fileStream || !fileStream.write(file.data(), file.size())) {
+        spdlog::error("[VoxWriter] Cannot write file : {}", voxFilePath);
+        return false;
+    }
+    return true;
+}
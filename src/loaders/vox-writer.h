@@ -0,0 +1,26 @@
+#pragma once
+
+#include <vector>
+
+#include "scomponents/scene/voxel-grid.h"
+#include "graphics/constant-buffer.h"
+
+/**
+ * @brief Write MagicaVoxel .vox files
+ * @note Scenes larger than 256 voxels on an axis are split into several models.
+ */
+class VoxWriter {
+public:
+    VoxWriter();
+    ~VoxWriter();
+
+    /**
+     * @brief Does not use the context so it can run on another thread
+     * 
+     * @param voxFilePath 
+     * @param chunks - Snapshot of the voxel grid
+     * @param palette - Materials used by the voxels, up to 255
+     * @return false if the file cannot be written
+     */
+    bool writeFile(const char* voxFilePath, const VoxelGrid::Snapshot& chunks, const std::vector<cb::perMaterialChange>& palette);
+};
@@ -1,3 +1,5 @@
+#include <string>
+
 #include "app.h"
 #ifdef __EMSCRIPTEN__
 	#include <emscripten.h>
@@ -8,6 +10,7 @@
 #endif
 
 void mainLoop(void* arg);
+AppOptions parseOptions(int argc, char *argv[]);
 
 struct MainLoopArg {
 	App* app;
@@ -18,7 +21,7 @@ int main(int argc, char *argv[]) {
 		_CrtSetDbgFlag(_CRTDBG_ALLOC_MEM_DF | _CRTDBG_LEAK_CHECK_DF);
 	#endif
 
-	App app;
+	App app(parseOptions(argc, argv));
 	MainLoopArg arg = {};
 	arg.app = &app;
 
@@ -38,3 +41,20 @@ void mainLoop(void* arg) {
 	// TODO handle deltatime and sleep
 	args->app->update();
 }
+
+AppOptions parseOptions(int argc, char *argv[]) {
+	AppOptions options;
+	for (int i = 1; i < argc; i++) {
+		const std::string arg = argv[i];
+		const bool hasValue = i + 1 < argc;
+		if (arg == "--record" && hasValue)
+			options.recordPath = argv[++i];
+		else if (arg == "--replay" && hasValue)
+			options.replayPath = argv[++i];
+		else if (arg == "--timings" && hasValue)
+			options.timingsPath = argv[++i];
+		else if (arg == "--headless")
+			options.headless = true;
+	}
+	return options;
+}
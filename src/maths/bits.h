@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstdint>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace voxmt {
+    /**
+     * @brief Number of bits set in the word
+     */
+    inline unsigned int bitCount(std::uint64_t word) {
+#ifdef _MSC_VER
+        return static_cast<unsigned int>(__popcnt64(word));
+#else
+        return static_cast<unsigned int>(__builtin_popcountll(word));
+#endif
+    }
+
+    /**
+     * @brief Index of the lowest bit set in the word, which must not be zero
+     */
+    inline unsigned int lowestBitIndex(std::uint64_t word) {
+#ifdef _MSC_VER
+        unsigned long index;
+        _BitScanForward64(&index, word);
+        return static_cast<unsigned int>(index);
+#else
+        return static_cast<unsigned int>(__builtin_ctzll(word));
+#endif
+    }
+}
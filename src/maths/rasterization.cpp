@@ -0,0 +1,50 @@
+#include "rasterization.h"
+
+#include <cmath>
+
+namespace voxmt {
+    void rasterizeLine(const glm::ivec3& start, const glm::ivec3& end, std::vector<glm::ivec3>& cells) {
+        const glm::ivec3 delta = glm::abs(end - start);
+        const glm::ivec3 step = glm::sign(end - start);
+
+        // The longest axis moves at each step, the two others when their error is positive
+        int driving = 0;
+        if (delta.y > delta[driving]) { driving = 1; }
+        if (delta.z > delta[driving]) { driving = 2; }
+        const int first = (driving + 1) % 3;
+        const int second = (driving + 2) % 3;
+
+        int firstError = 2 * delta[first] - delta[driving];
+        int secondError = 2 * delta[second] - delta[driving];
+        glm::ivec3 pos = start;
+        cells.reserve(cells.size() + delta[driving] + 1);
+        cells.push_back(pos);
+
+        for (int i = 0; i < delta[driving]; i++) {
+            if (firstError > 0) {
+                pos[first] += step[first];
+                firstError -= 2 * delta[driving];
+            }
+            if (secondError > 0) {
+                pos[second] += step[second];
+                secondError -= 2 * delta[driving];
+            }
+            firstError += 2 * delta[first];
+            secondError += 2 * delta[second];
+            pos[driving] += step[driving];
+            cells.push_back(pos);
+        }
+    }
+
+    int ballRowHalfWidth(int radius, int rowOffset, int layerOffset) {
+        const long long remaining = static_cast<long long>(radius) * (radius + 1) - static_cast<long long>(rowOffset) * rowOffset - static_cast<long long>(layerOffset) * layerOffset;
+        if (radius < 0 || remaining < 0)
+            return -1;
+
+        // The floating point root is corrected, as it can be off by one for large values
+        long long halfWidth = static_cast<long long>(std::sqrt(static_cast<double>(remaining)));
+        while (halfWidth * halfWidth > remaining) { halfWidth--; }
+        while ((halfWidth + 1) * (halfWidth + 1) <= remaining) { halfWidth++; }
+        return static_cast<int>(halfWidth);
+    }
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <vector>
+#include <glm/glm.hpp>
+
+namespace voxmt {
+    /**
+     * @brief Append the cells of a 3D Bresenham segment, from start to end included
+     * @note There is one cell per step on the longest axis, and each one touches the previous one by a face, an edge or a corner.
+     */
+    void rasterizeLine(const glm::ivec3& start, const glm::ivec3& end, std::vector<glm::ivec3>& cells);
+
+    /**
+     * @brief Half width of a row of cells crossing a ball, with the row at the given offsets from the center on the two other axes
+     * @note Cells are inside when their squared distance to the center is at most radius * (radius + 1), which rounds the poles of small balls.
+     * @return -1 if the row does not cross the ball
+     */
+    int ballRowHalfWidth(int radius, int rowOffset, int layerOffset);
+}
@@ -0,0 +1,62 @@
+#include "allocation-counter.h"
+
+#include <cstdlib>
+#include <new>
+
+namespace {
+    thread_local std::uint64_t threadAllocationCount = 0;
+    std::uint64_t frameStartCount = 0;
+    std::uint64_t previousFrameCount = 0;
+}
+
+#ifndef NDEBUG
+void* operator new(std::size_t byteWidth) {
+    threadAllocationCount++;
+    if (void* data = std::malloc(byteWidth == 0 ? 1 : byteWidth))
+        return data;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t byteWidth) {
+    return operator new(byteWidth);
+}
+
+void operator delete(void* data) noexcept {
+    std::free(data);
+}
+
+void operator delete[](void* data) noexcept {
+    std::free(data);
+}
+
+void operator delete(void* data, std::size_t) noexcept {
+    std::free(data);
+}
+
+void operator delete[](void* data, std::size_t) noexcept {
+    std::free(data);
+}
+#endif
+
+namespace allocation {
+    bool isCounted() {
+#ifndef NDEBUG
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    std::uint64_t count() {
+        return threadAllocationCount;
+    }
+
+    void markFrame() {
+        previousFrameCount = threadAllocationCount - frameStartCount;
+        frameStartCount = threadAllocationCount;
+    }
+
+    std::uint64_t lastFrameCount() {
+        return previousFrameCount;
+    }
+}
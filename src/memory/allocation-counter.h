@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cstdint>
+
+/**
+ * @brief Count the calls to operator new made by the main thread, to check that the frames do not allocate
+ * @note Only counted in debug builds. The counts stay at 0 in release.
+ */
+namespace allocation {
+    bool isCounted();
+
+    /**
+     * @brief Allocations made by the calling thread since it started
+     */
+    std::uint64_t count();
+
+    /**
+     * @brief Called by the main thread at the start of each frame
+     */
+    void markFrame();
+
+    /**
+     * @brief Allocations made by the main thread during the previous frame
+     */
+    std::uint64_t lastFrameCount();
+}
@@ -0,0 +1,47 @@
+#include "frame-arena.h"
+
+#include <algorithm>
+#include <cassert>
+
+FrameArena::FrameArena(size_t capacity) 
+    : m_buffer(new std::uint8_t[capacity]), m_capacity(capacity), m_offset(0), m_used(0), m_peak(0) {}
+
+FrameArena::~FrameArena() {}
+
+void* FrameArena::allocate(size_t byteWidth, size_t alignment) {
+    assert((alignment & (alignment - 1)) == 0 && "Alignment must be a power of two");
+
+    const std::uintptr_t base = reinterpret_cast<std::uintptr_t>(m_buffer.get());
+    const size_t alignedOffset = ((base + m_offset + alignment - 1) & ~(alignment - 1)) - base;
+    if (alignedOffset + byteWidth <= m_capacity) {
+        m_used += alignedOffset + byteWidth - m_offset;
+        m_offset = alignedOffset + byteWidth;
+        m_peak = std::max(m_peak, m_used);
+        return m_buffer.get() + alignedOffset;
+    }
+
+    // new[] is aligned for any fundamental type
+    assert(alignment <= alignof(std::max_align_t) && "Over-aligned types are not supported");
+    m_extraBlocks.emplace_back(new std::uint8_t[byteWidth]);
+    m_used += byteWidth;
+    m_peak = std::max(m_peak, m_used);
+    return m_extraBlocks.back().get();
+}
+
+void FrameArena::deallocate(void* data, size_t byteWidth) {
+    std::uint8_t* bytes = static_cast<std::uint8_t*>(data);
+    if (bytes + byteWidth == m_buffer.get() + m_offset) {
+        m_offset -= byteWidth;
+        m_used -= byteWidth;
+    }
+}
+
+void FrameArena::reset() {
+    if (!m_extraBlocks.empty()) {
+        m_extraBlocks.clear();
+        m_capacity = m_peak * 2;
+        m_buffer.reset(new std::uint8_t[m_capacity]);
+    }
+    m_offset = 0;
+    m_used = 0;
+}
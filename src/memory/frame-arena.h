@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/**
+ * @brief Linear allocator for the temporaries of a frame. Everything is freed at once by reset().
+ * @note When a frame needs more than the capacity, extra blocks are taken from the heap and the arena grows on the next reset.
+ */
+class FrameArena {
+public:
+    explicit FrameArena(size_t capacity = 1 << 20);
+    ~FrameArena();
+
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    void* allocate(size_t byteWidth, size_t alignment);
+
+    /**
+     * @brief Only the last allocation is given back, which is enough for a growing vector
+     */
+    void deallocate(void* data, size_t byteWidth);
+
+    /**
+     * @brief Called once per frame, when no temporary is used anymore
+     */
+    void reset();
+
+    size_t used() const { return m_used; }
+    size_t capacity() const { return m_capacity; }
+    size_t peak() const { return m_peak; } // Most bytes used by a frame since the start
+
+private:
+    std::unique_ptr<std::uint8_t[]> m_buffer;
+    size_t m_capacity;
+    size_t m_offset;
+    size_t m_used; // Including the extra blocks
+    size_t m_peak;
+    std::vector<std::unique_ptr<std::uint8_t[]>> m_extraBlocks;
+};
+
+/**
+ * @brief STL allocator using the frame arena, for containers which do not outlive the frame
+ */
+template<typename T>
+class FrameAllocator {
+public:
+    using value_type = T;
+
+    FrameAllocator(FrameArena& arena) noexcept : m_arena(&arena) {}
+
+    template<typename U>
+    FrameAllocator(const FrameAllocator<U>& other) noexcept : m_arena(other.arena()) {}
+
+    T* allocate(size_t count) {
+        return static_cast<T*>(m_arena->allocate(count * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T* data, size_t count) noexcept {
+        m_arena->deallocate(data, count * sizeof(T));
+    }
+
+    FrameArena* arena() const noexcept { return m_arena; }
+
+private:
+    FrameArena* m_arena;
+};
+
+template<typename T, typename U>
+bool operator==(const FrameAllocator<T>& a, const FrameAllocator<U>& b) noexcept { return a.arena() == b.arena(); }
+
+template<typename T, typename U>
+bool operator!=(const FrameAllocator<T>& a, const FrameAllocator<U>& b) noexcept { return a.arena() != b.arena(); }
+
+template<typename T>
+using FrameVector = std::vector<T, FrameAllocator<T>>;
@@ -0,0 +1,198 @@
+#include "input-recording.h"
+
+#include <spdlog/spdlog.h>
+
+namespace {
+    const char MAGIC[4] = { 'B', 'V', 'E', 'I' };
+    const std::uint32_t VERSION = 11;
+    const std::uint32_t MAX_MOUSE_SAMPLES = 1 << 16; // Guards against reading a corrupted count
+    const std::uint32_t MAX_COMMANDS = 1 << 8;
+
+    // Fields are written one by one, so the files do not depend on the padding of the structure
+    template<typename T>
+    void write(std::ofstream& file, const T& value) {
+        file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    template<typename T>
+    void read(std::ifstream& file, T& value) {
+        file.read(reinterpret_cast<char*>(&value), sizeof(T));
+    }
+}
+
+InputRecorder::InputRecorder() {}
+
+InputRecorder::~InputRecorder() {
+    close();
+}
+
+bool InputRecorder::open(const std::string& filePath) {
+    close();
+    m_file.open(filePath, std::ios::binary);
+    if (!m_file) {
+        spdlog::error("[InputRecorder] Cannot write file : {}", filePath);
+        return false;
+    }
+
+    m_file.write(MAGIC, sizeof(MAGIC));
+    write(m_file, VERSION);
+    return true;
+}
+
+void InputRecorder::record(const InputFrame& frame) {
+    if (!isRecording())
+        return;
+
+    write(m_file, frame.mousePos);
+    write(m_file, frame.ndcMousePos);
+    write(m_file, frame.posDelta);
+    write(m_file, static_cast<std::uint32_t>(frame.ndcMouseSamples.size()));
+    for (const glm::vec2& sample : frame.ndcMouseSamples) {
+        write(m_file, sample);
+    }
+    write(m_file, frame.wheelDelta);
+    std::uint8_t actions = 0;
+    for (size_t i = 0; i < frame.actionState.size(); i++) {
+        actions |= frame.actionState.at(i) << i;
+    }
+    write(m_file, actions);
+
+    write(m_file, static_cast<std::uint8_t>(frame.brushType));
+    write(m_file, static_cast<std::uint8_t>(frame.brushUsage));
+    write(m_file, static_cast<std::uint8_t>(frame.brushStarted));
+    write(m_file, static_cast<std::uint8_t>(frame.brushSize));
+    write(m_file, static_cast<std::uint8_t>(frame.brushFlat));
+    write(m_file, static_cast<std::uint8_t>(frame.brushSameMaterial));
+    write(m_file, static_cast<std::uint16_t>(frame.fillLimit));
+    write(m_file, static_cast<std::uint8_t>(frame.selectionMode));
+    write(m_file, static_cast<std::uint8_t>(frame.stampTurns));
+    write(m_file, static_cast<std::uint8_t>(frame.stampMirrored));
+    write(m_file, static_cast<std::uint8_t>(frame.symmetry.x | frame.symmetry.y << 1 | frame.symmetry.z << 2));
+    write(m_file, frame.symmetryCenter);
+    write(m_file, static_cast<std::uint8_t>(frame.filter));
+    write(m_file, static_cast<std::uint8_t>(frame.filterRadius));
+    write(m_file, static_cast<std::uint32_t>(frame.material));
+
+    write(m_file, frame.viewportSize);
+    write(m_file, frame.viewportPosTopLeft);
+    write(m_file, static_cast<std::uint8_t>(frame.viewportHovered));
+
+    write(m_file, static_cast<std::uint32_t>(frame.commands.size()));
+    for (const GuiCommand& command : frame.commands) {
+        write(m_file, static_cast<std::uint8_t>(command.type));
+        write(m_file, command.offset);
+        write(m_file, static_cast<std::int32_t>(command.option));
+    }
+}
+
+void InputRecorder::close() {
+    if (m_file.is_open())
+        m_file.close();
+}
+
+InputReplay::InputReplay() : m_frameIndex(0) {}
+
+InputReplay::~InputReplay() {}
+
+bool InputReplay::open(const std::string& filePath) {
+    m_file.open(filePath, std::ios::binary);
+    m_frameIndex = 0;
+
+    char magic[4];
+    std::uint32_t version = 0;
+    m_file.read(magic, sizeof(magic));
+    read(m_file, version);
+    if (!m_file || std::string(magic, 4) != std::string(MAGIC, 4) || version != VERSION) {
+        spdlog::error("[InputReplay] {} is not an input recording", filePath);
+        m_file.close();
+        return false;
+    }
+    return true;
+}
+
+bool InputReplay::next(InputFrame& frame) {
+    if (!isReplaying())
+        return false;
+
+    read(m_file, frame.mousePos);
+    read(m_file, frame.ndcMousePos);
+    read(m_file, frame.posDelta);
+    std::uint32_t sampleCount = 0;
+    read(m_file, sampleCount);
+    if (!m_file || sampleCount > MAX_MOUSE_SAMPLES) {
+        m_file.close();
+        return false;
+    }
+    frame.ndcMouseSamples.resize(sampleCount);
+    for (glm::vec2& sample : frame.ndcMouseSamples) {
+        read(m_file, sample);
+    }
+    read(m_file, frame.wheelDelta);
+    std::uint8_t actions = 0;
+    read(m_file, actions);
+    for (size_t i = 0; i < frame.actionState.size(); i++) {
+        frame.actionState.at(i) = (actions >> i) & 1;
+    }
+
+    std::uint8_t brushType = 0, brushUsage = 0, brushStarted = 0, brushSize = 0, brushFlat = 0, brushSameMaterial = 0, selectionMode = 0, stampTurns = 0, stampMirrored = 0, symmetry = 0, filter = 0, filterRadius = 0, viewportHovered = 0;
+    std::uint16_t fillLimit = 0;
+    std::uint32_t material = 0;
+    read(m_file, brushType);
+    read(m_file, brushUsage);
+    read(m_file, brushStarted);
+    read(m_file, brushSize);
+    read(m_file, brushFlat);
+    read(m_file, brushSameMaterial);
+    read(m_file, fillLimit);
+    read(m_file, selectionMode);
+    read(m_file, stampTurns);
+    read(m_file, stampMirrored);
+    read(m_file, symmetry);
+    read(m_file, frame.symmetryCenter);
+    read(m_file, filter);
+    read(m_file, filterRadius);
+    read(m_file, material);
+    frame.brushType = static_cast<BrushType>(brushType);
+    frame.brushUsage = static_cast<BrushUse>(brushUsage);
+    frame.brushStarted = brushStarted != 0;
+    frame.brushSize = brushSize;
+    frame.brushFlat = brushFlat != 0;
+    frame.brushSameMaterial = brushSameMaterial != 0;
+    frame.fillLimit = fillLimit;
+    frame.selectionMode = static_cast<SelectionMode>(selectionMode);
+    frame.stampTurns = stampTurns;
+    frame.stampMirrored = stampMirrored != 0;
+    frame.symmetry = glm::bvec3(symmetry & 1, (symmetry >> 1) & 1, (symmetry >> 2) & 1);
+    frame.filter = static_cast<MorphologyFilter>(filter);
+    frame.filterRadius = filterRadius;
+    frame.material = material;
+
+    read(m_file, frame.viewportSize);
+    read(m_file, frame.viewportPosTopLeft);
+    read(m_file, viewportHovered);
+    frame.viewportHovered = viewportHovered != 0;
+
+    std::uint32_t commandCount = 0;
+    read(m_file, commandCount);
+    if (!m_file || commandCount > MAX_COMMANDS) {
+        m_file.close();
+        return false;
+    }
+    frame.commands.resize(commandCount);
+    for (GuiCommand& command : frame.commands) {
+        std::uint8_t type = 0;
+        std::int32_t option = 0;
+        read(m_file, type);
+        read(m_file, command.offset);
+        read(m_file, option);
+        command.type = static_cast<GuiCommandType>(type);
+        command.option = option;
+    }
+
+    if (!m_file) {
+        m_file.close();
+        return false;
+    }
+    m_frameIndex++;
+    return true;
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <array>
+#include <vector>
+#include <fstream>
+#include <string>
+#include <cstdint>
+#include <glm/glm.hpp>
+
+#include "scomponents/io/inputs.h"
+#include "scomponents/io/brush.h"
+#include "scomponents/io/gui-commands.h"
+
+/**
+ * @brief Everything the systems read from the user during one frame
+ */
+struct InputFrame {
+    glm::vec2 mousePos = { 0, 0 };
+    glm::vec2 ndcMousePos = { 0, 0 };
+    glm::vec2 posDelta = { 0, 0 };
+    std::vector<glm::vec2> ndcMouseSamples;
+    short wheelDelta = 0;
+    std::array<bool, static_cast<unsigned int>(InputAction::_ACTION_MAX)> actionState = {};
+
+    BrushType brushType = BrushType::VOXEL;
+    BrushUse brushUsage = BrushUse::ADD;
+    bool brushStarted = false;
+    int brushSize = 1;
+    bool brushFlat = false;
+    bool brushSameMaterial = false;
+    int fillLimit = 64;
+    SelectionMode selectionMode = SelectionMode::REPLACE;
+    int stampTurns = 0;
+    bool stampMirrored = false;
+    glm::bvec3 symmetry = glm::bvec3(false);
+    glm::ivec3 symmetryCenter = glm::ivec3(0);
+    MorphologyFilter filter = MorphologyFilter::SMOOTH;
+    int filterRadius = 4;
+    unsigned int material = 0;
+
+    glm::ivec2 viewportSize = { 0, 0 };
+    glm::ivec2 viewportPosTopLeft = { 0, 0 };
+    bool viewportHovered = false;
+
+    std::vector<GuiCommand> commands;
+};
+
+/**
+ * @brief Write the input of each frame to a binary file, to replay an editing session
+ */
+class InputRecorder {
+public:
+    InputRecorder();
+    ~InputRecorder();
+
+    /**
+     * @return false if the file cannot be written
+     */
+    bool open(const std::string& filePath);
+    void record(const InputFrame& frame);
+    void close();
+
+    bool isRecording() const { return m_file.is_open(); }
+
+private:
+    std::ofstream m_file;
+};
+
+/**
+ * @brief Read back the frames written by the InputRecorder
+ */
+class InputReplay {
+public:
+    InputReplay();
+    ~InputReplay();
+
+    /**
+     * @return false if the file cannot be read or was not written by the recorder
+     */
+    bool open(const std::string& filePath);
+
+    /**
+     * @return false once every frame has been read
+     */
+    bool next(InputFrame& frame);
+
+    bool isReplaying() const { return m_file.is_open(); }
+    unsigned int frameIndex() const { return m_frameIndex; }
+
+private:
+    std::ifstream m_file;
+    unsigned int m_frameIndex;
+};
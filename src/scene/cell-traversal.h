@@ -0,0 +1,74 @@
+#pragma once
+
+#include <array>
+#include <limits>
+#include <unordered_map>
+#include <cstdint>
+#include <glm/glm.hpp>
+
+#include "scomponents/scene/voxel-grid.h"
+
+/**
+ * @brief Keep the last chunk found, as neighbour cells are mostly in the same one
+ */
+class ChunkCache {
+public:
+    ChunkCache(const VoxelGrid& grid) : m_grid(grid), m_chunkPos(std::numeric_limits<int>::max()), m_chunk(nullptr) {}
+
+    const VoxelChunk* find(const glm::ivec3& pos) {
+        const glm::ivec3 chunkPos = VoxelGrid::chunkPosition(pos);
+        if (chunkPos != m_chunkPos) {
+            m_chunkPos = chunkPos;
+            m_chunk = m_grid.findChunk(pos);
+        }
+        return m_chunk;
+    }
+
+private:
+    const VoxelGrid& m_grid;
+    glm::ivec3 m_chunkPos;
+    const VoxelChunk* m_chunk;
+};
+
+/**
+ * @brief One bit per cell, allocated by chunk as the traversal grows
+ */
+class VisitedCells {
+public:
+    VisitedCells() : m_chunkPos(std::numeric_limits<int>::max()), m_words(nullptr) {}
+
+    /**
+     * @return false if the cell was already visited
+     */
+    bool visit(const glm::ivec3& pos) {
+        const unsigned int index = VoxelChunk::cellIndex(pos);
+        const std::uint64_t bit = std::uint64_t(1) << (index & 63);
+        std::uint64_t& word = words(pos)[index >> 6];
+        if (word & bit)
+            return false;
+        word |= bit;
+        return true;
+    }
+
+    bool isVisited(const glm::ivec3& pos) {
+        const unsigned int index = VoxelChunk::cellIndex(pos);
+        return (words(pos)[index >> 6] >> (index & 63)) & 1;
+    }
+
+private:
+    using Words = std::array<std::uint64_t, VoxelChunk::WORD_COUNT>;
+
+    Words& words(const glm::ivec3& pos) {
+        const glm::ivec3 chunkPos = VoxelGrid::chunkPosition(pos);
+        if (chunkPos != m_chunkPos) {
+            m_chunkPos = chunkPos;
+            m_words = &m_chunks.try_emplace(VoxelGrid::chunkKey(chunkPos)).first->second;
+        }
+        return *m_words;
+    }
+
+private:
+    std::unordered_map<std::uint64_t, Words> m_chunks; // Values are zero initialized, and never move
+    glm::ivec3 m_chunkPos;
+    Words* m_words;
+};
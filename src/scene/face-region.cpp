@@ -0,0 +1,55 @@
+#include "face-region.h"
+
+#include <array>
+#include <profiling/instrumentor.h>
+
+#include "scene/cell-traversal.h"
+
+void findConnectedFaces(const VoxelGrid& grid, const glm::ivec3& start, const glm::ivec3& normal, bool isSameMaterial, std::vector<glm::ivec3>& cells) {
+    PROFILE_SCOPE("findConnectedFaces");
+
+    ChunkCache layer(grid);
+    ChunkCache front(grid);
+    const VoxelChunk* startChunk = layer.find(start);
+    if (startChunk == nullptr || !startChunk->has(VoxelChunk::cellIndex(start)))
+        return;
+    const unsigned char material = startChunk->materials[VoxelChunk::cellIndex(start)];
+
+    auto isExposed = [&](const glm::ivec3& pos) {
+        const VoxelChunk* chunk = layer.find(pos);
+        const unsigned int index = VoxelChunk::cellIndex(pos);
+        if (chunk == nullptr || !chunk->has(index) || (isSameMaterial && chunk->materials[index] != material))
+            return false;
+
+        const glm::ivec3 frontPos = pos + normal;
+        const VoxelChunk* frontChunk = front.find(frontPos);
+        return frontChunk == nullptr || !frontChunk->has(VoxelChunk::cellIndex(frontPos));
+    };
+
+    if (!isExposed(start))
+        return;
+
+    const int axis = normal.x != 0 ? 0 : (normal.y != 0 ? 1 : 2);
+    glm::ivec3 right(0);
+    glm::ivec3 up(0);
+    right[(axis + 1) % 3] = 1;
+    up[(axis + 2) % 3] = 1;
+    const std::array<glm::ivec3, 4> directions = { right, -right, up, -up };
+
+    // Depth first, as it stays longer in the same chunk than a breadth first search
+    VisitedCells visited;
+    visited.visit(start);
+    cells.push_back(start);
+    std::vector<glm::ivec3> stack = { start };
+    while (!stack.empty()) {
+        const glm::ivec3 pos = stack.back();
+        stack.pop_back();
+        for (const glm::ivec3& direction : directions) {
+            const glm::ivec3 neighbour = pos + direction;
+            if (visited.visit(neighbour) && isExposed(neighbour)) {
+                cells.push_back(neighbour);
+                stack.push_back(neighbour);
+            }
+        }
+    }
+}
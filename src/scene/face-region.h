@@ -0,0 +1,14 @@
+#pragma once
+
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "scomponents/scene/voxel-grid.h"
+
+/**
+ * @brief Find the voxels whose face in the normal direction is exposed, and which are connected to the start one on its plane
+ * @param normal - Unit vector on one axis
+ * @param isSameMaterial - Only keep the voxels with the material of the start one
+ * @note Nothing is added if the face of the start voxel is not exposed.
+ */
+void findConnectedFaces(const VoxelGrid& grid, const glm::ivec3& start, const glm::ivec3& normal, bool isSameMaterial, std::vector<glm::ivec3>& cells);
@@ -0,0 +1,79 @@
+#include "flood-fill.h"
+
+#include <array>
+#include <profiling/instrumentor.h>
+
+#include "scene/cell-traversal.h"
+
+bool floodFill(const VoxelGrid& grid, const glm::ivec3& start, int limit, std::vector<glm::ivec3>& cells, bool stopAtLimit) {
+    PROFILE_SCOPE("floodFill");
+
+    ChunkCache chunks(grid);
+    const VoxelChunk* startChunk = chunks.find(start);
+    const unsigned int startIndex = VoxelChunk::cellIndex(start);
+    const bool isEmpty = startChunk == nullptr || !startChunk->has(startIndex);
+    const unsigned char material = isEmpty ? 0 : startChunk->materials[startIndex];
+    const glm::ivec3 min = start - limit;
+    const glm::ivec3 max = start + limit;
+
+    auto isInRegion = [&](const glm::ivec3& pos) {
+        const VoxelChunk* chunk = chunks.find(pos);
+        const unsigned int index = VoxelChunk::cellIndex(pos);
+        if (chunk == nullptr || !chunk->has(index))
+            return isEmpty;
+        return !isEmpty && chunk->materials[index] == material;
+    };
+
+    VisitedCells visited;
+    auto isFree = [&](const glm::ivec3& pos) { return !visited.isVisited(pos) && isInRegion(pos); };
+
+    // Rows of cells along x are filled at once, then the rows around them are scanned for one seed per run of free cells
+    const std::array<glm::ivec3, 4> rowOffsets = { glm::ivec3(0, 1, 0), glm::ivec3(0, -1, 0), glm::ivec3(0, 0, 1), glm::ivec3(0, 0, -1) };
+    bool isWithinLimit = true;
+    std::vector<glm::ivec3> seeds = { start };
+    while (!seeds.empty()) {
+        const glm::ivec3 seed = seeds.back();
+        seeds.pop_back();
+        if (!isFree(seed))
+            continue; // Filled by another row since it was found
+
+        glm::ivec3 first = seed;
+        glm::ivec3 last = seed;
+        while (first.x > min.x && isFree(first - glm::ivec3(1, 0, 0)))
+            first.x--;
+        while (last.x < max.x && isFree(last + glm::ivec3(1, 0, 0)))
+            last.x++;
+        if (isWithinLimit && ((first.x == min.x && isInRegion(first - glm::ivec3(1, 0, 0))) || (last.x == max.x && isInRegion(last + glm::ivec3(1, 0, 0)))))
+            isWithinLimit = false;
+        if (!isWithinLimit && stopAtLimit)
+            return false;
+
+        for (glm::ivec3 pos = first; pos.x <= last.x; pos.x++) {
+            visited.visit(pos);
+            cells.push_back(pos);
+        }
+
+        for (const glm::ivec3& offset : rowOffsets) {
+            glm::ivec3 pos = first + offset;
+            const bool isRowOutside = pos.y < min.y || pos.y > max.y || pos.z < min.z || pos.z > max.z;
+            bool isInRun = false;
+            for (; pos.x <= last.x; pos.x++) {
+                if (isRowOutside) {
+                    if (!isWithinLimit)
+                        break;
+                    isWithinLimit = !isInRegion(pos);
+                    if (!isWithinLimit && stopAtLimit)
+                        return false;
+                    continue;
+                }
+
+                const bool isCellFree = isFree(pos);
+                if (isCellFree && !isInRun)
+                    seeds.push_back(pos);
+                isInRun = isCellFree;
+            }
+        }
+    }
+
+    return isWithinLimit;
+}
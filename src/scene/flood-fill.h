@@ -0,0 +1,14 @@
+#pragma once
+
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "scomponents/scene/voxel-grid.h"
+
+/**
+ * @brief Find the cells connected to the start one by their faces. They are all empty if the start cell is, otherwise they hold voxels of its material.
+ * @param limit - Maximum distance of the cells to the start one on each axis
+ * @param stopAtLimit - Return as soon as the region reaches the limit, for callers which discard a region that is not enclosed
+ * @return false if the region goes beyond the limit. Unless stopped, the cells found within it are still added.
+ */
+bool floodFill(const VoxelGrid& grid, const glm::ivec3& start, int limit, std::vector<glm::ivec3>& cells, bool stopAtLimit = false);
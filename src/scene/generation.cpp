@@ -0,0 +1,26 @@
+#include "generation.h"
+
+#include "maths/rbf.h"
+
+void generateRbf(StagingScene& scene, const std::vector<glm::ivec3>& controlPoints, const Eigen::VectorXd& controlPointWeights) {
+    std::vector<glm::ivec3> coordWithYtoFind;
+    std::vector<unsigned int> materials;
+    coordWithYtoFind.reserve(scene.voxels.size());
+    materials.reserve(scene.voxels.size());
+    for (const auto& chunk : scene.voxels.snapshot()) {
+        for (unsigned int i = 0; i < VoxelChunk::VOLUME; i++) {
+            if (chunk->has(i)) {
+                coordWithYtoFind.push_back(chunk->cellPosition(i));
+                materials.push_back(chunk->materials[i]);
+            }
+        }
+    }
+
+    voxmt::rbfInterpolate(coordWithYtoFind, controlPoints, controlPointWeights, voxmt::RBFType::LINEAR, 0.5f, voxmt::RBFTransformAxis::Y);
+
+    scene.voxels.clear();
+    for (size_t i = 0; i < coordWithYtoFind.size(); i++) {
+        if (!scene.voxels.has(coordWithYtoFind.at(i)))
+            scene.voxels.insert(coordWithYtoFind.at(i), met::null, materials.at(i));
+    }
+}
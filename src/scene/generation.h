@@ -0,0 +1,13 @@
+#pragma once
+
+#include <vector>
+#include <Eigen/Dense>
+#include <glm/glm.hpp>
+
+#include "staging-scene.h"
+
+/**
+ * @brief Move the staged voxels on the Y axis with a radial basis function interpolation of the control points
+ * @note Voxels landing on an used position are dropped. The positions before generation are kept in the scene.
+ */
+void generateRbf(StagingScene& scene, const std::vector<glm::ivec3>& controlPoints, const Eigen::VectorXd& controlPointWeights);
@@ -0,0 +1,313 @@
+#include "morphology.h"
+
+#include <array>
+#include <vector>
+#include <unordered_set>
+#include <future>
+#include <thread>
+#include <algorithm>
+#include <cstdlib>
+#include <profiling/instrumentor.h>
+
+#include "maths/bits.h"
+
+namespace {
+    using Words = Selection::Words;
+
+    constexpr int SIZE = VoxelChunk::SIZE;
+    constexpr int PADDED = SIZE + 2;
+    constexpr std::uint32_t ROW_MASK = (1u << SIZE) - 1;
+
+    /**
+     * @brief Rows of cells along x of a chunk and of the layer around it, by z then y. Bit x + 1 is the cell x of the chunk.
+     */
+    using Rows = std::array<std::array<std::uint32_t, PADDED>, PADDED>;
+
+    enum class Pass {
+        DILATE,
+        ERODE,
+        MAJORITY
+    };
+
+    std::uint32_t rowBits(const Words& words, int y, int z) {
+        const unsigned int index = static_cast<unsigned int>(y | z << 4) << 4;
+        return static_cast<std::uint32_t>(words[index >> 6] >> (index & 63)) & ROW_MASK;
+    }
+
+    /**
+     * @param findWords - Returns the bits of the chunk holding the cell, or nullptr if it is empty
+     */
+    template<typename F>
+    void gatherRows(const glm::ivec3& chunkPos, F findWords, Rows& rows) {
+        // The 27 chunks around are found once
+        std::array<const Words*, 27> neighbours;
+        for (int z = 0; z < 3; z++) {
+            for (int y = 0; y < 3; y++) {
+                for (int x = 0; x < 3; x++) {
+                    neighbours[x + y * 3 + z * 9] = findWords((chunkPos + glm::ivec3(x, y, z) - 1) * SIZE);
+                }
+            }
+        }
+
+        for (int z = 0; z < PADDED; z++) {
+            const int chunkZ = z == 0 ? 0 : (z == PADDED - 1 ? 2 : 1);
+            for (int y = 0; y < PADDED; y++) {
+                const int chunkY = y == 0 ? 0 : (y == PADDED - 1 ? 2 : 1);
+                const Words* const* row = &neighbours[chunkY * 3 + chunkZ * 9];
+                const int localY = (y - 1) & (SIZE - 1);
+                const int localZ = (z - 1) & (SIZE - 1);
+
+                std::uint32_t bits = 0;
+                if (row[0] != nullptr)
+                    bits |= rowBits(*row[0], localY, localZ) >> (SIZE - 1);
+                if (row[1] != nullptr)
+                    bits |= rowBits(*row[1], localY, localZ) << 1;
+                if (row[2] != nullptr)
+                    bits |= (rowBits(*row[2], localY, localZ) & 1) << (SIZE + 1);
+                rows[z][y] = bits;
+            }
+        }
+    }
+
+    /**
+     * @brief Dilate or erode the rows on each axis in turn, which is the same as on the 3 x 3 x 3 cube
+     */
+    void morphRows(const Rows& rows, bool isDilating, Words& filtered) {
+        auto combine = [isDilating](std::uint32_t a, std::uint32_t b, std::uint32_t c) {
+            return isDilating ? (a | b | c) : (a & b & c);
+        };
+
+        Rows alongX, alongY;
+        for (int z = 0; z < PADDED; z++) {
+            for (int y = 0; y < PADDED; y++) {
+                const std::uint32_t row = rows[z][y];
+                alongX[z][y] = combine(row << 1, row, row >> 1);
+            }
+        }
+        for (int z = 0; z < PADDED; z++) {
+            for (int y = 1; y <= SIZE; y++) {
+                alongY[z][y] = combine(alongX[z][y - 1], alongX[z][y], alongX[z][y + 1]);
+            }
+        }
+
+        filtered.fill(0);
+        for (int z = 1; z <= SIZE; z++) {
+            for (int y = 1; y <= SIZE; y++) {
+                const std::uint32_t row = combine(alongY[z - 1][y], alongY[z][y], alongY[z + 1][y]);
+                const unsigned int index = static_cast<unsigned int>((y - 1) | (z - 1) << 4) << 4;
+                filtered[index >> 6] |= static_cast<std::uint64_t>((row >> 1) & ROW_MASK) << (index & 63);
+            }
+        }
+    }
+
+    /**
+     * @brief Keep the cells with at least 14 used cells in their 3 x 3 x 3 cube, counted on each axis in turn
+     */
+    void majorityRows(const Rows& rows, Words& filtered) {
+        std::array<std::array<std::array<std::uint8_t, SIZE>, PADDED>, PADDED> alongX;
+        std::array<std::array<std::array<std::uint8_t, SIZE>, SIZE>, PADDED> alongY;
+        for (int z = 0; z < PADDED; z++) {
+            for (int y = 0; y < PADDED; y++) {
+                const std::uint32_t row = rows[z][y];
+                for (int x = 0; x < SIZE; x++) {
+                    alongX[z][y][x] = ((row >> x) & 1) + ((row >> (x + 1)) & 1) + ((row >> (x + 2)) & 1);
+                }
+            }
+        }
+        for (int z = 0; z < PADDED; z++) {
+            for (int y = 0; y < SIZE; y++) {
+                for (int x = 0; x < SIZE; x++) {
+                    alongY[z][y][x] = alongX[z][y][x] + alongX[z][y + 1][x] + alongX[z][y + 2][x];
+                }
+            }
+        }
+
+        filtered.fill(0);
+        for (int z = 0; z < SIZE; z++) {
+            for (int y = 0; y < SIZE; y++) {
+                std::uint64_t row = 0;
+                for (int x = 0; x < SIZE; x++) {
+                    const int count = alongY[z][y][x] + alongY[z + 1][y][x] + alongY[z + 2][y][x];
+                    row |= static_cast<std::uint64_t>(count >= 14) << x;
+                }
+                const unsigned int index = static_cast<unsigned int>(y | z << 4) << 4;
+                filtered[index >> 6] |= row << (index & 63);
+            }
+        }
+    }
+
+    /**
+     * @brief Offsets to the 26 neighbours of a cell, the closest ones first
+     */
+    std::array<glm::ivec3, 26> neighbourOffsets() {
+        std::array<glm::ivec3, 26> offsets;
+        int i = 0;
+        for (int z = -1; z <= 1; z++) {
+            for (int y = -1; y <= 1; y++) {
+                for (int x = -1; x <= 1; x++) {
+                    if (x != 0 || y != 0 || z != 0)
+                        offsets[i++] = glm::ivec3(x, y, z);
+                }
+            }
+        }
+        std::stable_sort(offsets.begin(), offsets.end(), [](const glm::ivec3& a, const glm::ivec3& b) {
+            return std::abs(a.x) + std::abs(a.y) + std::abs(a.z) < std::abs(b.x) + std::abs(b.y) + std::abs(b.z);
+        });
+        return offsets;
+    }
+
+    unsigned int neighbourMaterial(const VoxelGrid& grid, const glm::ivec3& pos) {
+        static const std::array<glm::ivec3, 26> offsets = neighbourOffsets();
+        for (const glm::ivec3& offset : offsets) {
+            const VoxelChunk* chunk = grid.findChunk(pos + offset);
+            const unsigned int index = VoxelChunk::cellIndex(pos + offset);
+            if (chunk != nullptr && chunk->has(index))
+                return chunk->materials[index];
+        }
+        return 0;
+    }
+
+    struct ChunkChange {
+        Words added;
+        Words removed;
+        std::array<unsigned char, VoxelChunk::VOLUME> materials; // Of the added cells
+    };
+
+    /**
+     * @brief Call f(i) for each index, with the indices interleaved between the threads to balance dense and empty areas
+     * @note Runs on the calling thread for the web build, which has no threads
+     */
+    template<typename F>
+    void forEachParallel(size_t count, unsigned int threadCount, F f) {
+#ifdef __EMSCRIPTEN__
+        threadCount = 1;
+#endif
+        if (threadCount == 0)
+            threadCount = std::max(1u, std::thread::hardware_concurrency());
+        if (threadCount == 1 || count <= 1) {
+            PROFILE_SCOPE("Morphology filter chunks");
+            for (size_t i = 0; i < count; i++) {
+                f(i);
+            }
+            return;
+        }
+        threadCount = std::min<unsigned int>(threadCount, static_cast<unsigned int>(count));
+
+        std::vector<std::future<void>> jobs;
+        for (unsigned int t = 0; t < threadCount; t++) {
+            jobs.push_back(std::async(std::launch::async, [&f, count, t, threadCount]() {
+                PROFILE_SCOPE("Morphology filter chunks");
+                for (size_t i = t; i < count; i += threadCount) {
+                    f(i);
+                }
+            }));
+        }
+        for (auto& job : jobs) {
+            job.get();
+        }
+    }
+
+    void filterPass(const VoxelGrid& grid, const Selection& region, Pass pass, VoxelGrid& result, unsigned int threadCount) {
+        std::vector<glm::ivec3> chunkPositions;
+        chunkPositions.reserve(region.chunkCount());
+        region.chunkPositions(chunkPositions);
+
+        // Chunks only read the grid, and each one writes its own change
+        const Words empty = {};
+        std::vector<ChunkChange> changes(chunkPositions.size());
+        forEachParallel(chunkPositions.size(), threadCount, [&](size_t i) {
+            const glm::ivec3 origin = chunkPositions[i] * SIZE;
+            Rows rows;
+            gatherRows(chunkPositions[i], [&grid](const glm::ivec3& pos) -> const Words* {
+                const VoxelChunk* chunk = grid.findChunk(pos);
+                return chunk != nullptr ? &chunk->occupancy : nullptr;
+            }, rows);
+
+            Words filtered;
+            if (pass == Pass::MAJORITY)
+                majorityRows(rows, filtered);
+            else
+                morphRows(rows, pass == Pass::DILATE, filtered);
+
+            const VoxelChunk* chunk = grid.findChunk(origin);
+            const Words& current = chunk != nullptr ? chunk->occupancy : empty;
+            const Words& inRegion = *region.findChunk(origin);
+            ChunkChange& change = changes[i];
+            for (int w = 0; w < VoxelChunk::WORD_COUNT; w++) {
+                change.added[w] = filtered[w] & ~current[w] & inRegion[w];
+                change.removed[w] = current[w] & ~filtered[w] & inRegion[w];
+
+                std::uint64_t added = change.added[w];
+                while (added != 0) {
+                    const unsigned int index = (w << 6) | voxmt::lowestBitIndex(added);
+                    change.materials[index] = static_cast<unsigned char>(neighbourMaterial(grid, origin + VoxelChunk::cellOffset(index)));
+                    added &= added - 1;
+                }
+            }
+        });
+
+        // Only the changed cells are applied, on a grid sharing the chunks of the input one
+        VoxelGrid added, removed;
+        for (size_t i = 0; i < changes.size(); i++) {
+            const glm::ivec3 origin = chunkPositions[i] * SIZE;
+            for (int w = 0; w < VoxelChunk::WORD_COUNT; w++) {
+                for (std::uint64_t word = changes[i].added[w]; word != 0; word &= word - 1) {
+                    const unsigned int index = (w << 6) | voxmt::lowestBitIndex(word);
+                    added.insert(origin + VoxelChunk::cellOffset(index), met::null, changes[i].materials[index]);
+                }
+                for (std::uint64_t word = changes[i].removed[w]; word != 0; word &= word - 1) {
+                    removed.insert(origin + VoxelChunk::cellOffset((w << 6) | voxmt::lowestBitIndex(word)), met::null, 0);
+                }
+            }
+        }
+        result = VoxelGrid(grid.snapshot());
+        result.subtract(removed);
+        result.unite(added, false);
+    }
+}
+
+void filterVoxels(const VoxelGrid& grid, const Selection& region, MorphologyFilter filter, VoxelGrid& result, unsigned int threadCount) {
+    PROFILE_SCOPE("filterVoxels");
+
+    VoxelGrid first;
+    switch (filter) {
+    case MorphologyFilter::DILATE: filterPass(grid, region, Pass::DILATE, result, threadCount); break;
+    case MorphologyFilter::ERODE: filterPass(grid, region, Pass::ERODE, result, threadCount); break;
+    case MorphologyFilter::SMOOTH: filterPass(grid, region, Pass::MAJORITY, result, threadCount); break;
+    case MorphologyFilter::OPEN:
+        filterPass(grid, region, Pass::ERODE, first, threadCount);
+        filterPass(first, region, Pass::DILATE, result, threadCount);
+        break;
+    case MorphologyFilter::CLOSE:
+        filterPass(grid, region, Pass::DILATE, first, threadCount);
+        filterPass(first, region, Pass::ERODE, result, threadCount);
+        break;
+    default: break;
+    }
+}
+
+void dilateSelection(const Selection& selection, Selection& dilated) {
+    PROFILE_SCOPE("dilateSelection");
+
+    // Cells can spread to the chunks around the selected ones
+    std::vector<glm::ivec3> chunkPositions;
+    selection.chunkPositions(chunkPositions);
+    std::unordered_set<std::uint64_t> visited;
+    for (const glm::ivec3& chunkPos : chunkPositions) {
+        for (int z = -1; z <= 1; z++) {
+            for (int y = -1; y <= 1; y++) {
+                for (int x = -1; x <= 1; x++) {
+                    const glm::ivec3 position = chunkPos + glm::ivec3(x, y, z);
+                    if (!visited.insert(VoxelGrid::chunkKey(position)).second)
+                        continue;
+
+                    Rows rows;
+                    gatherRows(position, [&selection](const glm::ivec3& pos) { return selection.findChunk(pos); }, rows);
+                    Words words;
+                    morphRows(rows, true, words);
+                    dilated.insertChunk(position, words);
+                }
+            }
+        }
+    }
+}
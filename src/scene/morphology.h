@@ -0,0 +1,18 @@
+#pragma once
+
+#include "scomponents/io/brush.h"
+#include "scomponents/scene/voxel-grid.h"
+#include "scomponents/scene/selection.h"
+
+/**
+ * @brief Apply the filter to the cells of the region. Cells added by it take the material of their closest neighbour.
+ * @param result - Grid after the filter. It shares the chunks of the input grid which are not changed, so it can be compared to it cheaply.
+ * @param threadCount - 0 to use one thread per core, 1 to filter on the calling thread. Always 1 on the web build.
+ * @note Each chunk is filtered on its own from a copy of its cells and of the layer around them, in separable passes on rows of bits.
+ */
+void filterVoxels(const VoxelGrid& grid, const Selection& region, MorphologyFilter filter, VoxelGrid& result, unsigned int threadCount = 0);
+
+/**
+ * @brief Add the cells next to the selected ones, diagonals included
+ */
+void dilateSelection(const Selection& selection, Selection& dilated);
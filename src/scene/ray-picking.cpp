@@ -0,0 +1,50 @@
+#include "ray-picking.h"
+
+#include <cmath>
+#include <limits>
+
+#include "scene/cell-traversal.h"
+
+bool pickVoxel(const VoxelGrid& grid, const glm::vec3& from, const glm::vec3& to, glm::ivec3& position, glm::ivec3& normal) {
+    const glm::vec3 direction = to - from;
+    glm::ivec3 cell = glm::ivec3(glm::floor(from));
+    glm::ivec3 step;
+    glm::vec3 nextBoundary; // Part of the segment covered when the next cell boundary on each axis is crossed
+    glm::vec3 cellCrossing; // Part of the segment covered to cross one cell on each axis
+
+    for (int axis = 0; axis < 3; axis++) {
+        if (direction[axis] == 0.0f) {
+            step[axis] = 0;
+            nextBoundary[axis] = std::numeric_limits<float>::infinity();
+            cellCrossing[axis] = std::numeric_limits<float>::infinity();
+            continue;
+        }
+        step[axis] = direction[axis] > 0.0f ? 1 : -1;
+        const float boundary = static_cast<float>(direction[axis] > 0.0f ? cell[axis] + 1 : cell[axis]);
+        nextBoundary[axis] = (boundary - from[axis]) / direction[axis];
+        cellCrossing[axis] = std::abs(1.0f / direction[axis]);
+    }
+
+    ChunkCache chunks(grid);
+    glm::ivec3 enteredFace(0);
+
+    while (true) {
+        const VoxelChunk* chunk = chunks.find(cell);
+        if (chunk != nullptr && chunk->has(VoxelChunk::cellIndex(cell))) {
+            position = cell;
+            normal = enteredFace;
+            return true;
+        }
+
+        int axis = 0;
+        if (nextBoundary.y < nextBoundary[axis]) axis = 1;
+        if (nextBoundary.z < nextBoundary[axis]) axis = 2;
+        if (nextBoundary[axis] > 1.0f)
+            return false;
+
+        cell[axis] += step[axis];
+        nextBoundary[axis] += cellCrossing[axis];
+        enteredFace = glm::ivec3(0);
+        enteredFace[axis] = -step[axis];
+    }
+}
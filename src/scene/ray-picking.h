@@ -0,0 +1,13 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include "scomponents/scene/voxel-grid.h"
+
+/**
+ * @brief Find the first voxel crossed by a segment, visiting the cells in order along it
+ * @param position - Position of the voxel found
+ * @param normal - Face of the voxel entered by the segment. Zero if the segment starts inside the voxel.
+ * @return false if no voxel is crossed
+ */
+bool pickVoxel(const VoxelGrid& grid, const glm::vec3& from, const glm::vec3& to, glm::ivec3& position, glm::ivec3& normal);
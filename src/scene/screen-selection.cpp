@@ -0,0 +1,188 @@
+#include "screen-selection.h"
+
+#include <array>
+#include <limits>
+#include <algorithm>
+#include <cmath>
+#include <profiling/instrumentor.h>
+
+#include "maths/bits.h"
+
+namespace {
+    /**
+     * @brief Rectangle of the screen, in normalized device coordinates
+     */
+    class RectangleShape {
+    public:
+        RectangleShape(const glm::vec2& a, const glm::vec2& b) : m_min(glm::min(a, b)), m_max(glm::max(a, b)) {}
+
+        bool contains(const glm::vec2& point) const {
+            return point.x >= m_min.x && point.y >= m_min.y && point.x <= m_max.x && point.y <= m_max.y;
+        }
+
+        bool containsAll(const glm::vec2& min, const glm::vec2& max) const { return contains(min) && contains(max); }
+
+        bool containsNone(const glm::vec2& min, const glm::vec2& max) const {
+            return max.x < m_min.x || max.y < m_min.y || min.x > m_max.x || min.y > m_max.y;
+        }
+
+    private:
+        glm::vec2 m_min;
+        glm::vec2 m_max;
+    };
+
+    /**
+     * @brief Polygon drawn in a grid of pixels over the screen. The sums of its pixels tell in O(1) if a rectangle is fully inside or outside.
+     */
+    class LassoShape {
+    public:
+        LassoShape(const std::vector<glm::vec2>& points) : m_inside(RESOLUTION * RESOLUTION, 0), m_sums((RESOLUTION + 1) * (RESOLUTION + 1), 0) {
+            // Even-odd rule on the center of the pixels, row by row
+            std::vector<float> crossings;
+            for (int y = 0; y < RESOLUTION; y++) {
+                const float ndcY = toNdc(y + 0.5f);
+                crossings.clear();
+                for (size_t i = 0; i < points.size(); i++) {
+                    const glm::vec2& a = points.at(i);
+                    const glm::vec2& b = points.at((i + 1) % points.size());
+                    if ((a.y <= ndcY) != (b.y <= ndcY))
+                        crossings.push_back(toPixel(a.x + (ndcY - a.y) / (b.y - a.y) * (b.x - a.x)));
+                }
+                std::sort(crossings.begin(), crossings.end());
+
+                for (size_t i = 0; i + 1 < crossings.size(); i += 2) {
+                    const int first = std::max(0, static_cast<int>(std::ceil(crossings.at(i) - 0.5f)));
+                    const int last = std::min(RESOLUTION - 1, static_cast<int>(std::ceil(crossings.at(i + 1) - 0.5f)) - 1);
+                    for (int x = first; x <= last; x++) {
+                        m_inside[y * RESOLUTION + x] = 1;
+                    }
+                }
+            }
+
+            // Summed area table, with a row and a column of zeros before the pixels
+            const int width = RESOLUTION + 1;
+            for (int y = 0; y < RESOLUTION; y++) {
+                for (int x = 0; x < RESOLUTION; x++) {
+                    m_sums[(y + 1) * width + x + 1] = m_inside[y * RESOLUTION + x] + m_sums[y * width + x + 1] + m_sums[(y + 1) * width + x] - m_sums[y * width + x];
+                }
+            }
+        }
+
+        bool contains(const glm::vec2& point) const {
+            const int x = static_cast<int>(std::floor(toPixel(point.x)));
+            const int y = static_cast<int>(std::floor(toPixel(point.y)));
+            return x >= 0 && y >= 0 && x < RESOLUTION && y < RESOLUTION && m_inside[y * RESOLUTION + x];
+        }
+
+        bool containsAll(const glm::vec2& min, const glm::vec2& max) const {
+            const glm::ivec2 first = glm::floor(glm::vec2(toPixel(min.x), toPixel(min.y)));
+            const glm::ivec2 last = glm::floor(glm::vec2(toPixel(max.x), toPixel(max.y)));
+            if (first.x < 0 || first.y < 0 || last.x >= RESOLUTION || last.y >= RESOLUTION)
+                return false;
+            return sum(first, last) == static_cast<unsigned int>((last.x - first.x + 1) * (last.y - first.y + 1));
+        }
+
+        bool containsNone(const glm::vec2& min, const glm::vec2& max) const {
+            const glm::ivec2 first = glm::max(glm::ivec2(glm::floor(glm::vec2(toPixel(min.x), toPixel(min.y)))), glm::ivec2(0));
+            const glm::ivec2 last = glm::min(glm::ivec2(glm::floor(glm::vec2(toPixel(max.x), toPixel(max.y)))), glm::ivec2(RESOLUTION - 1));
+            return first.x > last.x || first.y > last.y || sum(first, last) == 0;
+        }
+
+    private:
+        static float toPixel(float ndc) { return (ndc + 1.0f) * 0.5f * RESOLUTION; }
+        static float toNdc(float pixel) { return pixel / RESOLUTION * 2.0f - 1.0f; }
+
+        /**
+         * @brief Number of pixels inside the polygon, between first and last included
+         */
+        unsigned int sum(const glm::ivec2& first, const glm::ivec2& last) const {
+            const int width = RESOLUTION + 1;
+            return m_sums[(last.y + 1) * width + last.x + 1] - m_sums[first.y * width + last.x + 1] - m_sums[(last.y + 1) * width + first.x] + m_sums[first.y * width + first.x];
+        }
+
+    private:
+        static constexpr int RESOLUTION = 1024;
+        std::vector<unsigned char> m_inside;
+        std::vector<unsigned int> m_sums;
+    };
+
+    /**
+     * @brief Whole chunks are kept or skipped from the screen rectangle of their voxels. Voxels are only projected one by one in the chunks crossed by the outline of the shape.
+     */
+    template<typename Shape>
+    void selectInShape(const VoxelGrid& grid, const glm::mat4& viewProj, const Shape& shape, Selection& selection) {
+        constexpr int SIZE = VoxelChunk::SIZE;
+        constexpr std::uint64_t ROW_MASK = (std::uint64_t(1) << SIZE) - 1;
+
+        for (const auto& chunk : grid.snapshot()) {
+            const glm::vec3 firstCenter = glm::vec3(chunk->position * SIZE) + 0.5f;
+
+            // The centers of the chunk are drawn inside the rectangle of its corner centers, if none is behind the camera
+            glm::vec2 min(std::numeric_limits<float>::max());
+            glm::vec2 max(std::numeric_limits<float>::lowest());
+            int behindCount = 0;
+            for (int corner = 0; corner < 8; corner++) {
+                const glm::vec3 center = firstCenter + glm::vec3(corner & 1, (corner >> 1) & 1, corner >> 2) * static_cast<float>(SIZE - 1);
+                const glm::vec4 clip = viewProj * glm::vec4(center, 1.0f);
+                if (clip.w <= 0.0f) {
+                    behindCount++;
+                    continue;
+                }
+                min = glm::min(min, glm::vec2(clip) / clip.w);
+                max = glm::max(max, glm::vec2(clip) / clip.w);
+            }
+
+            if (behindCount == 8)
+                continue;
+            if (behindCount == 0) {
+                if (shape.containsNone(min, max))
+                    continue;
+                if (shape.containsAll(min, max)) {
+                    selection.insertChunk(chunk->position, chunk->occupancy);
+                    continue;
+                }
+            }
+
+            Selection::Words words = {};
+            const glm::vec4 origin = viewProj * glm::vec4(firstCenter, 1.0f);
+            for (int z = 0; z < SIZE; z++) {
+                for (int y = 0; y < SIZE; y++) {
+                    const unsigned int index = VoxelChunk::cellIndex(glm::ivec3(0, y, z));
+                    const std::uint64_t row = (chunk->occupancy[index >> 6] >> (index & 63)) & ROW_MASK;
+                    if (row == 0)
+                        continue;
+
+                    // The centers of the row are projected together, in a loop the compiler vectorizes
+                    const glm::vec4 rowOrigin = origin + static_cast<float>(y) * viewProj[1] + static_cast<float>(z) * viewProj[2];
+                    std::array<float, SIZE> xs, ys, ws;
+                    for (int x = 0; x < SIZE; x++) {
+                        xs[x] = rowOrigin.x + x * viewProj[0].x;
+                        ys[x] = rowOrigin.y + x * viewProj[0].y;
+                        ws[x] = rowOrigin.w + x * viewProj[0].w;
+                    }
+
+                    std::uint64_t selected = 0;
+                    for (std::uint64_t bits = row; bits != 0; bits &= bits - 1) {
+                        const unsigned int x = voxmt::lowestBitIndex(bits);
+                        if (ws[x] > 0.0f && shape.contains(glm::vec2(xs[x], ys[x]) / ws[x]))
+                            selected |= std::uint64_t(1) << x;
+                    }
+                    words[index >> 6] |= selected << (index & 63);
+                }
+            }
+            selection.insertChunk(chunk->position, words);
+        }
+    }
+}
+
+void selectInRectangle(const VoxelGrid& grid, const glm::mat4& viewProj, const glm::vec2& min, const glm::vec2& max, Selection& selection) {
+    PROFILE_SCOPE("selectInRectangle");
+    selectInShape(grid, viewProj, RectangleShape(min, max), selection);
+}
+
+void selectInLasso(const VoxelGrid& grid, const glm::mat4& viewProj, const std::vector<glm::vec2>& points, Selection& selection) {
+    PROFILE_SCOPE("selectInLasso");
+    if (points.size() < 3)
+        return;
+    selectInShape(grid, viewProj, LassoShape(points), selection);
+}
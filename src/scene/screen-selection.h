@@ -0,0 +1,19 @@
+#pragma once
+
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "scomponents/scene/voxel-grid.h"
+#include "scomponents/scene/selection.h"
+
+/**
+ * @brief Add the voxels whose center is drawn inside a rectangle of the screen. Hidden voxels are selected too.
+ * @param min, max - Corners of the rectangle, in normalized device coordinates
+ */
+void selectInRectangle(const VoxelGrid& grid, const glm::mat4& viewProj, const glm::vec2& min, const glm::vec2& max, Selection& selection);
+
+/**
+ * @brief Add the voxels whose center is drawn inside a polygon of the screen. Hidden voxels are selected too.
+ * @param points - Outline of the polygon in normalized device coordinates, the last point is linked to the first one
+ */
+void selectInLasso(const VoxelGrid& grid, const glm::mat4& viewProj, const std::vector<glm::vec2>& points, Selection& selection);
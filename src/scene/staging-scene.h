@@ -0,0 +1,15 @@
+#pragma once
+
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "scomponents/scene/voxel-grid.h"
+#include "graphics/constant-buffer.h"
+
+/**
+ * @brief Scene decoded from a file, which is not linked to the registry yet
+ */
+struct StagingScene {
+	VoxelGrid voxels;
+	std::vector<cb::perMaterialChange> palette; // Empty to keep the current palette
+};
@@ -0,0 +1,149 @@
+#include "voxel-editor.h"
+
+#include <cassert>
+
+#include "components/physics/transform.h"
+#include "components/graphics/material.h"
+
+VoxelEditor::VoxelEditor(met::registry& registry, VoxelGrid& grid) : m_registry(registry), m_grid(grid) {}
+
+VoxelEditor::~VoxelEditor() {}
+
+met::entity VoxelEditor::add(const glm::ivec3& position, unsigned int material) {
+    if (m_grid.has(position))
+        return met::null;
+
+    met::entity entity = m_registry.create();
+    comp::Material mat;
+    mat.sIndex = material;
+    m_registry.assign<comp::Material>(entity, mat);
+    m_registry.assign<comp::Transform>(entity, comp::Transform(position));
+    m_grid.insert(position, entity, material);
+    return entity;
+}
+
+void VoxelEditor::remove(met::entity id) {
+    m_grid.erase(m_registry.get<comp::Transform>(id).position);
+    m_registry.destroy(id);
+}
+
+void VoxelEditor::paint(met::entity id, unsigned int material) {
+    m_registry.get<comp::Material>(id).sIndex = material;
+    m_grid.paint(m_registry.get<comp::Transform>(id).position, material);
+}
+
+void VoxelEditor::add(const std::vector<glm::ivec3>& positions, const std::vector<unsigned int>& materials) {
+    assert(positions.size() == materials.size() && "Each voxel needs a material");
+
+    std::vector<comp::Transform> transforms;
+    std::vector<comp::Material> mats;
+    transforms.reserve(positions.size());
+    mats.reserve(positions.size());
+    for (size_t i = 0; i < positions.size(); i++) {
+        if (!m_grid.has(positions.at(i))) {
+            transforms.emplace_back(positions.at(i));
+            mats.emplace_back();
+            mats.back().sIndex = materials.at(i);
+        }
+    }
+
+    std::vector<met::entity> ids(transforms.size());
+    m_registry.create(ids.begin(), ids.end());
+    m_registry.assign<comp::Material>(ids.begin(), ids.end(), mats.begin());
+    m_registry.assign<comp::Transform>(ids.begin(), ids.end(), transforms.begin());
+
+    for (size_t i = 0; i < ids.size(); i++) {
+        m_grid.insert(transforms.at(i).position, ids.at(i), mats.at(i).sIndex);
+    }
+}
+
+void VoxelEditor::remove(const std::vector<glm::ivec3>& positions) {
+    for (const glm::ivec3& position : positions) {
+        const met::entity id = m_grid.at(position);
+        if (id != met::null) {
+            m_grid.erase(position);
+            m_registry.destroy(id);
+        }
+    }
+}
+
+void VoxelEditor::paint(const std::vector<glm::ivec3>& positions, const std::vector<unsigned int>& materials) {
+    assert(positions.size() == materials.size() && "Each voxel needs a material");
+
+    for (size_t i = 0; i < positions.size(); i++) {
+        const met::entity id = m_grid.at(positions.at(i));
+        if (id != met::null)
+            paint(id, materials.at(i));
+    }
+}
+
+void VoxelEditor::move(const std::vector<met::entity>& ids, const std::vector<glm::ivec3>& positions) {
+    assert(ids.size() == positions.size() && "Each voxel needs a position");
+
+    for (met::entity id : ids) {
+        m_grid.erase(m_registry.get<comp::Transform>(id).position);
+    }
+
+    for (size_t i = 0; i < ids.size(); i++) {
+        if (m_grid.has(positions.at(i))) {
+            m_registry.destroy(ids.at(i));
+        } else {
+            m_registry.get<comp::Transform>(ids.at(i)).position = positions.at(i);
+            m_grid.insert(positions.at(i), ids.at(i), m_registry.get<comp::Material>(ids.at(i)).sIndex);
+        }
+    }
+}
+
+void VoxelEditor::move(const std::vector<glm::ivec3>& positions, const glm::ivec3& offset) {
+    std::vector<met::entity> ids;
+    std::vector<glm::ivec3> newPositions;
+    ids.reserve(positions.size());
+    newPositions.reserve(positions.size());
+    for (const glm::ivec3& position : positions) {
+        const met::entity id = m_grid.at(position);
+        if (id != met::null) {
+            ids.push_back(id);
+            newPositions.push_back(position + offset);
+        }
+    }
+    move(ids, newPositions);
+}
+
+void VoxelEditor::clear() {
+    // The grid holds every voxel, and does not need the component collections to exist like a view does
+    for (const auto& chunk : m_grid.snapshot()) {
+        for (unsigned int i = 0; i < VoxelChunk::VOLUME; i++) {
+            if (chunk->has(i) && chunk->entities[i] != met::null)
+                m_registry.destroy(chunk->entities[i]);
+        }
+    }
+    m_grid.clear();
+}
+
+void VoxelEditor::load(const VoxelGrid& staged) {
+    clear();
+
+    std::vector<comp::Transform> transforms;
+    std::vector<comp::Material> materials;
+    transforms.reserve(staged.size());
+    materials.reserve(staged.size());
+    for (const auto& chunk : staged.snapshot()) {
+        for (unsigned int i = 0; i < VoxelChunk::VOLUME; i++) {
+            if (chunk->has(i)) {
+                transforms.emplace_back(chunk->cellPosition(i));
+                materials.emplace_back();
+                materials.back().sIndex = chunk->materials[i];
+            }
+        }
+    }
+
+    // Components are inserted in bulk as it is much faster than one by one for large scenes
+    std::vector<met::entity> ids(transforms.size());
+    m_registry.create(ids.begin(), ids.end());
+    m_registry.assign<comp::Material>(ids.begin(), ids.end(), materials.begin());
+    m_registry.assign<comp::Transform>(ids.begin(), ids.end(), transforms.begin());
+
+    for (size_t i = 0; i < ids.size(); i++) {
+        m_grid.insert(transforms.at(i).position, ids.at(i), materials.at(i).sIndex);
+    }
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <vector>
+#include <glm/glm.hpp>
+#include <met/met.hpp>
+
+#include "scomponents/scene/voxel-grid.h"
+
+/**
+ * @brief Create, destroy and change voxels while keeping the registry and the voxel grid in sync
+ * @note Only one voxel can exist at a given position.
+ */
+class VoxelEditor {
+public:
+    VoxelEditor(met::registry& registry, VoxelGrid& grid);
+    ~VoxelEditor();
+
+    /**
+     * @brief Create a voxel entity
+     * @return met::null if the position is already used
+     */
+    met::entity add(const glm::ivec3& position, unsigned int material);
+    void remove(met::entity id);
+    void paint(met::entity id, unsigned int material);
+
+    /**
+     * @brief Create voxels in bulk, with one material per position. Positions must be unique, the used ones are skipped.
+     */
+    void add(const std::vector<glm::ivec3>& positions, const std::vector<unsigned int>& materials);
+
+    /**
+     * @brief Destroy the voxels at the given positions, if there are some
+     */
+    void remove(const std::vector<glm::ivec3>& positions);
+
+    /**
+     * @brief Change the material of the voxels at the given positions, if there are some
+     */
+    void paint(const std::vector<glm::ivec3>& positions, const std::vector<unsigned int>& materials);
+
+    /**
+     * @brief Change the position of the given voxels. The ones landing on an used position are destroyed.
+     */
+    void move(const std::vector<met::entity>& ids, const std::vector<glm::ivec3>& positions);
+
+    /**
+     * @brief Move the voxels at the given positions by the offset. The ones landing on an used position are destroyed.
+     */
+    void move(const std::vector<glm::ivec3>& positions, const glm::ivec3& offset);
+
+    /**
+     * @brief Destroy every voxel
+     */
+    void clear();
+
+    /**
+     * @brief Replace the scene with the voxels of a grid which is not linked to the registry
+     */
+    void load(const VoxelGrid& staged);
+
+private:
+    met::registry& m_registry;
+    VoxelGrid& m_grid;
+};
@@ -48,4 +48,6 @@ private:
 private:
 	friend class PaletteGui;
 	friend class RenderSystem;
+	friend class LoadingSystem;
+	friend class App;
 };
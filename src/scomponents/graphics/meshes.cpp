@@ -28,38 +28,9 @@ void Meshes::init(RenderCommand& rcommand) {
 		m_plane = mesh;
 	}
 
-	// Init CubeMesh
-	{
-		// Attributes
-		AttributeBuffer positionBuffer = rcommand.createAttributeBuffer(&cubeData::positions, static_cast<unsigned int>(std::size(cubeData::positions)), sizeof(glm::vec3));
-		AttributeBuffer normalBuffer = rcommand.createAttributeBuffer(&cubeData::normals, static_cast<unsigned int>(std::size(cubeData::normals)), sizeof(glm::vec3));
-		std::array<glm::vec3, 15> translations; // TODO set to scene size
-		AttributeBuffer translationInstanceBuffer = rcommand.createAttributeBuffer(translations.data(), static_cast<unsigned int>(translations.size()), sizeof(glm::vec3), AttributeBufferUsage::DYNAMIC_DRAW, AttributeBufferType::PER_INSTANCE_TRANSLATION);
-		std::array<glm::vec3, 15> entityIds;
-		AttributeBuffer entityInstanceBuffer = rcommand.createAttributeBuffer(entityIds.data(), static_cast<unsigned int>(entityIds.size()), sizeof(glm::vec3), AttributeBufferUsage::DYNAMIC_DRAW, AttributeBufferType::PER_INSTANCE_ENTITY_ID);
-		std::array<unsigned int, 15> materialIndices;
-		AttributeBuffer materialInstanceBuffer = rcommand.createAttributeBuffer(materialIndices.data(), static_cast<unsigned int>(materialIndices.size()), sizeof(unsigned int), AttributeBufferUsage::DYNAMIC_DRAW, AttributeBufferType::PER_INSTANCE_MATERIAL);
-
-		// Vertex & Index buffers
-		PipelineInputDescription inputDescription = {
-			{ ShaderDataType::Float3, "Position" },
-			{ ShaderDataType::Float3, "Translation", BufferElementUsage::PerInstance },
-			{ ShaderDataType::Float3, "Normal" },
-			{ ShaderDataType::Float3, "EntityId", BufferElementUsage::PerInstance },
-			{ ShaderDataType::UInt, "MaterialIndex", BufferElementUsage::PerInstance }
-		};
-		AttributeBuffer attributeBuffers[] = {
-			positionBuffer, translationInstanceBuffer, normalBuffer, entityInstanceBuffer, materialInstanceBuffer
-		};
-		VertexBuffer vb = rcommand.createVertexBuffer(inputDescription, attributeBuffers);
-		IndexBuffer ib = rcommand.createIndexBuffer(cubeData::indices, static_cast<unsigned int>(std::size(cubeData::indices)), IndexBuffer::dataType::UNSIGNED_BYTE);
-
-		// Save data
-		Mesh mesh;
-		mesh.ib = ib;
-		mesh.vb = vb;
-		m_cube = mesh;
-	}
+	// Init Cube Meshes
+	m_cube = createInstancedCube(rcommand);
+	m_previewCube = createInstancedCube(rcommand);
 
 	// Init Inverted CubeMesh
 	{
@@ -90,6 +61,8 @@ void Meshes::destroy(RenderCommand& rcommand) {
 	// Cube
 	rcommand.deleteVertexBuffer(m_cube.vb);
 	rcommand.deleteIndexBuffer(m_cube.ib);
+	rcommand.deleteVertexBuffer(m_previewCube.vb);
+	rcommand.deleteIndexBuffer(m_previewCube.ib);
 
 	// Plane
 	rcommand.deleteVertexBuffer(m_plane.vb);
@@ -99,3 +72,35 @@ void Meshes::destroy(RenderCommand& rcommand) {
 	rcommand.deleteVertexBuffer(m_invertCube.vb);
 	rcommand.deleteIndexBuffer(m_invertCube.ib);
 }
+
+Mesh Meshes::createInstancedCube(RenderCommand& rcommand) {
+	// Attributes
+	AttributeBuffer positionBuffer = rcommand.createAttributeBuffer(&cubeData::positions, static_cast<unsigned int>(std::size(cubeData::positions)), sizeof(glm::vec3));
+	AttributeBuffer normalBuffer = rcommand.createAttributeBuffer(&cubeData::normals, static_cast<unsigned int>(std::size(cubeData::normals)), sizeof(glm::vec3));
+	std::array<glm::vec3, 15> translations; // TODO set to scene size
+	AttributeBuffer translationInstanceBuffer = rcommand.createAttributeBuffer(translations.data(), static_cast<unsigned int>(translations.size()), sizeof(glm::vec3), AttributeBufferUsage::DYNAMIC_DRAW, AttributeBufferType::PER_INSTANCE_TRANSLATION);
+	std::array<glm::vec3, 15> entityIds;
+	AttributeBuffer entityInstanceBuffer = rcommand.createAttributeBuffer(entityIds.data(), static_cast<unsigned int>(entityIds.size()), sizeof(glm::vec3), AttributeBufferUsage::DYNAMIC_DRAW, AttributeBufferType::PER_INSTANCE_ENTITY_ID);
+	std::array<unsigned int, 15> materialIndices;
+	AttributeBuffer materialInstanceBuffer = rcommand.createAttributeBuffer(materialIndices.data(), static_cast<unsigned int>(materialIndices.size()), sizeof(unsigned int), AttributeBufferUsage::DYNAMIC_DRAW, AttributeBufferType::PER_INSTANCE_MATERIAL);
+
+	// Vertex & Index buffers
+	PipelineInputDescription inputDescription = {
+		{ ShaderDataType::Float3, "Position" },
+		{ ShaderDataType::Float3, "Translation", BufferElementUsage::PerInstance },
+		{ ShaderDataType::Float3, "Normal" },
+		{ ShaderDataType::Float3, "EntityId", BufferElementUsage::PerInstance },
+		{ ShaderDataType::UInt, "MaterialIndex", BufferElementUsage::PerInstance }
+	};
+	AttributeBuffer attributeBuffers[] = {
+		positionBuffer, translationInstanceBuffer, normalBuffer, entityInstanceBuffer, materialInstanceBuffer
+	};
+	VertexBuffer vb = rcommand.createVertexBuffer(inputDescription, attributeBuffers);
+	IndexBuffer ib = rcommand.createIndexBuffer(cubeData::indices, static_cast<unsigned int>(std::size(cubeData::indices)), IndexBuffer::dataType::UNSIGNED_BYTE);
+
+	// Save data
+	Mesh mesh;
+	mesh.ib = ib;
+	mesh.vb = vb;
+	return mesh;
+}
@@ -74,14 +74,21 @@ public:
 	const Mesh& plane() const { return m_plane; }
 	const Mesh& invertCube() const { return m_invertCube; }
 
+	/**
+	 * @brief Instances of the cubes added by the brush, until they are committed to the scene
+	 */
+	const Mesh& previewCube() const { return m_previewCube; }
+
 private:
 	void init(RenderCommand& rcommand);
 	void destroy(RenderCommand& rcommand);
+	Mesh createInstancedCube(RenderCommand& rcommand);
 
 private:
 	Mesh m_cube;
 	Mesh m_plane;
 	Mesh m_invertCube;
+	Mesh m_previewCube;
 
 private:
 	friend class App;
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+#include <glm/glm.hpp>
+
+#include "scomponents/io/brush.h"
+#include "scomponents/scene/voxel-grid.h"
+
+/**
+ * @brief Pending edit of the brush. It is drawn over the scene while the brush is used, and applied to the scene once on release.
+ */
+class BrushPreview {
+public:
+    BrushPreview() {};
+
+    BrushUse usage() const { return m_usage; }
+    unsigned int material() const { return m_material; }
+    bool empty() const { return m_positions.empty(); }
+    size_t size() const { return m_positions.size(); }
+    bool has(const glm::ivec3& pos) const { return m_indices.find(VoxelGrid::cellKey(pos)) != m_indices.end(); }
+
+    /**
+     * @brief Cells to add, remove or paint
+     */
+    const std::vector<glm::ivec3>& positions() const { return m_positions; }
+
+    /**
+     * @brief Shape drawn on the screen by the marquee and lasso brushes, in normalized device coordinates
+     */
+    const std::vector<glm::vec2>& outline() const { return m_outline; }
+
+private:
+    void insert(const glm::ivec3& pos) {
+        if (m_indices.emplace(VoxelGrid::cellKey(pos), m_positions.size()).second)
+            m_positions.push_back(pos);
+    }
+
+    void erase(const glm::ivec3& pos) {
+        const auto it = m_indices.find(VoxelGrid::cellKey(pos));
+        if (it == m_indices.end())
+            return;
+
+        // The last position takes the place of the erased one
+        const size_t index = it->second;
+        m_indices.erase(it);
+        if (index != m_positions.size() - 1) {
+            m_positions.at(index) = m_positions.back();
+            m_indices.at(VoxelGrid::cellKey(m_positions.at(index))) = index;
+        }
+        m_positions.pop_back();
+    }
+
+    void clear() {
+        m_positions.clear();
+        m_indices.clear();
+        m_outline.clear();
+    }
+
+private:
+    BrushUse m_usage = BrushUse::ADD;
+    unsigned int m_material = 0;
+    std::vector<glm::ivec3> m_positions;
+    std::unordered_map<std::uint64_t, size_t> m_indices; // Index in positions by cell key
+    std::vector<glm::vec2> m_outline;
+
+private:
+    friend class BrushSystem;
+};
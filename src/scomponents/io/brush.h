@@ -1,11 +1,18 @@
 #pragma once
 
+#include <glm/glm.hpp>
+
 enum class BrushType {
 	VOXEL = 0,
 	FACE,
 	BOX,
 	LINE,
-	CIRCLE
+	CIRCLE,
+	FILL,
+	MARQUEE, // Rectangle of the screen, only to select
+	LASSO, // Polygon drawn on the screen, only to select
+	STAMP, // Paste of the clipboard, only to add
+	FILTER // Morphological filter on a ball, which adds and removes voxels
 };
 
 enum class BrushUse {
@@ -15,6 +22,27 @@ enum class BrushUse {
 	SELECT
 };
 
+/**
+ * @brief How the cells picked by a select brush are combined with the selection
+ */
+enum class SelectionMode {
+	REPLACE = 0,
+	UNITE,
+	SUBTRACT,
+	INTERSECT
+};
+
+/**
+ * @brief Filter on the 3 x 3 x 3 cells around each cell, to clean up volumes
+ */
+enum class MorphologyFilter {
+	DILATE = 0,
+	ERODE,
+	OPEN, // Erode then dilate, removing thin parts
+	CLOSE, // Dilate then erode, filling small holes
+	SMOOTH // Cells are used if most of their neighbourhood is
+};
+
 class Brush {
 public:
     Brush() {};
@@ -22,11 +50,33 @@ public:
     BrushType type() const { return m_type; }
     BrushUse usage() const { return m_usage; }
     bool started() const { return m_started; }
+    int size() const { return m_size; } // Thickness of the line brush, in cells
+    bool isFlat() const { return m_isFlat; } // The circle brush draws discs facing the pressed face instead of spheres
+    bool isSameMaterial() const { return m_isSameMaterial; } // The face brush only extends to faces of the hovered material
+    int fillLimit() const { return m_fillLimit; } // Distance to the pressed cell beyond which the fill is not enclosed, in cells
+    SelectionMode selectionMode() const { return m_selectionMode; }
+    int stampTurns() const { return m_stampTurns; } // Quarter turns of the clipboard around the y axis when stamped
+    bool isStampMirrored() const { return m_isStampMirrored; }
+    const glm::bvec3& symmetry() const { return m_symmetry; } // Edits are mirrored on the planes of the enabled axes
+    const glm::ivec3& symmetryCenter() const { return m_symmetryCenter; } // Cell on every symmetry plane
+    MorphologyFilter filter() const { return m_filter; }
+    int filterRadius() const { return m_filterRadius; } // Radius of the ball filtered by the brush, in cells
 
 private:
     BrushType m_type = BrushType::VOXEL;
 	BrushUse m_usage = BrushUse::ADD;
 	bool m_started = false;
+	int m_size = 1;
+	bool m_isFlat = false;
+	bool m_isSameMaterial = false;
+	int m_fillLimit = 64;
+	SelectionMode m_selectionMode = SelectionMode::REPLACE;
+	int m_stampTurns = 0;
+	bool m_isStampMirrored = false;
+	glm::bvec3 m_symmetry = glm::bvec3(false);
+	glm::ivec3 m_symmetryCenter = glm::ivec3(0);
+	MorphologyFilter m_filter = MorphologyFilter::SMOOTH;
+	int m_filterRadius = 4;
 
 private:
     friend class BrushGui;
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <vector>
+#include <glm/glm.hpp>
+
+enum class GuiCommandType {
+    UNDO = 0,
+    REDO,
+    SELECT_ALL,
+    DESELECT,
+    COPY_SELECTION,
+    DELETE_SELECTION,
+    PAINT_SELECTION,
+    MOVE_SELECTION,
+    FILTER_SELECTION,
+    CSG_UNITE,
+    CSG_SUBTRACT,
+    CSG_INTERSECT,
+    _COMMAND_MAX
+};
+
+struct GuiCommand {
+    GuiCommandType type = GuiCommandType::UNDO;
+    glm::ivec3 offset = glm::ivec3(0); // Of the moved selection, or of the clipboard for boolean operations
+    int option = 0; // Filter of the selection, or whether the clipboard materials are kept on overlap
+};
+
+/**
+ * @brief Edits requested by the windows, done by the CommandSystem at the start of the next frame
+ * @note They go through this queue so that they are recorded and replayed with the inputs.
+ */
+class GuiCommands {
+public:
+    GuiCommands() {};
+
+    void push(const GuiCommand& command) { m_commands.push_back(command); }
+    const std::vector<GuiCommand>& commands() const { return m_commands; }
+
+private:
+    std::vector<GuiCommand> m_commands;
+
+private:
+    friend class App;
+    friend class CommandSystem;
+};
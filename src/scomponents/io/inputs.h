@@ -29,6 +29,7 @@ public:
 	const glm::vec2& mousePos() const { return m_mousePos; }
 	const glm::vec2& ndcMousePos() const { return m_ndcMousePos; }
 	const glm::vec2& posDelta() const { return m_posDelta; }
+	const std::vector<glm::vec2>& ndcMouseSamples() const { return m_ndcMouseSamples; } // Every position of the mouse since last frame, oldest first
 	short wheelDelta() const { return m_wheelDelta; }
 
 private:
@@ -36,6 +37,7 @@ private:
 	glm::vec2 m_mousePos = { 0, 0 };
 	glm::vec2 m_ndcMousePos = { 0, 0 };
 	glm::vec2 m_posDelta = { 0, 0 };
+	std::vector<glm::vec2> m_ndcMouseSamples;
 	short m_wheelDelta = 0;
 
 private:
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <string>
+
+/**
+ * @brief State of the file loaded in the background
+ */
+class Loading {
+public:
+    Loading() {};
+
+    bool isLoading() const { return m_isLoading; }
+    float progress() const { return m_progress; }
+    const std::string& filePath() const { return m_filePath; }
+
+private:
+    std::string m_filePath; // Set to request a new file to load
+    bool m_isLoading = false;
+    float m_progress = 0.0f;
+
+private:
+    friend class MainMenuBarGui;
+    friend class LoadingSystem;
+};
@@ -0,0 +1,108 @@
+#include "clipboard.h"
+
+#include <algorithm>
+
+glm::ivec3 Clipboard::size(int quarterTurns) const {
+	if (quarterTurns & 1)
+		return glm::ivec3(m_size.z, m_size.y, m_size.x);
+	return m_size;
+}
+
+void Clipboard::copy(const VoxelGrid& grid, const Selection& selection) {
+	clear();
+
+	// The scene can change after the cells are selected
+	Selection copied = selection;
+	copied.intersect(grid);
+	glm::ivec3 min, max;
+	if (!copied.bounds(min, max))
+		return;
+	m_size = max - min + 1;
+
+	// Spans of a row in a chunk without voxels are skipped at once
+	for (int z = min.z; z <= max.z; z++) {
+		for (int y = min.y; y <= max.y; y++) {
+			int x = min.x;
+			while (x <= max.x) {
+				const glm::ivec3 pos(x, y, z);
+				const int spanEnd = std::min(max.x, (VoxelGrid::chunkPosition(pos).x + 1) * VoxelChunk::SIZE - 1);
+				const Selection::Words* words = copied.findChunk(pos);
+				const VoxelChunk* chunk = grid.findChunk(pos);
+				if (words == nullptr || chunk == nullptr) {
+					pushRun(EMPTY, spanEnd - x + 1);
+					x = spanEnd + 1;
+					continue;
+				}
+
+				for (; x <= spanEnd; x++) {
+					const unsigned int index = VoxelChunk::cellIndex(glm::ivec3(x, y, z));
+					const bool isCopied = ((*words)[index >> 6] >> (index & 63)) & 1;
+					pushRun(isCopied ? chunk->materials[index] : EMPTY, 1);
+				}
+			}
+		}
+	}
+	m_voxelCount = copied.size();
+	m_runs.shrink_to_fit();
+}
+
+void Clipboard::clear() {
+	m_size = glm::ivec3(0);
+	m_runs.clear();
+	m_voxelCount = 0;
+}
+
+void Clipboard::stamp(const glm::ivec3& origin, int quarterTurns, bool isMirrored, std::vector<glm::ivec3>& positions, std::vector<unsigned int>& materials) const {
+	positions.reserve(positions.size() + m_voxelCount);
+	materials.reserve(materials.size() + m_voxelCount);
+
+	// Each cell of the box is moved along the axes of the turned box
+	const glm::ivec3 last = m_size - 1;
+	glm::ivec3 xAxis(1, 0, 0), zAxis(0, 0, 1), corner(0);
+	if (isMirrored) {
+		xAxis.x = -1;
+		corner.x = last.x;
+	}
+	for (int i = 0; i < (quarterTurns & 3); i++) {
+		// (x, z) becomes (last z - z, x) in a box of (size z, size x)
+		const glm::ivec3 turnedLast = (i & 1) ? glm::ivec3(last.z, last.y, last.x) : last;
+		xAxis = glm::ivec3(-xAxis.z, 0, xAxis.x);
+		zAxis = glm::ivec3(-zAxis.z, 0, zAxis.x);
+		corner = glm::ivec3(turnedLast.z - corner.z, corner.y, corner.x);
+	}
+	const glm::ivec3 yAxis(0, 1, 0);
+
+	size_t cell = 0;
+	for (const Run& run : m_runs) {
+		if (run.material == EMPTY) {
+			cell += run.length;
+			continue;
+		}
+
+		// Only the first cell of the run is found by division
+		int x = static_cast<int>(cell % m_size.x);
+		int y = static_cast<int>((cell / m_size.x) % m_size.y);
+		int z = static_cast<int>(cell / (static_cast<size_t>(m_size.x) * m_size.y));
+		glm::ivec3 rowStart = origin + corner + y * yAxis + z * zAxis;
+		for (std::uint32_t i = 0; i < run.length; i++) {
+			positions.push_back(rowStart + x * xAxis);
+			materials.push_back(run.material);
+			if (++x == m_size.x) {
+				x = 0;
+				if (++y == m_size.y) {
+					y = 0;
+					z++;
+				}
+				rowStart = origin + corner + y * yAxis + z * zAxis;
+			}
+		}
+		cell += run.length;
+	}
+}
+
+void Clipboard::pushRun(std::uint16_t material, std::uint32_t length) {
+	if (!m_runs.empty() && m_runs.back().material == material)
+		m_runs.back().length += length;
+	else
+		m_runs.push_back({ length, material });
+}
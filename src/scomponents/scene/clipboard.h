@@ -0,0 +1,54 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <glm/glm.hpp>
+
+#include "scomponents/scene/voxel-grid.h"
+#include "scomponents/scene/selection.h"
+
+/**
+ * @brief Copied voxels, relative to their bounding box
+ * @note The cells of the box are run-length encoded row by row along x, so large uniform or empty areas take a few bytes.
+ */
+class Clipboard {
+public:
+	Clipboard() {};
+
+	bool empty() const { return m_voxelCount == 0; }
+	size_t voxelCount() const { return m_voxelCount; }
+	size_t runCount() const { return m_runs.size(); }
+
+	/**
+	 * @brief Number of cells of the bounding box on each axis, once turned
+	 */
+	glm::ivec3 size(int quarterTurns = 0) const;
+
+	/**
+	 * @brief Replace the content with the selected voxels of the grid
+	 */
+	void copy(const VoxelGrid& grid, const Selection& selection);
+	void clear();
+
+	/**
+	 * @brief Positions and materials of the copied voxels, placed with the smallest corner of their box at the origin
+	 * @param quarterTurns - Rotation around the y axis, applied after the mirror
+	 * @param isMirrored - Flip the x axis
+	 */
+	void stamp(const glm::ivec3& origin, int quarterTurns, bool isMirrored, std::vector<glm::ivec3>& positions, std::vector<unsigned int>& materials) const;
+
+private:
+	static constexpr std::uint16_t EMPTY = 0xFFFF; // Material of the runs of empty cells
+
+	struct Run {
+		std::uint32_t length;
+		std::uint16_t material;
+	};
+
+	void pushRun(std::uint16_t material, std::uint32_t length);
+
+private:
+	glm::ivec3 m_size = glm::ivec3(0);
+	std::vector<Run> m_runs; // Cells of the box, x first, then y, then z
+	size_t m_voxelCount = 0;
+};
@@ -0,0 +1,217 @@
+#include "selection.h"
+
+#include <limits>
+
+#include "maths/bits.h"
+
+namespace {
+	unsigned int wordsBitCount(const Selection::Words& words) {
+		unsigned int count = 0;
+		for (std::uint64_t word : words) {
+			count += voxmt::bitCount(word);
+		}
+		return count;
+	}
+}
+
+bool Selection::has(const glm::ivec3& pos) const {
+	const Words* words = findChunk(pos);
+	const unsigned int index = VoxelChunk::cellIndex(pos);
+	return words != nullptr && ((*words)[index >> 6] >> (index & 63)) & 1;
+}
+
+void Selection::insert(const glm::ivec3& pos) {
+	const unsigned int index = VoxelChunk::cellIndex(pos);
+	std::uint64_t& word = writableWords(pos)[index >> 6];
+	const std::uint64_t bit = std::uint64_t(1) << (index & 63);
+	if (!(word & bit)) {
+		word |= bit;
+		m_size++;
+	}
+}
+
+void Selection::insertChunk(const glm::ivec3& chunkPos, const Words& words) {
+	if (wordsBitCount(words) == 0)
+		return;
+
+	Chunk& chunk = m_chunks.try_emplace(VoxelGrid::chunkKey(chunkPos), Chunk { chunkPos, Words() }).first->second;
+	const unsigned int previousCount = wordsBitCount(chunk.words);
+	for (int i = 0; i < VoxelChunk::WORD_COUNT; i++) {
+		chunk.words[i] |= words[i];
+	}
+	m_size += wordsBitCount(chunk.words) - previousCount;
+}
+
+void Selection::erase(const glm::ivec3& pos) {
+	const auto it = m_chunks.find(VoxelGrid::chunkKey(VoxelGrid::chunkPosition(pos)));
+	if (it == m_chunks.end())
+		return;
+
+	const unsigned int index = VoxelChunk::cellIndex(pos);
+	std::uint64_t& word = it->second.words[index >> 6];
+	const std::uint64_t bit = std::uint64_t(1) << (index & 63);
+	if (word & bit) {
+		word &= ~bit;
+		m_size--;
+		if (wordsBitCount(it->second.words) == 0)
+			m_chunks.erase(it);
+	}
+}
+
+void Selection::clear() {
+	m_chunks.clear();
+	m_size = 0;
+}
+
+void Selection::unite(const Selection& other) {
+	for (const auto& otherChunk : other.m_chunks) {
+		insertChunk(otherChunk.second.position, otherChunk.second.words);
+	}
+}
+
+void Selection::intersect(const Selection& other) {
+	combine([&](const Chunk& chunk, Words& words) {
+		const auto it = other.m_chunks.find(VoxelGrid::chunkKey(chunk.position));
+		if (it == other.m_chunks.end()) {
+			words.fill(0);
+			return;
+		}
+		for (int i = 0; i < VoxelChunk::WORD_COUNT; i++) {
+			words[i] &= it->second.words[i];
+		}
+	});
+}
+
+void Selection::subtract(const Selection& other) {
+	combine([&](const Chunk& chunk, Words& words) {
+		const auto it = other.m_chunks.find(VoxelGrid::chunkKey(chunk.position));
+		if (it == other.m_chunks.end())
+			return;
+		for (int i = 0; i < VoxelChunk::WORD_COUNT; i++) {
+			words[i] &= ~it->second.words[i];
+		}
+	});
+}
+
+void Selection::selectAll(const VoxelGrid& grid) {
+	clear();
+	for (const auto& voxelChunk : grid.snapshot()) {
+		m_chunks.emplace(VoxelGrid::chunkKey(voxelChunk->position), Chunk { voxelChunk->position, voxelChunk->occupancy });
+		m_size += voxelChunk->count;
+	}
+}
+
+void Selection::intersect(const VoxelGrid& grid) {
+	combine([&](const Chunk& chunk, Words& words) {
+		const VoxelChunk* voxelChunk = grid.findChunk(chunk.position * VoxelChunk::SIZE);
+		if (voxelChunk == nullptr) {
+			words.fill(0);
+			return;
+		}
+		for (int i = 0; i < VoxelChunk::WORD_COUNT; i++) {
+			words[i] &= voxelChunk->occupancy[i];
+		}
+	});
+}
+
+void Selection::translate(const glm::ivec3& offset) {
+	if (offset == glm::ivec3(0))
+		return;
+
+	// Cells of a chunk land in at most 8 chunks, so the last one is kept
+	Selection moved;
+	glm::ivec3 movedChunkPos(std::numeric_limits<int>::max());
+	Words* movedWords = nullptr;
+	for (const auto& chunk : m_chunks) {
+		const glm::ivec3 origin = chunk.second.position * VoxelChunk::SIZE + offset;
+		for (int i = 0; i < VoxelChunk::WORD_COUNT; i++) {
+			std::uint64_t word = chunk.second.words[i];
+			while (word != 0) {
+				const glm::ivec3 pos = origin + VoxelChunk::cellOffset((i << 6) | voxmt::lowestBitIndex(word));
+				if (VoxelGrid::chunkPosition(pos) != movedChunkPos) {
+					movedChunkPos = VoxelGrid::chunkPosition(pos);
+					movedWords = &moved.writableWords(pos);
+				}
+				const unsigned int index = VoxelChunk::cellIndex(pos);
+				(*movedWords)[index >> 6] |= std::uint64_t(1) << (index & 63);
+				word &= word - 1;
+			}
+		}
+	}
+	moved.m_size = m_size;
+	*this = std::move(moved);
+}
+
+void Selection::positions(std::vector<glm::ivec3>& positions) const {
+	for (const auto& chunk : m_chunks) {
+		const glm::ivec3 origin = chunk.second.position * VoxelChunk::SIZE;
+		for (int i = 0; i < VoxelChunk::WORD_COUNT; i++) {
+			// Only the set bits are visited
+			std::uint64_t word = chunk.second.words[i];
+			while (word != 0) {
+				const unsigned int index = (i << 6) | voxmt::lowestBitIndex(word);
+				positions.push_back(origin + VoxelChunk::cellOffset(index));
+				word &= word - 1;
+			}
+		}
+	}
+}
+
+void Selection::chunkPositions(std::vector<glm::ivec3>& positions) const {
+	for (const auto& chunk : m_chunks) {
+		positions.push_back(chunk.second.position);
+	}
+}
+
+bool Selection::bounds(glm::ivec3& min, glm::ivec3& max) const {
+	if (empty())
+		return false;
+
+	min = glm::ivec3(std::numeric_limits<int>::max());
+	max = glm::ivec3(std::numeric_limits<int>::min());
+	for (const auto& chunk : m_chunks) {
+		const glm::ivec3 origin = chunk.second.position * VoxelChunk::SIZE;
+
+		// Chunks inside the current bounds cannot extend them
+		if (glm::all(glm::greaterThanEqual(origin, min)) && glm::all(glm::lessThanEqual(origin + (VoxelChunk::SIZE - 1), max)))
+			continue;
+
+		for (int i = 0; i < VoxelChunk::WORD_COUNT; i++) {
+			std::uint64_t word = chunk.second.words[i];
+			while (word != 0) {
+				const glm::ivec3 pos = origin + VoxelChunk::cellOffset((i << 6) | voxmt::lowestBitIndex(word));
+				min = glm::min(min, pos);
+				max = glm::max(max, pos);
+				word &= word - 1;
+			}
+		}
+	}
+	return true;
+}
+
+const Selection::Words* Selection::findChunk(const glm::ivec3& pos) const {
+	const auto it = m_chunks.find(VoxelGrid::chunkKey(VoxelGrid::chunkPosition(pos)));
+	if (it == m_chunks.end())
+		return nullptr;
+	return &it->second.words;
+}
+
+Selection::Words& Selection::writableWords(const glm::ivec3& pos) {
+	const glm::ivec3 chunkPos = VoxelGrid::chunkPosition(pos);
+	return m_chunks.try_emplace(VoxelGrid::chunkKey(chunkPos), Chunk { chunkPos, Words() }).first->second.words;
+}
+
+template<typename F>
+void Selection::combine(F f) {
+	m_size = 0;
+	for (auto it = m_chunks.begin(); it != m_chunks.end();) {
+		f(it->second, it->second.words);
+		const unsigned int count = wordsBitCount(it->second.words);
+		if (count == 0) {
+			it = m_chunks.erase(it);
+		} else {
+			m_size += count;
+			++it;
+		}
+	}
+}
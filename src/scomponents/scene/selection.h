@@ -0,0 +1,94 @@
+#pragma once
+
+#include <array>
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+#include <glm/glm.hpp>
+
+#include "scomponents/scene/voxel-grid.h"
+
+/**
+ * @brief Set of cells of the scene, stored as one bitset per chunk of the voxel grid
+ * @note Set operations are done on whole words of 64 cells, in loops which compilers vectorize.
+ */
+class Selection {
+public:
+	using Words = std::array<std::uint64_t, VoxelChunk::WORD_COUNT>;
+
+	Selection() {};
+
+	bool has(const glm::ivec3& pos) const;
+	size_t size() const { return m_size; }
+	bool empty() const { return m_size == 0; }
+	size_t chunkCount() const { return m_chunks.size(); }
+
+	void insert(const glm::ivec3& pos);
+
+	/**
+	 * @brief Add the cells whose bit is set, in the chunk at the given position
+	 * @param chunkPos - In chunk units
+	 */
+	void insertChunk(const glm::ivec3& chunkPos, const Words& words);
+	void erase(const glm::ivec3& pos);
+	void clear();
+
+	void unite(const Selection& other);
+	void intersect(const Selection& other);
+	void subtract(const Selection& other);
+
+	/**
+	 * @brief Select every voxel of the grid
+	 */
+	void selectAll(const VoxelGrid& grid);
+
+	/**
+	 * @brief Only keep the cells which hold a voxel, as the scene can change after they are selected
+	 */
+	void intersect(const VoxelGrid& grid);
+
+	/**
+	 * @brief Move every cell by the offset
+	 */
+	void translate(const glm::ivec3& offset);
+
+	/**
+	 * @brief Add the positions of the selected cells, chunk by chunk
+	 */
+	void positions(std::vector<glm::ivec3>& positions) const;
+
+	/**
+	 * @brief Add the positions of the chunks with selected cells, in chunk units
+	 */
+	void chunkPositions(std::vector<glm::ivec3>& positions) const;
+
+	/**
+	 * @brief Smallest box holding the selected cells, both corners included
+	 * @return false if the selection is empty
+	 */
+	bool bounds(glm::ivec3& min, glm::ivec3& max) const;
+
+	/**
+	 * @brief Bits of the chunk holding the cell, to test many cells without looking up each one
+	 * @return nullptr if no cell of the chunk is selected
+	 */
+	const Words* findChunk(const glm::ivec3& pos) const;
+
+private:
+	struct Chunk {
+		glm::ivec3 position; // In chunk units
+		Words words;
+	};
+
+	Words& writableWords(const glm::ivec3& pos);
+
+	/**
+	 * @brief Apply the operation to each word of the chunks, then drop the chunks left empty
+	 */
+	template<typename F>
+	void combine(F f);
+
+private:
+	std::unordered_map<std::uint64_t, Chunk> m_chunks; // By chunk key, without empty chunks
+	size_t m_size = 0;
+};
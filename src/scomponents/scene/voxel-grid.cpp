@@ -0,0 +1,254 @@
+#include "voxel-grid.h"
+
+#include <cassert>
+#include <algorithm>
+#include <cstring>
+
+#include "maths/bits.h"
+
+namespace {
+	using Words = std::array<std::uint64_t, VoxelChunk::WORD_COUNT>;
+
+	/**
+	 * @brief Copy the materials of the cells whose bit is set, 64 bytes at once for full words
+	 */
+	void copyMaterials(VoxelChunk& to, const VoxelChunk& from, const Words& mask) {
+		for (int i = 0; i < VoxelChunk::WORD_COUNT; i++) {
+			std::uint64_t word = mask[i];
+			if (word == ~std::uint64_t(0)) {
+				std::memcpy(&to.materials[i << 6], &from.materials[i << 6], 64);
+				continue;
+			}
+			while (word != 0) {
+				const unsigned int index = (i << 6) | voxmt::lowestBitIndex(word);
+				to.materials[index] = from.materials[index];
+				word &= word - 1;
+			}
+		}
+	}
+
+	bool isEmpty(const Words& words) {
+		std::uint64_t any = 0;
+		for (std::uint64_t word : words) {
+			any |= word;
+		}
+		return any == 0;
+	}
+}
+
+VoxelGrid::VoxelGrid(const Snapshot& chunks) {
+	for (const auto& chunk : chunks) {
+		// Shared chunks are copied before being modified
+		m_chunks[chunkKey(chunk->position)] = std::const_pointer_cast<VoxelChunk>(chunk);
+		m_size += chunk->count;
+		m_version = std::max(m_version, chunk->version);
+	}
+}
+
+met::entity VoxelGrid::at(const glm::ivec3& pos) const {
+	const VoxelChunk* chunk = findChunk(pos);
+	if (chunk == nullptr)
+		return met::null;
+	return chunk->entities[VoxelChunk::cellIndex(pos)];
+}
+
+bool VoxelGrid::has(const glm::ivec3& pos) const {
+	const VoxelChunk* chunk = findChunk(pos);
+	return chunk != nullptr && chunk->has(VoxelChunk::cellIndex(pos));
+}
+
+unsigned int VoxelGrid::material(const glm::ivec3& pos) const {
+	const VoxelChunk* chunk = findChunk(pos);
+	assert(chunk != nullptr && chunk->has(VoxelChunk::cellIndex(pos)) && "There is no voxel at this position");
+	return chunk->materials[VoxelChunk::cellIndex(pos)];
+}
+
+void VoxelGrid::insert(const glm::ivec3& pos, met::entity id, unsigned int material) {
+	assert(material < 256 && "Material index must fit in a byte");
+	VoxelChunk& chunk = writableChunk(pos);
+	const unsigned int index = VoxelChunk::cellIndex(pos);
+	if (!chunk.has(index)) {
+		chunk.occupancy[index >> 6] |= std::uint64_t(1) << (index & 63);
+		chunk.count++;
+		m_size++;
+	}
+	chunk.entities[index] = id;
+	chunk.materials[index] = static_cast<unsigned char>(material);
+}
+
+void VoxelGrid::erase(const glm::ivec3& pos) {
+	if (!has(pos))
+		return;
+
+	VoxelChunk& chunk = writableChunk(pos);
+	const unsigned int index = VoxelChunk::cellIndex(pos);
+	chunk.occupancy[index >> 6] &= ~(std::uint64_t(1) << (index & 63));
+	chunk.entities[index] = met::null;
+	chunk.materials[index] = 0;
+	chunk.count--;
+	m_size--;
+
+	if (chunk.count == 0)
+		m_chunks.erase(chunkKey(chunk.position));
+}
+
+void VoxelGrid::paint(const glm::ivec3& pos, unsigned int material) {
+	assert(has(pos) && "There is no voxel at this position");
+	writableChunk(pos).materials[VoxelChunk::cellIndex(pos)] = static_cast<unsigned char>(material);
+}
+
+void VoxelGrid::clear() {
+	m_chunks.clear();
+	m_size = 0;
+	m_version++;
+}
+
+void VoxelGrid::unite(const VoxelGrid& other, bool isReplacing) {
+	for (const auto& it : other.m_chunks) {
+		const VoxelChunk& from = *it.second;
+		const glm::ivec3 origin = from.position * VoxelChunk::SIZE;
+
+		// New chunks are copied whole, with their own version for the writers caching chunks
+		const auto found = m_chunks.find(it.first);
+		if (found == m_chunks.end()) {
+			std::shared_ptr<VoxelChunk> chunk = std::make_shared<VoxelChunk>(from);
+			chunk->version = ++m_version;
+			m_chunks[it.first] = chunk;
+			m_size += chunk->count;
+			continue;
+		}
+
+		Words added, copied;
+		for (int i = 0; i < VoxelChunk::WORD_COUNT; i++) {
+			added[i] = from.occupancy[i] & ~found->second->occupancy[i];
+			copied[i] = isReplacing ? from.occupancy[i] : added[i];
+		}
+		if (isEmpty(copied))
+			continue;
+
+		VoxelChunk& to = writableChunk(origin);
+		unsigned int count = 0;
+		for (int i = 0; i < VoxelChunk::WORD_COUNT; i++) {
+			to.occupancy[i] |= added[i];
+			count += voxmt::bitCount(to.occupancy[i]);
+		}
+		copyMaterials(to, from, copied);
+		m_size += count - to.count;
+		to.count = count;
+	}
+}
+
+void VoxelGrid::subtract(const VoxelGrid& other) {
+	for (const auto& it : other.m_chunks) {
+		const auto found = m_chunks.find(it.first);
+		if (found == m_chunks.end())
+			continue;
+
+		Words removed;
+		for (int i = 0; i < VoxelChunk::WORD_COUNT; i++) {
+			removed[i] = found->second->occupancy[i] & it.second->occupancy[i];
+		}
+		if (!isEmpty(removed))
+			eraseCells(writableChunk(found->second->position * VoxelChunk::SIZE), removed);
+	}
+}
+
+void VoxelGrid::intersect(const VoxelGrid& other, bool isReplacing) {
+	// Chunks are erased while iterating, so their positions are read first
+	std::vector<glm::ivec3> positions;
+	positions.reserve(m_chunks.size());
+	for (const auto& it : m_chunks) {
+		positions.push_back(it.second->position);
+	}
+
+	for (const glm::ivec3& position : positions) {
+		const glm::ivec3 origin = position * VoxelChunk::SIZE;
+		const VoxelChunk* from = other.findChunk(origin);
+		if (from == nullptr) {
+			m_size -= m_chunks.at(chunkKey(position))->count;
+			m_chunks.erase(chunkKey(position));
+			m_version++;
+			continue;
+		}
+
+		const VoxelChunk& current = *m_chunks.at(chunkKey(position));
+		Words removed, kept;
+		for (int i = 0; i < VoxelChunk::WORD_COUNT; i++) {
+			removed[i] = current.occupancy[i] & ~from->occupancy[i];
+			kept[i] = current.occupancy[i] & from->occupancy[i];
+		}
+		if (isEmpty(removed) && !isReplacing)
+			continue;
+
+		VoxelChunk& to = writableChunk(origin);
+		if (isReplacing)
+			copyMaterials(to, *from, kept);
+		eraseCells(to, removed);
+	}
+}
+
+VoxelGrid::Snapshot VoxelGrid::snapshot() const {
+	Snapshot chunks;
+	chunks.reserve(m_chunks.size());
+	for (const auto& chunk : m_chunks) {
+		chunks.push_back(chunk.second);
+	}
+	return chunks;
+}
+
+std::uint64_t VoxelGrid::chunkKey(const glm::ivec3& chunkPos) {
+	// 21 bits per axis is enough for positions up to +-2^24
+	const std::uint64_t mask = (std::uint64_t(1) << 21) - 1;
+	return (static_cast<std::uint64_t>(chunkPos.x) & mask)
+		| ((static_cast<std::uint64_t>(chunkPos.y) & mask) << 21)
+		| ((static_cast<std::uint64_t>(chunkPos.z) & mask) << 42);
+}
+
+const VoxelChunk* VoxelGrid::findChunk(const glm::ivec3& pos) const {
+	const auto it = m_chunks.find(chunkKey(chunkPosition(pos)));
+	if (it == m_chunks.end())
+		return nullptr;
+	return it->second.get();
+}
+
+VoxelChunk& VoxelGrid::writableChunk(const glm::ivec3& pos) {
+	const glm::ivec3 chunkPos = chunkPosition(pos);
+	std::shared_ptr<VoxelChunk>& chunk = m_chunks[chunkKey(chunkPos)];
+
+	if (chunk == nullptr) {
+		chunk = std::make_shared<VoxelChunk>(chunkPos);
+	} else if (chunk.use_count() > 1) {
+		// A snapshot still reads this chunk, so it is copied instead of being modified
+		chunk = std::make_shared<VoxelChunk>(*chunk);
+	}
+
+	chunk->version = ++m_version;
+	return *chunk;
+}
+
+void VoxelGrid::eraseCells(VoxelChunk& chunk, const std::array<std::uint64_t, VoxelChunk::WORD_COUNT>& mask) {
+	unsigned int count = 0;
+	for (int i = 0; i < VoxelChunk::WORD_COUNT; i++) {
+		std::uint64_t word = mask[i];
+		chunk.occupancy[i] &= ~word;
+		count += voxmt::bitCount(chunk.occupancy[i]);
+
+		// Empty cells have no entity and the first material, as after erase
+		if (word == ~std::uint64_t(0)) {
+			std::fill_n(&chunk.entities[i << 6], 64, met::null);
+			std::memset(&chunk.materials[i << 6], 0, 64);
+			continue;
+		}
+		while (word != 0) {
+			const unsigned int index = (i << 6) | voxmt::lowestBitIndex(word);
+			chunk.entities[index] = met::null;
+			chunk.materials[index] = 0;
+			word &= word - 1;
+		}
+	}
+	m_size -= chunk.count - count;
+	chunk.count = count;
+
+	if (count == 0)
+		m_chunks.erase(chunkKey(chunk.position));
+}
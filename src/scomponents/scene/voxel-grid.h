@@ -0,0 +1,130 @@
+#pragma once
+
+#include <array>
+#include <vector>
+#include <memory>
+#include <unordered_map>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <met/met.hpp>
+
+/**
+ * @brief Cubic block of cells of the voxel grid
+ * @note Shared with grid snapshots, so it is never modified while a snapshot still holds it.
+ */
+struct VoxelChunk {
+	static constexpr int SIZE_SHIFT = 4;
+	static constexpr int SIZE = 1 << SIZE_SHIFT;
+	static constexpr int VOLUME = SIZE * SIZE * SIZE;
+	static constexpr int WORD_COUNT = VOLUME / 64;
+
+	VoxelChunk(const glm::ivec3& pos = glm::ivec3(0)) : position(pos) {
+		occupancy.fill(0);
+		entities.fill(met::null);
+		materials.fill(0);
+	}
+
+	bool has(unsigned int index) const { return (occupancy[index >> 6] >> (index & 63)) & 1; }
+
+	/**
+	 * @brief Position of the cell in the 3d grid
+	 */
+	glm::ivec3 cellPosition(unsigned int index) const { return position * SIZE + cellOffset(index); }
+
+	static glm::ivec3 cellOffset(unsigned int index) {
+		return glm::ivec3(index & (SIZE - 1), (index >> SIZE_SHIFT) & (SIZE - 1), index >> (2 * SIZE_SHIFT));
+	}
+
+	static unsigned int cellIndex(const glm::ivec3& pos) {
+		return (pos.x & (SIZE - 1)) | ((pos.y & (SIZE - 1)) << SIZE_SHIFT) | ((pos.z & (SIZE - 1)) << (2 * SIZE_SHIFT));
+	}
+
+	glm::ivec3 position; // In chunk units
+	unsigned int count = 0;
+	unsigned int version = 0;
+	std::array<std::uint64_t, WORD_COUNT> occupancy;
+	std::array<met::entity, VOLUME> entities; // met::null for voxels which are not in a registry
+	std::array<unsigned char, VOLUME> materials;
+};
+
+/**
+ * @brief Chunked lookup table of the voxels, giving O(1) access to the entity at a position.
+ * @note Chunks are copied on write, so a snapshot is only a list of shared pointers and can be read from another thread.
+ */
+class VoxelGrid {
+public:
+	using Snapshot = std::vector<std::shared_ptr<const VoxelChunk>>;
+
+	VoxelGrid() {};
+
+	/**
+	 * @brief Share the chunks of a snapshot. They are copied when modified.
+	 */
+	explicit VoxelGrid(const Snapshot& chunks);
+
+	met::entity at(const glm::ivec3& pos) const;
+	bool has(const glm::ivec3& pos) const;
+	unsigned int material(const glm::ivec3& pos) const;
+	size_t size() const { return m_size; }
+	size_t chunkCount() const { return m_chunks.size(); }
+
+	/**
+	 * @brief Incremented on every change. Chunks store the value they had on their last change.
+	 */
+	unsigned int version() const { return m_version; }
+
+	void insert(const glm::ivec3& pos, met::entity id, unsigned int material);
+	void erase(const glm::ivec3& pos);
+	void paint(const glm::ivec3& pos, unsigned int material);
+	void clear();
+
+	/**
+	 * @brief Add the voxels of the other grid, one occupancy word of 64 cells at a time
+	 * @param isReplacing - Cells used in both grids take the material of the other one
+	 * @note Voxels are added without entity, so the scene is only changed this way on a copy, to find the cells to edit.
+	 */
+	void unite(const VoxelGrid& other, bool isReplacing);
+
+	/**
+	 * @brief Remove the voxels in the cells used by the other grid
+	 */
+	void subtract(const VoxelGrid& other);
+
+	/**
+	 * @brief Only keep the voxels in the cells used by the other grid
+	 * @param isReplacing - Kept voxels take the material of the other grid
+	 */
+	void intersect(const VoxelGrid& other, bool isReplacing);
+
+	/**
+	 * @brief Get a read-only copy of the current state of the grid. Its cost is one pointer copy per chunk.
+	 */
+	Snapshot snapshot() const;
+
+	static glm::ivec3 chunkPosition(const glm::ivec3& pos) { return glm::ivec3(pos.x >> VoxelChunk::SIZE_SHIFT, pos.y >> VoxelChunk::SIZE_SHIFT, pos.z >> VoxelChunk::SIZE_SHIFT); }
+	static std::uint64_t chunkKey(const glm::ivec3& chunkPos);
+
+	/**
+	 * @brief Chunk holding the cell, to read many neighbour cells without looking up each one
+	 * @return nullptr if the chunk has no voxel
+	 */
+	const VoxelChunk* findChunk(const glm::ivec3& pos) const;
+
+	/**
+	 * @brief Key of a cell for hash maps, with the same packing as the chunks. Valid for positions up to +-2^20.
+	 */
+	static std::uint64_t cellKey(const glm::ivec3& pos) { return chunkKey(pos); }
+
+private:
+	VoxelChunk& writableChunk(const glm::ivec3& pos);
+
+	/**
+	 * @brief Clear the cells of the chunk whose bit is set in the mask, then drop the chunk if it is left empty
+	 */
+	void eraseCells(VoxelChunk& chunk, const std::array<std::uint64_t, VoxelChunk::WORD_COUNT>& mask);
+
+private:
+	std::unordered_map<std::uint64_t, std::shared_ptr<VoxelChunk>> m_chunks;
+	size_t m_size = 0;
+	unsigned int m_version = 0;
+};
@@ -13,8 +13,15 @@
 #include "scomponents/io/hovered.h"
 #include "scomponents/io/viewport.h"
 #include "scomponents/io/brush.h"
+#include "scomponents/io/brush-preview.h"
+#include "scomponents/io/loading.h"
+#include "scomponents/io/gui-commands.h"
 #include "scomponents/graphics/ui-style.h"
 
+#include "scomponents/scene/voxel-grid.h"
+#include "scomponents/scene/selection.h"
+#include "scomponents/scene/clipboard.h"
+
 /**
  * @brief Global object used to store the state of the app. 
  * @note Only store data, it has no logic. Read-only for vast-majority of systems.
@@ -38,4 +45,12 @@ struct SingletonComponents {
 	Hovered hovered;
 	Viewport viewport;
 	Brush brush;
+	BrushPreview brushPreview;
+	Loading loading;
+	GuiCommands guiCommands;
+
+	// Scene
+	VoxelGrid voxelGrid;
+	Selection selection;
+	Clipboard clipboard;
 };
@@ -0,0 +1,48 @@
+#include "autosave-system.h"
+
+#include <profiling/instrumentor.h>
+#include <spdlog/spdlog.h>
+#include <vector>
+
+namespace {
+    const std::chrono::seconds saveInterval(60);
+}
+
+AutosaveSystem::AutosaveSystem(Context& ctx, SingletonComponents& scomps) 
+    : m_ctx(ctx), m_scomps(scomps), m_writer("autosave/autosave.cbe"), m_lastSave(std::chrono::steady_clock::now()), m_savedVersion(0) {}
+
+AutosaveSystem::~AutosaveSystem() {
+    if (m_job.valid())
+        m_job.wait();
+}
+
+void AutosaveSystem::update() {
+    PROFILE_SCOPE("AutosaveSystem update");
+
+    // The writer is only used by one job at a time
+    if (m_job.valid()) {
+        if (m_job.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+            return;
+        // Saved again at the next interval
+        if (!m_job.get())
+            m_savedVersion = 0;
+    }
+
+    const auto now = std::chrono::steady_clock::now();
+    if (now - m_lastSave < saveInterval || m_scomps.voxelGrid.version() == m_savedVersion)
+        return;
+
+    m_lastSave = now;
+    m_savedVersion = m_scomps.voxelGrid.version();
+    VoxelGrid::Snapshot snapshot = m_scomps.voxelGrid.snapshot();
+    std::vector<cb::perMaterialChange> palette(m_scomps.materials.begin(), m_scomps.materials.end());
+
+    m_job = std::async(std::launch::async, [this, snapshot = std::move(snapshot), palette = std::move(palette)]() {
+        if (!m_writer.writeFile(snapshot, palette)) {
+            spdlog::warn("[Autosave] Scene not saved");
+            return false;
+        }
+        spdlog::info("[Autosave] Scene saved");
+        return true;
+    });
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <future>
+#include <chrono>
+
+#include "i-system.h"
+#include "context.h"
+#include "loaders/cbe-writer.h"
+
+/**
+ * @brief Periodically save the scene on a worker thread while editing continues
+ * @note Only a copy-on-write snapshot of the voxel grid is taken on the main thread.
+ */
+class AutosaveSystem : public ISystem {
+public:
+    AutosaveSystem(Context& ctx, SingletonComponents& scomps);
+    virtual ~AutosaveSystem();
+
+    void update() override;
+
+private:
+    Context& m_ctx;
+    SingletonComponents& m_scomps;
+    CbeWriter m_writer;
+    std::future<bool> m_job;
+    std::chrono::steady_clock::time_point m_lastSave;
+    unsigned int m_savedVersion;
+};
@@ -1,183 +1,551 @@
 #include "brush-system.h"
 
 #include <profiling/instrumentor.h>
+#include <spdlog/spdlog.h>
 #include <algorithm>
+#include <cmath>
 
-#include "components/physics/transform.h"
-#include "components/graphics/material.h"
+#include "history/brushes/brush-history.h"
+#include "history/csg/csg-history.h"
+#include "history/selection/paste-history.h"
+#include "maths/rasterization.h"
+#include "scene/face-region.h"
+#include "scene/flood-fill.h"
+#include "scene/morphology.h"
+#include "scene/ray-picking.h"
+#include "scene/screen-selection.h"
 
-BrushSystem::BrushSystem(Context& ctx, SingletonComponents& scomps) : m_ctx(ctx), m_scomps(scomps) {}
+BrushSystem::BrushSystem(Context& ctx, SingletonComponents& scomps) 
+    : m_ctx(ctx), m_scomps(scomps), m_isEditing(false), m_hasStart(false), m_startPos(0), m_box({ glm::ivec3(0), glm::ivec3(0) }), m_lineEnd(0), m_radius(-1), m_circleNormal(-1), m_strokeEnd(0), m_strokeNormal(0) {}
 
 BrushSystem::~BrushSystem() {}
 
 void BrushSystem::update() {
     PROFILE_SCOPE("BrushSystem update");
 
-    if (!m_scomps.brush.started() && m_tempAddedPos.size() > 0)
-        m_tempAddedPos.clear();
+    // The scene is replaced when loading ends, so the pending edit is dropped
+    if (m_scomps.loading.isLoading()) {
+        if (m_isEditing)
+            endEdit();
+        return;
+    }
+
+    if (!m_scomps.brush.started()) {
+        if (m_isEditing) {
+            commitPreview();
+            endEdit();
+        }
+        return;
+    }
+
+    if (!m_isEditing) {
+        m_scomps.brushPreview.m_usage = m_scomps.brush.usage();
+        m_scomps.brushPreview.m_material = m_scomps.materials.selectedIndex();
+        m_isEditing = true;
+    }
+
+    // Screen selections do not need a hovered voxel
+    if (m_scomps.brush.type() == BrushType::MARQUEE || m_scomps.brush.type() == BrushType::LASSO) {
+        if (m_scomps.brushPreview.usage() == BrushUse::SELECT)
+            outlineBrush();
+        return;
+    }
 
-    if (m_scomps.hovered.exist() && m_scomps.brush.started()) {
+    if (m_scomps.hovered.exist()) {
         switch (m_scomps.brush.type()) {
             case BrushType::VOXEL: voxelBrush(); break;
             case BrushType::BOX: boxBrush(); break;
+            case BrushType::LINE: lineBrush(); break;
+            case BrushType::CIRCLE: circleBrush(); break;
+            case BrushType::FACE: faceBrush(); break;
+            case BrushType::FILL: fillBrush(); break;
+            case BrushType::STAMP: case BrushType::FILTER: pressBrush(); break;
             default: break;
         }
     }
 }
 
 void BrushSystem::voxelBrush() {
-    PROFILE_SCOPE("VoxelBrush update");    
+    PROFILE_SCOPE("VoxelBrush update");
 
-    comp::Transform trans;
-    trans.position = m_scomps.hovered.position();
+    const bool isAdding = m_scomps.brushPreview.usage() == BrushUse::ADD;
 
-    for (const glm::ivec3& pos : m_tempAddedPos) {
-        if (pos == trans.position) {
-            return;
+    // The hovered cell is only read once per frame, so every mouse position since the last one is picked on the grid
+    {
+        PROFILE_SCOPE("VoxelBrush pick samples");
+        const glm::mat4 toWorld = glm::inverse(m_scomps.camera.proj() * m_scomps.camera.view());
+        glm::ivec3 position, normal;
+        for (const glm::vec2& sample : m_scomps.inputs.ndcMouseSamples()) {
+            glm::vec4 from = toWorld * glm::vec4(sample, -1.0f, 1.0f);
+            glm::vec4 to = toWorld * glm::vec4(sample, 1.0f, 1.0f);
+            from /= from.w;
+            to /= to.w;
+            if (pickVoxel(m_scomps.voxelGrid, from, to, position, normal))
+                strokeTo(isAdding ? position + normal : position, normal);
         }
     }
 
-    if (m_scomps.hovered.isCube()) {
-        switch (m_scomps.hovered.face()) {
-        case Face::FRONT: trans.position.z--; break;
-        case Face::BACK: trans.position.z++; break;
-        case Face::RIGHT: trans.position.x++; break;
-        case Face::LEFT: trans.position.x--; break;
-        case Face::TOP: trans.position.y++; break;
-        case Face::BOTTOM: trans.position.y--; break;
-        case Face::NONE: break;
-        default:
-            assert(false && "Unknown hovered face");
-        }
-    }
+    // The ground has no voxel to pick, it is only found by the hovered cell
+    if (isAdding)
+        strokeTo(hoveredNeighbour(), faceNormal(m_scomps.hovered.face()));
+    else if (m_scomps.hovered.isCube())
+        strokeTo(m_scomps.hovered.position(), hoveredNormal());
+}
 
-    switch (m_scomps.brush.usage()) {
-    case BrushUse::ADD: {
-        met::entity entity = m_ctx.registry.create();
-        comp::Material material;
-        material.sIndex = m_scomps.materials.selectedIndex();
-        m_ctx.registry.assign<comp::Material>(entity, material);
-        m_ctx.registry.assign<comp::Transform>(entity, trans);
-        m_tempAddedPos.push_back(trans.position);
-        break;
-    }
-        
-    case BrushUse::REMOVE:
-        if (m_scomps.hovered.isCube())
-            m_ctx.registry.destroy(m_scomps.hovered.id());
-        break;
-
-    case BrushUse::PAINT:
-        if (m_scomps.hovered.isCube()) {
-            auto& material = m_ctx.registry.get<comp::Material>(m_scomps.hovered.id());
-            material.sIndex = m_scomps.materials.selectedIndex();
-        }
-        break;
+void BrushSystem::strokeTo(const glm::ivec3& target, const glm::ivec3& normal) {
+    if (m_hasStart && target == m_strokeEnd)
+        return;
 
-    default: break;
+    // Cells are joined on the plane of the stroke. It is not done across the edges of the surface, where the line would cross the void.
+    const glm::ivec3 offset = (target - m_strokeEnd) * normal;
+    const bool isOnSamePlane = m_hasStart && normal != glm::ivec3(0) && glm::abs(normal) == glm::abs(m_strokeNormal) && offset.x + offset.y + offset.z == 0;
+    if (isOnSamePlane) {
+        m_cells.clear();
+        voxmt::rasterizeLine(m_strokeEnd, target, m_cells);
+        for (const glm::ivec3& cell : m_cells) {
+            previewCell(cell);
+        }
+    } else {
+        previewCell(target);
     }
+
+    m_strokeEnd = target;
+    m_strokeNormal = normal;
+    m_hasStart = true;
 }
 
 void BrushSystem::boxBrush() {
     PROFILE_SCOPE("BoxBrush update");
 
-    glm::ivec3 endPos = m_scomps.hovered.position();
-    glm::ivec3 startPos;
-    if (m_tempAddedPos.size() >= 1)
-        startPos = m_tempAddedPos.at(0);
-    else
-        startPos = endPos;
+    const glm::ivec3 endPos = hoveredNeighbour();
 
-    if (m_scomps.hovered.isCube()) {
-        switch (m_scomps.hovered.face()) {
-        case Face::FRONT: endPos.z--; break;
-        case Face::BACK: endPos.z++; break;
-        case Face::RIGHT: endPos.x++; break;
-        case Face::LEFT: endPos.x--; break;
-        case Face::TOP: endPos.y++; break;
-        case Face::BOTTOM: endPos.y--; break;
-        case Face::NONE: break;
-        default:
-            assert(false && "Unknown hovered face");
-        }
+    if (!m_hasStart)
+        m_startPos = endPos;
+
+    const CellBox box = { glm::min(m_startPos, endPos), glm::max(m_startPos, endPos) };
+    if (m_hasStart && box.min == m_box.min && box.max == m_box.max)
+        return;
+
+    // An empty box, as min is greater than max
+    const CellBox previousBox = m_hasStart ? m_box : CellBox { glm::ivec3(1), glm::ivec3(0) };
+
+    {
+        PROFILE_SCOPE("BoxBrush revert");
+        forEachCellOutside(previousBox, box, [this](const glm::ivec3& pos) { unpreviewCell(pos); });
+    }
+    {
+        PROFILE_SCOPE("BoxBrush apply");
+        forEachCellOutside(box, previousBox, [this](const glm::ivec3& pos) { previewCell(pos); });
     }
 
-    if (startPos.x > endPos.x) { std::swap(startPos.x, endPos.x); }
-    if (startPos.y > endPos.y) { std::swap(startPos.y, endPos.y); }
-    if (startPos.z > endPos.z) { std::swap(startPos.z, endPos.z); }
+    m_box = box;
+    m_hasStart = true;
+}
+
+void BrushSystem::lineBrush() {
+    PROFILE_SCOPE("LineBrush update");
 
-    // Fill selection area
-    std::vector<glm::ivec3> selectedArea;
-    for (size_t x = startPos.x; x <= endPos.x; x++) {
-        for (size_t y = startPos.y; y <= endPos.y; y++) {
-            for (size_t z = startPos.z; z <= endPos.z; z++) {
-                selectedArea.push_back(glm::ivec3(x, y, z));
+    const glm::ivec3 endPos = m_scomps.brushPreview.usage() == BrushUse::ADD ? hoveredNeighbour() : m_scomps.hovered.position();
+    if (!m_hasStart)
+        m_startPos = endPos;
+    else if (endPos == m_lineEnd)
+        return;
+
+    m_hasStart = true;
+    m_lineEnd = endPos;
+
+    // The segment is previewed again, its cost only depends on its length
+    clearPreview();
+    m_cells.clear();
+    voxmt::rasterizeLine(m_startPos, endPos, m_cells);
+
+    const int size = m_scomps.brush.size();
+    const glm::ivec3 minOffset = glm::ivec3(-(size - 1) / 2);
+    const glm::ivec3 maxOffset = glm::ivec3(size / 2);
+    for (const glm::ivec3& cell : m_cells) {
+        for (int x = minOffset.x; x <= maxOffset.x; x++) {
+            for (int y = minOffset.y; y <= maxOffset.y; y++) {
+                for (int z = minOffset.z; z <= maxOffset.z; z++) {
+                    previewCell(cell + glm::ivec3(x, y, z));
+                }
             }
         }
     }
+}
 
-    switch (m_scomps.brush.usage()) {
-    case BrushUse::ADD: {
-        PROFILE_SCOPE("BoxBrush add");
-        // TODO use a LUT in scomps for O(1) access to pos instead of O(n)
-        for (const glm::ivec3& checkPos : selectedArea) {
-            bool exist = false;
-            m_ctx.registry.view<comp::Transform>().each([&](met::entity entity, comp::Transform& transform) {
-                if (checkPos == transform.position) {
-                    exist = true;
-                }
-            });
-
-            if (!exist) {
-                met::entity entity = m_ctx.registry.create();
-                comp::Material material;
-                comp::Transform trans;
-                trans.position = checkPos;
-                material.sIndex = m_scomps.materials.selectedIndex();
-                m_ctx.registry.assign<comp::Material>(entity, material);
-                m_ctx.registry.assign<comp::Transform>(entity, trans);
-                m_tempAddedPos.push_back(trans.position);
-            }
+void BrushSystem::circleBrush() {
+    PROFILE_SCOPE("CircleBrush update");
+
+    const glm::ivec3 target = m_scomps.brushPreview.usage() == BrushUse::ADD ? hoveredNeighbour() : m_scomps.hovered.position();
+    if (!m_hasStart) {
+        m_startPos = target;
+        m_radius = -1;
+        m_hasStart = true;
+
+        // Discs face the pressed face
+        switch (m_scomps.hovered.face()) {
+        case Face::FRONT: case Face::BACK: m_circleNormal = 2; break;
+        case Face::RIGHT: case Face::LEFT: m_circleNormal = 0; break;
+        default: m_circleNormal = 1; break;
         }
-        break;
-    }
-
-    case BrushUse::REMOVE : {
-        PROFILE_SCOPE("BoxBrush remove");
-        // TODO use a LUT in scomps for O(1) access to pos instead of O(n)
-        std::vector<met::entity> idToDestroy;
-        m_ctx.registry.view<comp::Transform>().each([&](met::entity entity, comp::Transform& transform) {
-            for (const glm::ivec3& checkPos : selectedArea) {
-                if (checkPos == transform.position) {
-                    // Fix lib. Destroying entities while iterating is changing the array indices.
-                    idToDestroy.push_back(entity);
-                    m_tempAddedPos.push_back(transform.position);
+        if (!m_scomps.brush.isFlat())
+            m_circleNormal = -1;
+    }
+
+    const int radius = static_cast<int>(std::round(glm::length(glm::vec3(target - m_startPos))));
+    if (radius == m_radius)
+        return;
+
+    // Cells are set row by row. Spheres have rows on the x axis, discs have them in their plane.
+    const bool isSphere = m_circleNormal < 0;
+    const int rowAxis = isSphere ? 0 : (m_circleNormal + 1) % 3;
+    const int offsetAxis = isSphere ? 1 : (m_circleNormal + 2) % 3;
+    const int layerAxis = isSphere ? 2 : m_circleNormal;
+    const int maxRadius = std::max(radius, m_radius);
+    const int maxLayer = isSphere ? maxRadius : 0;
+
+    // Only the cells between the previous and the new radius change
+    for (int offset = -maxRadius; offset <= maxRadius; offset++) {
+        for (int layer = -maxLayer; layer <= maxLayer; layer++) {
+            const int previousHalfWidth = voxmt::ballRowHalfWidth(m_radius, offset, layer);
+            const int halfWidth = voxmt::ballRowHalfWidth(radius, offset, layer);
+            if (previousHalfWidth == halfWidth)
+                continue;
+
+            glm::ivec3 pos = m_startPos;
+            pos[offsetAxis] += offset;
+            pos[layerAxis] += layer;
+            for (int x = std::min(previousHalfWidth, halfWidth) + 1; x <= std::max(previousHalfWidth, halfWidth); x++) {
+                for (int side : { x, -x }) {
+                    pos[rowAxis] = m_startPos[rowAxis] + side;
+                    if (halfWidth > previousHalfWidth)
+                        previewCell(pos);
+                    else
+                        unpreviewCell(pos);
+
+                    if (x == 0)
+                        break;
                 }
             }
-        });
+        }
+    }
+
+    m_radius = radius;
+}
+
+void BrushSystem::faceBrush() {
+    PROFILE_SCOPE("FaceBrush update");
+
+    // The region is found once per click
+    if (m_hasStart || !m_scomps.hovered.isCube())
+        return;
+    m_hasStart = true;
+
+    const glm::ivec3 normal = hoveredNormal();
+    m_cells.clear();
+    findConnectedFaces(m_scomps.voxelGrid, m_scomps.hovered.position(), normal, m_scomps.brush.isSameMaterial(), m_cells);
+
+    // Adding extrudes the region by one layer, removing intrudes it
+    const glm::ivec3 offset = m_scomps.brushPreview.usage() == BrushUse::ADD ? normal : glm::ivec3(0);
+    for (const glm::ivec3& cell : m_cells) {
+        previewCell(cell + offset);
+    }
+}
+
+void BrushSystem::fillBrush() {
+    PROFILE_SCOPE("FillBrush update");
+
+    // The region is found once per click
+    if (m_hasStart)
+        return;
+    m_hasStart = true;
+
+    // Adding fills the empty region in front of the hovered face, the others change the voxels connected to the hovered one
+    const bool isAdding = m_scomps.brushPreview.usage() == BrushUse::ADD;
+    if (!isAdding && !m_scomps.hovered.isCube())
+        return;
+    const glm::ivec3 start = isAdding ? hoveredNeighbour() : m_scomps.hovered.position();
+
+    m_cells.clear();
+    const int limit = m_scomps.brush.fillLimit();
+    // Empty regions are only added when enclosed, so an open one is not filled up to the limit
+    if (!floodFill(m_scomps.voxelGrid, start, limit, m_cells, isAdding) && isAdding) {
+        spdlog::warn("[BrushSystem] The region to fill is not enclosed within {} cells", limit);
+        return;
+    }
+
+    for (const glm::ivec3& cell : m_cells) {
+        previewCell(cell);
+    }
+}
+
+void BrushSystem::pressBrush() {
+    // Applied once on release, as the clipboard or the filtered area can hold millions of voxels
+    if (m_hasStart)
+        return;
+    m_startPos = hoveredNeighbour();
+    m_hasStart = true;
+}
+
+void BrushSystem::outlineBrush() {
+    PROFILE_SCOPE("OutlineBrush update");
+
+    std::vector<glm::vec2>& outline = m_scomps.brushPreview.m_outline;
+    const glm::vec2 mousePos = m_scomps.inputs.ndcMousePos();
+
+    if (m_scomps.brush.type() == BrushType::MARQUEE) {
+        const glm::vec2 start = outline.empty() ? mousePos : outline.front();
+        outline = { start, glm::vec2(mousePos.x, start.y), mousePos, glm::vec2(start.x, mousePos.y) };
+        return;
+    }
+
+    // Close samples are skipped, as the cost of the lasso grows with its number of points
+    const float minDistance = 0.005f;
+    for (const glm::vec2& sample : m_scomps.inputs.ndcMouseSamples()) {
+        if (outline.empty() || glm::distance(sample, outline.back()) > minDistance)
+            outline.push_back(sample);
+    }
+    if (outline.empty())
+        outline.push_back(mousePos);
+}
+
+glm::ivec3 BrushSystem::hoveredNormal() const {
+    return m_scomps.hovered.isCube() ? faceNormal(m_scomps.hovered.face()) : glm::ivec3(0);
+}
+
+glm::ivec3 BrushSystem::faceNormal(Face face) {
+    switch (face) {
+    case Face::FRONT: return glm::ivec3(0, 0, -1);
+    case Face::BACK: return glm::ivec3(0, 0, 1);
+    case Face::RIGHT: return glm::ivec3(1, 0, 0);
+    case Face::LEFT: return glm::ivec3(-1, 0, 0);
+    case Face::TOP: return glm::ivec3(0, 1, 0);
+    case Face::BOTTOM: return glm::ivec3(0, -1, 0);
+    case Face::NONE: return glm::ivec3(0);
+    default:
+        assert(false && "Unknown face");
+        return glm::ivec3(0);
+    }
+}
+
+glm::ivec3 BrushSystem::hoveredNeighbour() const {
+    return m_scomps.hovered.position() + hoveredNormal();
+}
+
+void BrushSystem::previewCell(const glm::ivec3& pos) {
+    // Symmetric cells are merged in the preview, so the edit is applied once for all of them
+    std::array<glm::ivec3, 8> cells;
+    const int count = symmetricCells(pos, cells);
+    if (count > 1)
+        m_brushCells.insert(VoxelGrid::cellKey(pos));
+
+    for (int i = 0; i < count; i++) {
+        // Only the cells which would change are previewed
+        const bool isUsed = m_scomps.voxelGrid.has(cells[i]);
+        if (m_scomps.brushPreview.usage() == BrushUse::ADD ? !isUsed : isUsed)
+            m_scomps.brushPreview.insert(cells[i]);
+    }
+}
+
+void BrushSystem::unpreviewCell(const glm::ivec3& pos) {
+    std::array<glm::ivec3, 8> cells;
+    const int count = symmetricCells(pos, cells);
+    if (count == 1) {
+        m_scomps.brushPreview.erase(pos);
+        return;
+    }
 
-        for (auto const& id : idToDestroy) {
-            m_ctx.registry.destroy(id);
+    // Symmetry planes are involutions, so the cells whose image is a given cell are its own images
+    m_brushCells.erase(VoxelGrid::cellKey(pos));
+    std::array<glm::ivec3, 8> sources;
+    for (int i = 0; i < count; i++) {
+        const int sourceCount = symmetricCells(cells[i], sources);
+        bool isShared = false;
+        for (int j = 0; j < sourceCount && !isShared; j++) {
+            isShared = m_brushCells.count(VoxelGrid::cellKey(sources[j])) > 0;
         }
+        if (!isShared)
+            m_scomps.brushPreview.erase(cells[i]);
+    }
+}
+
+int BrushSystem::symmetricCells(const glm::ivec3& pos, std::array<glm::ivec3, 8>& cells) const {
+    const glm::bvec3& symmetry = m_scomps.brush.symmetry();
+    const glm::ivec3& center = m_scomps.brush.symmetryCenter();
 
-        break;
+    cells[0] = pos;
+    int count = 1;
+    for (int axis = 0; axis < 3; axis++) {
+        // Cells on the plane are their own image
+        const int mirrored = 2 * center[axis] - pos[axis];
+        if (!symmetry[axis] || mirrored == pos[axis])
+            continue;
+
+        for (int i = 0; i < count; i++) {
+            cells[count + i] = cells[i];
+            cells[count + i][axis] = mirrored;
+        }
+        count *= 2;
     }
+    return count;
+}
 
-    case BrushUse::PAINT : {
-        PROFILE_SCOPE("BoxBrush paint");
-    
-        // TODO use a LUT in scomps for O(1) access to pos instead of O(n)
-        m_ctx.registry.view<comp::Transform, comp::Material>().each([&](met::entity entity, comp::Transform& transform, comp::Material& material) {
-            for (const glm::ivec3& checkPos : selectedArea) {
-                if (checkPos == transform.position) {
-                    material.sIndex = m_scomps.materials.selectedIndex();
-                    m_tempAddedPos.push_back(transform.position);
-                }
+void BrushSystem::clearPreview() {
+    m_scomps.brushPreview.clear();
+    m_brushCells.clear();
+}
+
+void BrushSystem::commitPreview() {
+    PROFILE_SCOPE("BrushSystem commit");
+    const BrushPreview& preview = m_scomps.brushPreview;
+
+    // The selection is not part of the history
+    if (preview.usage() == BrushUse::SELECT) {
+        Selection picked;
+        const std::vector<glm::vec2>& outline = preview.outline();
+        const glm::mat4 viewProj = m_scomps.camera.proj() * m_scomps.camera.view();
+        if (m_scomps.brush.type() == BrushType::MARQUEE && outline.size() == 4) {
+            selectInRectangle(m_scomps.voxelGrid, viewProj, outline.at(0), outline.at(2), picked);
+        } else if (m_scomps.brush.type() == BrushType::LASSO) {
+            selectInLasso(m_scomps.voxelGrid, viewProj, outline, picked);
+        } else {
+            for (const glm::ivec3& pos : preview.positions()) {
+                picked.insert(pos);
             }
-        });
-        break;
+            picked.intersect(m_scomps.voxelGrid);
+        }
+        select(picked);
+        return;
     }
 
+    if (m_scomps.brush.type() == BrushType::STAMP) {
+        if (m_hasStart)
+            stamp();
+        return;
+    } else if (m_scomps.brush.type() == BrushType::FILTER) {
+        if (m_hasStart)
+            filter();
+        return;
+    }
+
+    // The scene can be changed while editing, by an undo
+    std::vector<glm::ivec3> positions;
+    std::vector<unsigned int> previousMaterials;
+    positions.reserve(preview.size());
+    for (const glm::ivec3& pos : preview.positions()) {
+        const bool isUsed = m_scomps.voxelGrid.has(pos);
+        if (preview.usage() == BrushUse::ADD && !isUsed) {
+            positions.push_back(pos);
+        } else if (preview.usage() != BrushUse::ADD && isUsed) {
+            positions.push_back(pos);
+            previousMaterials.push_back(m_scomps.voxelGrid.material(pos));
+        }
+    }
+
+    if (positions.empty())
+        return;
+
+    // Applied once for the whole edit
+    BrushHistory* history = new BrushHistory(m_ctx.editor, preview.usage(), positions, previousMaterials, preview.material());
+    history->redo();
+    m_ctx.history.pushHistory(history);
+}
+
+void BrushSystem::select(Selection& picked) {
+    Selection& selection = m_scomps.selection;
+    switch (m_scomps.brush.selectionMode()) {
+    case SelectionMode::REPLACE: selection = std::move(picked); break;
+    case SelectionMode::UNITE: selection.unite(picked); break;
+    case SelectionMode::SUBTRACT: selection.subtract(picked); break;
+    case SelectionMode::INTERSECT: selection.intersect(picked); break;
     default: break;
     }
 }
+
+void BrushSystem::stamp() {
+    PROFILE_SCOPE("StampBrush commit");
+
+    const Clipboard& clipboard = m_scomps.clipboard;
+    if (clipboard.empty())
+        return;
+
+    // The box is centered on the pressed cell, and lies on it
+    const int turns = m_scomps.brush.stampTurns();
+    const glm::ivec3 size = clipboard.size(turns);
+    const glm::ivec3 origin = m_startPos - glm::ivec3(size.x / 2, 0, size.z / 2);
+
+    std::vector<glm::ivec3> positions;
+    std::vector<unsigned int> materials;
+    clipboard.stamp(origin, turns, m_scomps.brush.isStampMirrored(), positions, materials);
+
+    PasteHistory* history = new PasteHistory(m_ctx.editor, m_scomps.voxelGrid, positions, materials);
+    if (history->empty()) {
+        delete history;
+        return;
+    }
+    history->redo();
+    m_ctx.history.pushHistory(history);
+}
+
+void BrushSystem::filter() {
+    PROFILE_SCOPE("FilterBrush commit");
+
+    // The ball is centered on the pressed cell
+    const int radius = m_scomps.brush.filterRadius();
+    const glm::ivec3 center = m_startPos;
+    Selection region;
+    for (int z = -radius; z <= radius; z++) {
+        for (int y = -radius; y <= radius; y++) {
+            const int halfWidth = voxmt::ballRowHalfWidth(radius, y, z);
+            for (int x = -halfWidth; x <= halfWidth; x++) {
+                region.insert(center + glm::ivec3(x, y, z));
+            }
+        }
+    }
+
+    CsgHistory* history = nullptr;
+    {
+        VoxelGrid result;
+        filterVoxels(m_scomps.voxelGrid, region, m_scomps.brush.filter(), result);
+        history = new CsgHistory(m_ctx.editor, m_scomps.voxelGrid, result);
+    }
+    if (history->empty()) {
+        delete history;
+        return;
+    }
+    history->redo();
+    m_ctx.history.pushHistory(history);
+}
+
+void BrushSystem::endEdit() {
+    clearPreview();
+    m_isEditing = false;
+    m_hasStart = false;
+}
+
+template<typename F>
+void BrushSystem::forEachCellOutside(const CellBox& box, const CellBox& excluded, F f) {
+    const glm::ivec3 overlapMin = glm::max(box.min, excluded.min);
+    const glm::ivec3 overlapMax = glm::min(box.max, excluded.max);
+    const bool overlaps = overlapMin.x <= overlapMax.x && overlapMin.y <= overlapMax.y && overlapMin.z <= overlapMax.z;
+
+    for (int x = box.min.x; x <= box.max.x; x++) {
+        const bool isOutsideX = !overlaps || x < overlapMin.x || x > overlapMax.x;
+        for (int y = box.min.y; y <= box.max.y; y++) {
+            const bool isOutsideXY = isOutsideX || y < overlapMin.y || y > overlapMax.y;
+            if (isOutsideXY) {
+                for (int z = box.min.z; z <= box.max.z; z++) {
+                    f(glm::ivec3(x, y, z));
+                }
+            } else {
+                // Only the slabs in front and behind the overlap
+                for (int z = box.min.z; z < overlapMin.z; z++) {
+                    f(glm::ivec3(x, y, z));
+                }
+                for (int z = overlapMax.z + 1; z <= box.max.z; z++) {
+                    f(glm::ivec3(x, y, z));
+                }
+            }
+        }
+    }
+}
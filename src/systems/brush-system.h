@@ -1,10 +1,14 @@
 #pragma once
 
 #include <glm/glm.hpp>
+#include <array>
 #include <vector>
+#include <unordered_set>
+#include <cstdint>
 
 #include "systems/i-system.h"
 #include "context.h"
+#include "scomponents/io/hovered.h"
 
 class BrushSystem : public ISystem {
 public:
@@ -14,11 +18,120 @@ public:
 	void update() override;
 
 private:
+    /**
+     * @brief Cells between min and max, both included
+     */
+    struct CellBox {
+        glm::ivec3 min;
+        glm::ivec3 max;
+    };
+
+    /**
+     * @brief Stroke through the hovered cells, without gaps when the mouse moves fast
+     */
     void voxelBrush();
+
+    /**
+     * @brief Continue the stroke of the voxel brush to the target. It is joined to the previous one if both are on the same plane.
+     */
+    void strokeTo(const glm::ivec3& target, const glm::ivec3& normal);
     void boxBrush();
+    void lineBrush();
+
+    /**
+     * @brief Sphere or disc centered on the pressed cell. Only its cells crossed by the changes of radius are previewed again.
+     */
+    void circleBrush();
+
+    /**
+     * @brief Extrude, intrude or paint the exposed faces connected to the hovered one
+     */
+    void faceBrush();
+
+    /**
+     * @brief Fill the enclosed empty region in front of the hovered face, or change the voxels of the hovered material connected to the hovered one
+     */
+    void fillBrush();
+
+    /**
+     * @brief Keep the pressed cell, on which the clipboard is stamped or the filter is centered
+     */
+    void pressBrush();
+
+    /**
+     * @brief Draw the rectangle or the lasso of a screen selection. The voxels inside are only found on release.
+     */
+    void outlineBrush();
+
+    /**
+     * @brief Direction of the hovered face, zero when no cube is hovered
+     */
+    glm::ivec3 hoveredNormal() const;
+    static glm::ivec3 faceNormal(Face face);
+
+    /**
+     * @brief Empty cell in front of the hovered face, or the hovered cell of the grid
+     */
+    glm::ivec3 hoveredNeighbour() const;
+
+    /**
+     * @brief Add the cell and its symmetric cells to the preview, if the edit changes them
+     */
+    void previewCell(const glm::ivec3& pos);
+
+    /**
+     * @brief Remove the cell and its symmetric cells from the preview, unless they are symmetric to another cell of the brush
+     */
+    void unpreviewCell(const glm::ivec3& pos);
+
+    /**
+     * @brief Images of the cell by the enabled symmetry planes, the cell included
+     * @return Number of distinct cells, from 1 to 8
+     */
+    int symmetricCells(const glm::ivec3& pos, std::array<glm::ivec3, 8>& cells) const;
+    void clearPreview();
+
+    /**
+     * @brief Apply the previewed edit to the scene and save it in the history
+     */
+    void commitPreview();
+
+    /**
+     * @brief Combine the cells picked by the brush with the selection. Picked cells can be moved from.
+     */
+    void select(Selection& picked);
+
+    /**
+     * @brief Paste the clipboard on the pressed cell, as one edit
+     */
+    void stamp();
+
+    /**
+     * @brief Apply the morphological filter to the ball around the pressed cell, as one edit
+     */
+    void filter();
+    void endEdit();
+
+    /**
+     * @brief Call f for the cells of the box which are not in the excluded one. Cost scales with these cells and one face of the box, not with its volume.
+     */
+    template<typename F>
+    static void forEachCellOutside(const CellBox& box, const CellBox& excluded, F f);
 
 private:
     Context& m_ctx;
     SingletonComponents& m_scomps;
-    std::vector<glm::ivec3> m_tempAddedPos;
+    bool m_isEditing; // The brush is used, and its edit is previewed
+    std::vector<glm::ivec3> m_cells; // Cells of the shape, kept to reuse their storage
+    std::unordered_set<std::uint64_t> m_brushCells; // Cell keys of the shape before symmetry, only kept when it is enabled
+
+    // Shape of the current drag. Only the difference with the box of the previous frame is previewed.
+    bool m_hasStart;
+    glm::ivec3 m_startPos;
+    CellBox m_box;
+    glm::ivec3 m_lineEnd;
+    int m_radius; // -1 before the first frame of the circle
+    int m_circleNormal; // Axis of the disc, -1 for spheres
+    glm::ivec3 m_strokeEnd;
+    glm::ivec3 m_strokeNormal;
 };
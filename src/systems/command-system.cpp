@@ -0,0 +1,155 @@
+#include "command-system.h"
+
+#include <profiling/instrumentor.h>
+#include <vector>
+
+#include "history/brushes/brush-history.h"
+#include "history/csg/csg-history.h"
+#include "history/selection/move-history.h"
+#include "scene/morphology.h"
+
+CommandSystem::CommandSystem(Context& ctx, SingletonComponents& scomps)
+    : m_ctx(ctx), m_scomps(scomps) {}
+
+CommandSystem::~CommandSystem() {}
+
+void CommandSystem::update() {
+    PROFILE_SCOPE("CommandSystem update");
+
+    // The scene is replaced when loading ends
+    if (m_scomps.loading.isLoading()) {
+        m_scomps.guiCommands.m_commands.clear();
+        return;
+    }
+
+    for (const GuiCommand& command : m_scomps.guiCommands.commands()) {
+        switch (command.type) {
+        case GuiCommandType::UNDO: m_ctx.history.undo(); break;
+        case GuiCommandType::REDO: m_ctx.history.redo(); break;
+        case GuiCommandType::SELECT_ALL: m_scomps.selection.selectAll(m_scomps.voxelGrid); break;
+        case GuiCommandType::DESELECT: m_scomps.selection.clear(); break;
+        case GuiCommandType::COPY_SELECTION: m_scomps.clipboard.copy(m_scomps.voxelGrid, m_scomps.selection); break;
+        case GuiCommandType::DELETE_SELECTION: applyBrush(BrushUse::REMOVE); break;
+        case GuiCommandType::PAINT_SELECTION: applyBrush(BrushUse::PAINT); break;
+        case GuiCommandType::MOVE_SELECTION: move(command.offset); break;
+        case GuiCommandType::FILTER_SELECTION: filter(static_cast<MorphologyFilter>(command.option)); break;
+
+        case GuiCommandType::CSG_UNITE:
+        case GuiCommandType::CSG_SUBTRACT:
+        case GuiCommandType::CSG_INTERSECT:
+            combine(command.type, command.offset, command.option != 0);
+            break;
+
+        default: break;
+        }
+    }
+    m_scomps.guiCommands.m_commands.clear();
+}
+
+void CommandSystem::applyBrush(BrushUse usage) {
+    PROFILE_SCOPE("CommandSystem apply brush");
+
+    Selection& selection = m_scomps.selection;
+    selection.intersect(m_scomps.voxelGrid);
+    if (selection.empty())
+        return;
+
+    std::vector<glm::ivec3> positions;
+    std::vector<unsigned int> previousMaterials;
+    positions.reserve(selection.size());
+    previousMaterials.reserve(selection.size());
+    selection.positions(positions);
+    for (const glm::ivec3& position : positions) {
+        previousMaterials.push_back(m_scomps.voxelGrid.material(position));
+    }
+
+    BrushHistory* history = new BrushHistory(m_ctx.editor, usage, positions, previousMaterials, m_scomps.materials.selectedIndex());
+    history->redo();
+    m_ctx.history.pushHistory(history);
+
+    if (usage == BrushUse::REMOVE)
+        selection.clear();
+}
+
+void CommandSystem::move(const glm::ivec3& offset) {
+    PROFILE_SCOPE("CommandSystem move");
+
+    Selection& selection = m_scomps.selection;
+    selection.intersect(m_scomps.voxelGrid);
+    if (selection.empty() || offset == glm::ivec3(0))
+        return;
+
+    MoveHistory* history = new MoveHistory(m_ctx.editor, m_scomps.voxelGrid, selection, offset);
+    history->redo();
+    m_ctx.history.pushHistory(history);
+
+    // The selection follows its voxels
+    selection.translate(offset);
+}
+
+void CommandSystem::filter(MorphologyFilter filter) {
+    PROFILE_SCOPE("CommandSystem filter");
+
+    Selection& selection = m_scomps.selection;
+    selection.intersect(m_scomps.voxelGrid);
+    if (selection.empty())
+        return;
+
+    // The selected voxels can only grow by one cell
+    Selection region;
+    dilateSelection(selection, region);
+
+    CsgHistory* history = nullptr;
+    {
+        VoxelGrid result;
+        filterVoxels(m_scomps.voxelGrid, region, filter, result);
+        history = new CsgHistory(m_ctx.editor, m_scomps.voxelGrid, result);
+    }
+    if (history->empty()) {
+        delete history;
+        return;
+    }
+    history->redo();
+    m_ctx.history.pushHistory(history);
+
+    // The selection keeps the filtered voxels
+    selection = std::move(region);
+    selection.intersect(m_scomps.voxelGrid);
+}
+
+void CommandSystem::combine(GuiCommandType operation, const glm::ivec3& offset, bool isReplacing) {
+    PROFILE_SCOPE("CommandSystem combine");
+
+    if (m_scomps.clipboard.empty())
+        return;
+
+    VoxelGrid operand;
+    {
+        std::vector<glm::ivec3> positions;
+        std::vector<unsigned int> materials;
+        m_scomps.clipboard.stamp(offset, 0, false, positions, materials);
+        for (size_t i = 0; i < positions.size(); i++) {
+            operand.insert(positions.at(i), met::null, materials.at(i));
+        }
+    }
+
+    // The operation is done on a copy sharing the chunks of the scene, so the history only compares the copied ones
+    CsgHistory* history = nullptr;
+    {
+        VoxelGrid result(m_scomps.voxelGrid.snapshot());
+        switch (operation) {
+        case GuiCommandType::CSG_UNITE: result.unite(operand, isReplacing); break;
+        case GuiCommandType::CSG_SUBTRACT: result.subtract(operand); break;
+        case GuiCommandType::CSG_INTERSECT: result.intersect(operand, isReplacing); break;
+        default: break;
+        }
+        history = new CsgHistory(m_ctx.editor, m_scomps.voxelGrid, result);
+    }
+
+    if (history->empty()) {
+        delete history;
+        return;
+    }
+    history->redo();
+    m_ctx.history.pushHistory(history);
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include "systems/i-system.h"
+#include "context.h"
+#include "scomponents/io/gui-commands.h"
+
+/**
+ * @brief Do the edits requested by the windows during the previous frame
+ */
+class CommandSystem : public ISystem {
+public:
+    CommandSystem(Context& ctx, SingletonComponents& scomps);
+    virtual ~CommandSystem();
+
+	void update() override;
+
+private:
+    /**
+     * @brief Remove or paint the selected voxels, as one brush edit
+     */
+    void applyBrush(BrushUse usage);
+    void move(const glm::ivec3& offset);
+
+    /**
+     * @brief Apply the filter to the selected voxels and the cells around them, as one edit
+     */
+    void filter(MorphologyFilter filter);
+
+    /**
+     * @brief Boolean operation between the scene and the clipboard placed at the offset
+     */
+    void combine(GuiCommandType operation, const glm::ivec3& offset, bool isReplacing);
+
+private:
+    Context& m_ctx;
+    SingletonComponents& m_scomps;
+};
@@ -0,0 +1,74 @@
+#include "loading-system.h"
+
+#include <profiling/instrumentor.h>
+#include <string>
+#include <filesystem>
+
+#include "loaders/cbe-loader.h"
+#include "loaders/vox-loader.h"
+
+LoadingSystem::LoadingSystem(Context& ctx, SingletonComponents& scomps) : m_ctx(ctx), m_scomps(scomps), m_progress(0.0f) {}
+
+LoadingSystem::~LoadingSystem() {
+    if (m_job.valid())
+        m_job.wait();
+}
+
+void LoadingSystem::update() {
+    PROFILE_SCOPE("LoadingSystem update");
+
+    if (!m_job.valid()) {
+        if (m_scomps.loading.filePath().empty())
+            return;
+
+        // Files without geometry are applied on the current voxels
+        m_scene = std::make_unique<StagingScene>();
+        m_scene->voxels = VoxelGrid(m_scomps.voxelGrid.snapshot());
+        m_scomps.loading.m_isLoading = true;
+        m_scomps.loading.m_progress = 0.0f;
+
+        const std::string filePath = m_scomps.loading.filePath();
+        if (std::filesystem::path(filePath).extension() == ".vox") {
+            m_job = std::async(std::launch::async, [this, filePath, capacity = m_scomps.materials.capacity()]() {
+                VoxLoader loader(capacity);
+                return loader.loadFile(filePath.c_str(), *m_scene, m_progress);
+            });
+        } else {
+            m_job = std::async(std::launch::async, [this, filePath]() {
+                CbeLoader loader;
+                return loader.loadFile(filePath.c_str(), *m_scene, m_progress);
+            });
+        }
+        return;
+    }
+
+    m_scomps.loading.m_progress = m_progress;
+    if (m_job.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+        return;
+
+    if (m_job.get())
+        swapScene();
+
+    m_scene.reset();
+    m_scomps.loading.m_filePath.clear();
+    m_scomps.loading.m_isLoading = false;
+}
+
+void LoadingSystem::swapScene() {
+    PROFILE_SCOPE("Swap loaded scene");
+
+    m_ctx.editor.load(m_scene->voxels);
+    m_scomps.selection.clear();
+
+    // Edits are replayed by position, they do not apply to another model
+    m_ctx.history.clear();
+
+    if (!m_scene->palette.empty()) {
+        Materials& materials = m_scomps.materials;
+        materials.m_materials.clear();
+        for (size_t i = 0; i < m_scene->palette.size() && i < materials.capacity(); i++) {
+            materials.push_back(m_scene->palette.at(i));
+        }
+        materials.m_selectedIndex = 0;
+    }
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <atomic>
+#include <future>
+#include <memory>
+
+#include "i-system.h"
+#include "context.h"
+#include "scene/staging-scene.h"
+
+/**
+ * @brief Decode the requested file on a worker thread, then replace the scene with it between two frames
+ */
+class LoadingSystem : public ISystem {
+public:
+    LoadingSystem(Context& ctx, SingletonComponents& scomps);
+    virtual ~LoadingSystem();
+
+    void update() override;
+
+private:
+    void swapScene();
+
+private:
+    Context& m_ctx;
+    SingletonComponents& m_scomps;
+    std::future<bool> m_job;
+    std::unique_ptr<StagingScene> m_scene;
+    std::atomic<float> m_progress;
+};
@@ -75,47 +75,39 @@ void RenderSystem::update() {
 	}
 
     auto view = m_ctx.registry.view<comp::Material, comp::Transform>();
-    unsigned int nbInstances = 0;
+    const BrushPreview& preview = m_scomps.brushPreview;
+    const bool isPreviewRemoving = !preview.empty() && preview.usage() == BrushUse::REMOVE;
+    const bool isPreviewPainting = !preview.empty() && preview.usage() == BrushUse::PAINT;
+    const bool isPreviewSelecting = !preview.empty() && preview.usage() == BrushUse::SELECT;
+    const Selection& selection = m_scomps.selection;
 
     // All cubes are using the same mesh and shaders
     // TODO use tag to only grab cubes
     view.each([&](met::entity entity, comp::Material& material, comp::Transform& transform) {
-        nbInstances++;
+        if (isPreviewRemoving && preview.has(transform.position))
+            return;
+
         m_tempTranslations.push_back(transform.position);
         m_tempEntityIds.push_back(voxmt::intToNormColor(entity));
-        m_tempMaterialIds.push_back(material.sIndex);
-
-        if (nbInstances >= view.size()) {
-            // Update instance buffers
-            for (auto& buffer : m_scomps.meshes.m_cube.vb.buffers) {
-                switch (buffer.type) {
-                case AttributeBufferType::PER_INSTANCE_TRANSLATION: {
-                    OGL_SCOPE("Update perInstanceTranslation attribute buffer");
-                    m_ctx.rcommand.updateAttributeBufferAnySize(buffer, m_tempTranslations.data(), sizeof(glm::vec3) * nbInstances);
-                    m_tempTranslations.clear();
-                    break;
-                }
-
-                case AttributeBufferType::PER_INSTANCE_ENTITY_ID: {
-                    OGL_SCOPE("Update perInstanceEntityId attribute buffer");
-                    m_ctx.rcommand.updateAttributeBufferAnySize(buffer, m_tempEntityIds.data(), sizeof(glm::vec3) * nbInstances);
-                    m_tempEntityIds.clear();
-                    break;
-                }
-
-                case AttributeBufferType::PER_INSTANCE_MATERIAL: {
-                    OGL_SCOPE("Update perInstanceMaterial attribute buffer");
-                    m_ctx.rcommand.updateAttributeBufferAnySize(buffer, m_tempMaterialIds.data(), sizeof(unsigned int) * nbInstances);
-                    m_tempMaterialIds.clear();
-                    break;
-                }
-
-                default: break;
-                }
-            }
-        }
+        unsigned int materialId = isPreviewPainting && preview.has(transform.position) ? preview.material() : material.sIndex;
+        if ((!selection.empty() && selection.has(transform.position)) || (isPreviewSelecting && preview.has(transform.position)))
+            materialId |= SELECTED_MATERIAL_FLAG;
+        m_tempMaterialIds.push_back(materialId);
     });
-
+    const unsigned int nbInstances = static_cast<unsigned int>(m_tempTranslations.size());
+    updateInstanceBuffers(m_scomps.meshes.m_cube.vb);
+
+    // Cubes added by the brush have no entity yet, so they cannot be hovered
+    unsigned int nbPreviewInstances = 0;
+    if (!preview.empty() && preview.usage() == BrushUse::ADD) {
+        for (const glm::ivec3& position : preview.positions()) {
+            m_tempTranslations.push_back(position);
+            m_tempEntityIds.push_back(voxmt::intToNormColor(met::null));
+            m_tempMaterialIds.push_back(preview.material());
+        }
+        nbPreviewInstances = static_cast<unsigned int>(preview.size());
+        updateInstanceBuffers(m_scomps.meshes.m_previewCube.vb);
+    }
 
     {
         OGL_SCOPE("Geometry pass");
@@ -126,16 +118,20 @@ void RenderSystem::update() {
         m_ctx.rcommand.clear();
         m_ctx.rcommand.bindPipeline(m_scomps.pipelines.at(PipelineIndex::PIP_GEOMETRY));
         m_ctx.rcommand.drawIndexedInstances(m_scomps.meshes.cube().ib.count, m_scomps.meshes.cube().ib.type, nbInstances);
+        drawPreview(nbPreviewInstances);
         const glm::ivec2 pixelToRead = glm::ivec2(m_scomps.inputs.mousePos().x, m_scomps.viewport.size().y - m_scomps.inputs.mousePos().y);
         m_ctx.rcommand.prepareReadPixelBuffer(m_scomps.renderTargets.m_rts.at(static_cast<unsigned int>(RenderTargetIndex::RTT_GEOMETRY)).pixelBuffer, pixelToRead);
     }
 
     {
         OGL_SCOPE("Shadow map pass");
+        m_ctx.rcommand.bindVertexBuffer(m_scomps.meshes.cube().vb);
+        m_ctx.rcommand.bindIndexBuffer(m_scomps.meshes.cube().ib);
         m_ctx.rcommand.bindRenderTarget(m_scomps.renderTargets.at(RenderTargetIndex::RTT_SHADOW_MAP));
         m_ctx.rcommand.clear();
         m_ctx.rcommand.bindPipeline(m_scomps.pipelines.at(PipelineIndex::PIP_SHADOW_MAP));
         m_ctx.rcommand.drawIndexedInstances(m_scomps.meshes.cube().ib.count, m_scomps.meshes.cube().ib.type, nbInstances);
+        drawPreview(nbPreviewInstances);
     }
     
     {
@@ -145,9 +141,12 @@ void RenderSystem::update() {
         m_ctx.rcommand.bindRenderTarget(m_scomps.renderTargets.at(RenderTargetIndex::RTT_FINAL));
         m_ctx.rcommand.clear();
         m_ctx.rcommand.bindPipeline(m_scomps.pipelines.at(PipelineIndex::PIP_LIGHTING));
-        std::vector<unsigned int> textureIds = m_scomps.renderTargets.at(RenderTargetIndex::RTT_GEOMETRY).textureIds;
+        const std::vector<unsigned int>& geometryTextureIds = m_scomps.renderTargets.at(RenderTargetIndex::RTT_GEOMETRY).textureIds;
+        FrameVector<unsigned int> textureIds(m_ctx.frameArena);
+        textureIds.reserve(geometryTextureIds.size() + 1);
+        textureIds.assign(geometryTextureIds.begin(), geometryTextureIds.end());
         textureIds.push_back(m_scomps.renderTargets.at(RenderTargetIndex::RTT_SHADOW_MAP).textureIds.at(0));
-        m_ctx.rcommand.bindTextureIds(textureIds);
+        m_ctx.rcommand.bindTextureIds(textureIds.data(), textureIds.size());
         m_ctx.rcommand.drawIndexed(m_scomps.meshes.plane().ib.count, m_scomps.meshes.plane().ib.type);
     }
 
@@ -185,6 +184,49 @@ void RenderSystem::update() {
     }
 }
 
+void RenderSystem::updateInstanceBuffers(VertexBuffer& vb) {
+    if (m_tempTranslations.empty())
+        return;
+
+    for (auto& buffer : vb.buffers) {
+        switch (buffer.type) {
+        case AttributeBufferType::PER_INSTANCE_TRANSLATION: {
+            OGL_SCOPE("Update perInstanceTranslation attribute buffer");
+            m_ctx.rcommand.updateAttributeBufferAnySize(buffer, m_tempTranslations.data(), static_cast<unsigned int>(sizeof(glm::vec3) * m_tempTranslations.size()));
+            break;
+        }
+
+        case AttributeBufferType::PER_INSTANCE_ENTITY_ID: {
+            OGL_SCOPE("Update perInstanceEntityId attribute buffer");
+            m_ctx.rcommand.updateAttributeBufferAnySize(buffer, m_tempEntityIds.data(), static_cast<unsigned int>(sizeof(glm::vec3) * m_tempEntityIds.size()));
+            break;
+        }
+
+        case AttributeBufferType::PER_INSTANCE_MATERIAL: {
+            OGL_SCOPE("Update perInstanceMaterial attribute buffer");
+            m_ctx.rcommand.updateAttributeBufferAnySize(buffer, m_tempMaterialIds.data(), static_cast<unsigned int>(sizeof(unsigned int) * m_tempMaterialIds.size()));
+            break;
+        }
+
+        default: break;
+        }
+    }
+
+    m_tempTranslations.clear();
+    m_tempEntityIds.clear();
+    m_tempMaterialIds.clear();
+}
+
+void RenderSystem::drawPreview(unsigned int nbInstances) {
+    if (nbInstances == 0)
+        return;
+
+    OGL_SCOPE("Brush preview");
+    m_ctx.rcommand.bindVertexBuffer(m_scomps.meshes.previewCube().vb);
+    m_ctx.rcommand.bindIndexBuffer(m_scomps.meshes.previewCube().ib);
+    m_ctx.rcommand.drawIndexedInstances(m_scomps.meshes.previewCube().ib.count, m_scomps.meshes.previewCube().ib.type, nbInstances);
+}
+
 void RenderSystem::updateCBperNiMesh(glm::vec3 translation, float scale, glm::vec3 albedo) {
     cb::perNiMesh cbData;
     const ConstantBuffer& perNiMeshCB = m_scomps.constantBuffers.at(ConstantBufferIndex::PER_NI_MESH);
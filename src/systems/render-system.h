@@ -15,6 +15,13 @@ public:
 	void update() override;
 
 private:
+	static constexpr unsigned int SELECTED_MATERIAL_FLAG = 1 << 8; // Set on the material index of selected cubes, read by the geometry shader
+
+	/**
+	 * @brief Send the instances gathered in the temporary vectors, and clear them
+	 */
+	void updateInstanceBuffers(VertexBuffer& vb);
+	void drawPreview(unsigned int nbInstances);
 	void updateCBperNiMesh_facePlane();
 	void updateCBperNiMesh(glm::vec3 translation, float scale, glm::vec3 albedo);
 
@@ -0,0 +1,78 @@
+#include <catch2/catch.hpp>
+#include <glm/glm.hpp>
+
+#include "exporters/greedy-mesher.h"
+
+namespace {
+    float surfaceArea(const VoxelMesh& mesh) {
+        float area = 0.0f;
+        for (const SubMesh& subMesh : mesh.subMeshes) {
+            for (size_t i = 0; i < subMesh.indices.size(); i += 3) {
+                const glm::vec3& a = subMesh.positions.at(subMesh.indices[i]);
+                const glm::vec3& b = subMesh.positions.at(subMesh.indices[i + 1]);
+                const glm::vec3& c = subMesh.positions.at(subMesh.indices[i + 2]);
+                area += glm::length(glm::cross(b - a, c - a)) * 0.5f;
+            }
+        }
+        return area;
+    }
+
+    bool isFacingOutside(const VoxelMesh& mesh) {
+        for (const SubMesh& subMesh : mesh.subMeshes) {
+            for (size_t i = 0; i < subMesh.indices.size(); i += 3) {
+                const glm::vec3& a = subMesh.positions.at(subMesh.indices[i]);
+                const glm::vec3& b = subMesh.positions.at(subMesh.indices[i + 1]);
+                const glm::vec3& c = subMesh.positions.at(subMesh.indices[i + 2]);
+                if (glm::dot(glm::cross(b - a, c - a), subMesh.normals.at(subMesh.indices[i])) <= 0.0f)
+                    return false;
+            }
+        }
+        return true;
+    }
+}
+
+SCENARIO("Greedy meshing should only keep the surface of the voxels", "[mesh]") {
+    GIVEN("A box of a single material crossing chunk borders") {
+        VoxelGrid grid;
+        for (int x = -3; x < 20; x++) {
+            for (int y = 0; y < 5; y++) {
+                for (int z = 10; z < 18; z++) {
+                    grid.insert(glm::ivec3(x, y, z), met::null, 2);
+                }
+            }
+        }
+
+        WHEN("It is meshed") {
+            const VoxelMesh mesh = GreedyMesher(4).build(grid.snapshot());
+
+            THEN("Faces between voxels are removed and quads are merged") {
+                REQUIRE(mesh.subMeshes.size() == 1);
+                REQUIRE(mesh.subMeshes.at(0).material == 2);
+                REQUIRE(surfaceArea(mesh) == Approx(2.0f * (23 * 5 + 23 * 8 + 5 * 8)));
+                REQUIRE(isFacingOutside(mesh));
+
+                // A box inside a single chunk would only need 2 triangles per side
+                REQUIRE(mesh.subMeshes.at(0).indices.size() < 23 * 5 * 8 * 6);
+            }
+        }
+    }
+
+    GIVEN("Two voxels of different materials side by side") {
+        VoxelGrid grid;
+        grid.insert(glm::ivec3(0, 0, 0), met::null, 0);
+        grid.insert(glm::ivec3(1, 0, 0), met::null, 1);
+
+        WHEN("It is meshed") {
+            const VoxelMesh mesh = GreedyMesher(1).build(grid.snapshot());
+
+            THEN("Each material has its own sub mesh with 5 visible faces") {
+                REQUIRE(mesh.subMeshes.size() == 2);
+                for (const SubMesh& subMesh : mesh.subMeshes) {
+                    REQUIRE(subMesh.indices.size() == 5 * 6);
+                    REQUIRE(subMesh.positions.size() == 5 * 4);
+                }
+                REQUIRE(isFacingOutside(mesh));
+            }
+        }
+    }
+}
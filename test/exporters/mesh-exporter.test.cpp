@@ -0,0 +1,41 @@
+#include <catch2/catch.hpp>
+#include <glm/glm.hpp>
+#include <nlohmann/json.hpp>
+#include <filesystem>
+#include <fstream>
+
+#include "exporters/mesh-exporter.h"
+
+SCENARIO("Only scenes with voxels should be exported as meshes", "[mesh]") {
+    GIVEN("A palette and a path to a .gltf file") {
+        const std::vector<cb::perMaterialChange> palette = { { glm::vec3(1.0f, 0.0f, 0.0f), 0.0f } };
+        const std::filesystem::path filePath = std::filesystem::temp_directory_path() / "cube-beast-editor-export-test.gltf";
+        const std::filesystem::path binPath = std::filesystem::path(filePath).replace_extension(".bin");
+        std::filesystem::remove(filePath);
+
+        WHEN("An empty scene is exported") {
+            const bool isExported = MeshExporter(1).writeFile(filePath.string().c_str(), VoxelGrid().snapshot(), palette);
+
+            THEN("It is refused without writing a file") {
+                REQUIRE_FALSE(isExported);
+                REQUIRE_FALSE(std::filesystem::exists(filePath));
+            }
+        }
+
+        WHEN("A voxel is exported") {
+            VoxelGrid grid;
+            grid.insert(glm::ivec3(2, 0, -1), met::null, 0);
+            REQUIRE(MeshExporter(1).writeFile(filePath.string().c_str(), grid.snapshot(), palette));
+
+            THEN("The file has a mesh and a buffer which are not empty") {
+                std::ifstream file(filePath);
+                const nlohmann::json json = nlohmann::json::parse(file);
+                REQUIRE(json["meshes"].size() == 1);
+                REQUIRE(json["buffers"].at(0)["byteLength"].get<size_t>() > 0);
+            }
+        }
+
+        std::filesystem::remove(filePath);
+        std::filesystem::remove(binPath);
+    }
+}
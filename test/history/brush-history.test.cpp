@@ -0,0 +1,57 @@
+#include <catch2/catch.hpp>
+#include <met/met.hpp>
+
+#include "history/brushes/brush-history.h"
+#include "scene/voxel-editor.h"
+
+SCENARIO("Brush edits should be undone and redone", "[history]") {
+    GIVEN("A scene with two voxels") {
+        met::registry registry;
+        VoxelGrid grid;
+        VoxelEditor editor(registry, grid);
+        editor.add(glm::ivec3(0, 0, 0), 1);
+        editor.add(glm::ivec3(1, 0, 0), 2);
+
+        WHEN("A box is added over them") {
+            const std::vector<glm::ivec3> positions = { glm::ivec3(0, 1, 0), glm::ivec3(1, 1, 0), glm::ivec3(2, 1, 0) };
+            BrushHistory history(editor, BrushUse::ADD, positions, {}, 3);
+            history.redo();
+
+            THEN("The voxels are added, then removed on undo") {
+                REQUIRE(grid.size() == 5);
+                REQUIRE(grid.material(glm::ivec3(2, 1, 0)) == 3);
+
+                history.undo();
+                REQUIRE(grid.size() == 2);
+                REQUIRE_FALSE(grid.has(glm::ivec3(0, 1, 0)));
+            }
+        }
+
+        WHEN("The voxels are removed") {
+            BrushHistory history(editor, BrushUse::REMOVE, { glm::ivec3(0, 0, 0), glm::ivec3(1, 0, 0) }, { 1, 2 }, 0);
+            history.redo();
+
+            THEN("They are added back with their material on undo") {
+                REQUIRE(grid.size() == 0);
+
+                history.undo();
+                REQUIRE(grid.size() == 2);
+                REQUIRE(grid.material(glm::ivec3(1, 0, 0)) == 2);
+                REQUIRE(registry.alive() == 2);
+            }
+        }
+
+        WHEN("The voxels are painted") {
+            BrushHistory history(editor, BrushUse::PAINT, { glm::ivec3(0, 0, 0), glm::ivec3(1, 0, 0) }, { 1, 2 }, 5);
+            history.redo();
+
+            THEN("They get their previous material on undo") {
+                REQUIRE(grid.material(glm::ivec3(0, 0, 0)) == 5);
+
+                history.undo();
+                REQUIRE(grid.material(glm::ivec3(0, 0, 0)) == 1);
+                REQUIRE(grid.material(glm::ivec3(1, 0, 0)) == 2);
+            }
+        }
+    }
+}
@@ -0,0 +1,64 @@
+#include <catch2/catch.hpp>
+#include <met/met.hpp>
+
+#include "history/csg/csg-history.h"
+
+SCENARIO("CSG operations should only edit the cells they change", "[history]") {
+    GIVEN("A row of three voxels in the scene, and a row of two voxels of another material crossing a chunk boundary") {
+        met::registry registry;
+        VoxelGrid grid;
+        VoxelEditor editor(registry, grid);
+        for (int x = 0; x < 3; x++) {
+            editor.add(glm::ivec3(x, 0, 0), 1);
+        }
+        editor.add(glm::ivec3(40, 0, 0), 1);
+
+        VoxelGrid operand;
+        operand.insert(glm::ivec3(2, 0, 0), met::null, 2);
+        operand.insert(glm::ivec3(-1, 0, 0), met::null, 2);
+
+        WHEN("The row is united with the scene, replacing the materials") {
+            CsgHistory* history = nullptr;
+            {
+                VoxelGrid result(grid.snapshot());
+                result.unite(operand, true);
+                history = new CsgHistory(editor, grid, result);
+            }
+            history->redo();
+
+            THEN("One voxel is added and one is painted, then both are restored on undo") {
+                REQUIRE(grid.size() == 5);
+                REQUIRE(grid.material(glm::ivec3(-1, 0, 0)) == 2);
+                REQUIRE(grid.material(glm::ivec3(2, 0, 0)) == 2);
+                REQUIRE(grid.at(glm::ivec3(-1, 0, 0)) != met::null);
+
+                history->undo();
+                REQUIRE(grid.size() == 4);
+                REQUIRE_FALSE(grid.has(glm::ivec3(-1, 0, 0)));
+                REQUIRE(grid.material(glm::ivec3(2, 0, 0)) == 1);
+                REQUIRE(registry.alive() == 4);
+            }
+            delete history;
+        }
+
+        WHEN("The scene is intersected with the row") {
+            CsgHistory* history = nullptr;
+            {
+                VoxelGrid result(grid.snapshot());
+                result.intersect(operand, false);
+                history = new CsgHistory(editor, grid, result);
+            }
+            history->redo();
+
+            THEN("Only the common voxel is left, even in the chunk without any common cell") {
+                REQUIRE(grid.size() == 1);
+                REQUIRE(grid.material(glm::ivec3(2, 0, 0)) == 1);
+
+                history->undo();
+                REQUIRE(grid.size() == 4);
+                REQUIRE(grid.has(glm::ivec3(40, 0, 0)));
+            }
+            delete history;
+        }
+    }
+}
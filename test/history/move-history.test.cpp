@@ -0,0 +1,41 @@
+#include <catch2/catch.hpp>
+#include <met/met.hpp>
+
+#include "history/selection/move-history.h"
+
+SCENARIO("Moves should replace the voxels they land on, and bring them back on undo", "[history]") {
+    GIVEN("A row of three voxels and another voxel") {
+        met::registry registry;
+        VoxelGrid grid;
+        VoxelEditor editor(registry, grid);
+        for (int x = 0; x < 3; x++) {
+            editor.add(glm::ivec3(x, 0, 0), 1);
+        }
+        editor.add(glm::ivec3(4, 0, 0), 2);
+
+        WHEN("The row is moved by two cells onto the other voxel") {
+            Selection selection;
+            for (int x = 0; x < 3; x++) {
+                selection.insert(glm::ivec3(x, 0, 0));
+            }
+            MoveHistory history(editor, grid, selection, glm::ivec3(2, 0, 0));
+            history.redo();
+
+            THEN("The other voxel is replaced, then added back on undo") {
+                REQUIRE(grid.size() == 3);
+                REQUIRE_FALSE(grid.has(glm::ivec3(1, 0, 0)));
+                REQUIRE(grid.material(glm::ivec3(4, 0, 0)) == 1);
+
+                history.undo();
+                REQUIRE(grid.size() == 4);
+                REQUIRE(grid.material(glm::ivec3(0, 0, 0)) == 1);
+                REQUIRE(grid.material(glm::ivec3(4, 0, 0)) == 2);
+                REQUIRE(registry.alive() == 4);
+
+                history.redo();
+                REQUIRE(grid.size() == 3);
+                REQUIRE(grid.material(glm::ivec3(3, 0, 0)) == 1);
+            }
+        }
+    }
+}
@@ -0,0 +1,34 @@
+#include <catch2/catch.hpp>
+#include <met/met.hpp>
+
+#include "history/selection/paste-history.h"
+
+SCENARIO("Pastes should add and paint voxels, and restore them on undo", "[history]") {
+    GIVEN("A voxel in the middle of a pasted row of three cells") {
+        met::registry registry;
+        VoxelGrid grid;
+        VoxelEditor editor(registry, grid);
+        editor.add(glm::ivec3(1, 0, 0), 2);
+
+        WHEN("The row is pasted") {
+            const std::vector<glm::ivec3> positions = { glm::ivec3(0, 0, 0), glm::ivec3(1, 0, 0), glm::ivec3(2, 0, 0) };
+            const std::vector<unsigned int> materials = { 1, 1, 1 };
+            PasteHistory history(editor, grid, positions, materials);
+            history.redo();
+
+            THEN("The voxel is painted, then restored on undo") {
+                REQUIRE(grid.size() == 3);
+                REQUIRE(grid.material(glm::ivec3(1, 0, 0)) == 1);
+
+                history.undo();
+                REQUIRE(grid.size() == 1);
+                REQUIRE(grid.material(glm::ivec3(1, 0, 0)) == 2);
+                REQUIRE(registry.alive() == 1);
+
+                history.redo();
+                REQUIRE(grid.size() == 3);
+                REQUIRE(grid.material(glm::ivec3(2, 0, 0)) == 1);
+            }
+        }
+    }
+}
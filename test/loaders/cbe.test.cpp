@@ -0,0 +1,151 @@
+#include <catch2/catch.hpp>
+#include <glm/glm.hpp>
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+
+#include "loaders/cbe-loader.h"
+#include "loaders/cbe-writer.h"
+
+namespace {
+    /**
+     * @brief Voxels on both sides of chunk boundaries, with a material depending on their position
+     */
+    void insertStairs(VoxelGrid& grid) {
+        for (int x = -20; x < 40; x++) {
+            for (int z = -3; z < 3; z++) {
+                const int height = (x + 20) / 4;
+                for (int y = 0; y <= height; y++) {
+                    grid.insert(glm::ivec3(x, y, z), met::null, (x + y + z + 60) % 3);
+                }
+            }
+        }
+    }
+}
+
+SCENARIO(".cbe files should keep the voxels of each chunk", "[cbe]") {
+    GIVEN("A scene spanning several chunks and its palette") {
+        const std::vector<cb::perMaterialChange> palette = {
+            { glm::vec3(1.0f, 0.0f, 0.0f), 0.0f },
+            { glm::vec3(0.0f, 1.0f, 0.0f), 0.0f },
+            { glm::vec3(0.0f, 0.0f, 1.0f), 0.0f }
+        };
+        VoxelGrid grid;
+        insertStairs(grid);
+
+        const std::filesystem::path directory = std::filesystem::temp_directory_path() / "cube-beast-editor-cbe-test";
+        std::filesystem::remove_all(directory);
+        const std::string filePath = (directory / "scene.cbe").string();
+        CbeWriter writer(filePath);
+        REQUIRE(writer.writeFile(grid.snapshot(), palette));
+
+        WHEN("It is read back") {
+            StagingScene scene;
+            std::atomic<float> progress;
+            REQUIRE(CbeLoader().loadFile(filePath.c_str(), scene, progress));
+
+            THEN("Each voxel should be at the same position with the same material") {
+                REQUIRE(scene.voxels.size() == grid.size());
+                for (const auto& chunk : grid.snapshot()) {
+                    for (unsigned int i = 0; i < VoxelChunk::VOLUME; i++) {
+                        if (chunk->has(i)) {
+                            const glm::ivec3 pos = chunk->cellPosition(i);
+                            REQUIRE(scene.voxels.has(pos));
+                            REQUIRE(scene.voxels.material(pos) == chunk->materials[i]);
+                        }
+                    }
+                }
+                REQUIRE(scene.palette.size() == palette.size());
+                for (size_t i = 0; i < palette.size(); i++) {
+                    REQUIRE(scene.palette.at(i).albedo == palette.at(i).albedo);
+                }
+            }
+        }
+
+        WHEN("One chunk changes, another one is emptied, and the scene is written again") {
+            const std::filesystem::path unchangedFile = directory / "scene_0_0_0.bin";
+            const std::filesystem::path changedFile = directory / "scene_1_0_0.bin";
+            const std::filesystem::path emptiedFile = directory / "scene_-2_0_-1.bin";
+            REQUIRE(std::filesystem::exists(unchangedFile));
+            REQUIRE(std::filesystem::exists(changedFile));
+            REQUIRE(std::filesystem::exists(emptiedFile));
+
+            // Removed so that writing it again would be noticed
+            std::filesystem::remove(unchangedFile);
+            std::filesystem::remove(changedFile);
+            grid.paint(glm::ivec3(20, 0, 0), 0);
+            for (int x = -20; x < -16; x++) {
+                for (int y = 0; y < VoxelChunk::SIZE; y++) {
+                    for (int z = -3; z < 0; z++) {
+                        grid.erase(glm::ivec3(x, y, z));
+                    }
+                }
+            }
+            REQUIRE(writer.writeFile(grid.snapshot(), palette));
+
+            THEN("Only the changed chunk is written, and the file of the empty one is removed") {
+                REQUIRE_FALSE(std::filesystem::exists(unchangedFile));
+                REQUIRE(std::filesystem::exists(changedFile));
+                REQUIRE_FALSE(std::filesystem::exists(emptiedFile));
+            }
+        }
+
+        std::filesystem::remove_all(directory);
+    }
+}
+
+SCENARIO("Files written before the chunk files should still load", "[cbe]") {
+    GIVEN("A file of version 0.0.1 with a placeholder voxel chunk") {
+        const std::filesystem::path directory = std::filesystem::temp_directory_path() / "cube-beast-editor-cbe-old-test";
+        std::filesystem::create_directories(directory);
+        const std::string filePath = (directory / "old.cbe").string();
+        std::ofstream(filePath) << R"({
+            "software": "cube-beast-editor",
+            "version": "0.0.1",
+            "geometry": [{
+                "cube": { "from": [0, 0, 0], "to": [3, 3, 3], "paletteIndex": 1 },
+                "voxelChunk": { "byteLength": 4096, "uri": "old.bin" }
+            }]
+        })";
+
+        // Would fill a whole chunk if it was read as a chunk file
+        const std::vector<char> cells(VoxelChunk::VOLUME, 1);
+        std::ofstream((directory / "old.bin").string(), std::ios::binary).write(cells.data(), cells.size());
+
+        WHEN("It is read") {
+            StagingScene scene;
+            std::atomic<float> progress;
+            const bool isLoaded = CbeLoader().loadFile(filePath.c_str(), scene, progress);
+            std::filesystem::remove_all(directory);
+
+            THEN("The placeholder is ignored and the other geometry is kept") {
+                REQUIRE(isLoaded);
+                REQUIRE(scene.voxels.size() == 27);
+            }
+        }
+    }
+}
+
+SCENARIO("Snapshots should not see the changes made to the grid after them", "[cbe]") {
+    GIVEN("A grid and a snapshot of it") {
+        VoxelGrid grid;
+        insertStairs(grid);
+        const size_t size = grid.size();
+        const VoxelGrid::Snapshot snapshot = grid.snapshot();
+
+        WHEN("Voxels are painted, erased and added in the grid") {
+            grid.paint(glm::ivec3(0, 0, 0), 2);
+            grid.erase(glm::ivec3(1, 0, 0));
+            grid.insert(glm::ivec3(0, 40, 0), met::null, 1);
+
+            THEN("A grid made from the snapshot still has the previous voxels") {
+                const VoxelGrid previous(snapshot);
+                REQUIRE(previous.size() == size);
+                REQUIRE(previous.material(glm::ivec3(0, 0, 0)) == (0 + 0 + 0 + 60) % 3);
+                REQUIRE(previous.has(glm::ivec3(1, 0, 0)));
+                REQUIRE_FALSE(previous.has(glm::ivec3(0, 40, 0)));
+                REQUIRE(grid.material(glm::ivec3(0, 0, 0)) == 2);
+            }
+        }
+    }
+}
@@ -0,0 +1,128 @@
+#include <catch2/catch.hpp>
+#include <glm/glm.hpp>
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+
+#include "loaders/vox-loader.h"
+#include "loaders/vox-writer.h"
+
+namespace {
+    void pushInt(std::vector<char>& data, std::int32_t value) {
+        for (int i = 0; i < 4; i++) {
+            data.push_back(static_cast<char>((static_cast<std::uint32_t>(value) >> (8 * i)) & 0xFF));
+        }
+    }
+}
+
+SCENARIO("MagicaVoxel files should keep the position and the color of each voxel", "[vox]") {
+    GIVEN("A generated model larger than a .vox model") {
+        std::vector<cb::perMaterialChange> palette = {
+            { glm::vec3(1.0f, 0.0f, 0.0f), 0.0f },
+            { glm::vec3(0.0f, 1.0f, 0.0f), 0.0f },
+            { glm::vec3(0.0f, 0.0f, 1.0f), 0.0f }
+        };
+
+        VoxelGrid grid;
+        for (int x = -20; x < 300; x++) {
+            for (int z = -5; z < 5; z++) {
+                const int height = (x * x + z) % 7;
+                for (int y = 0; y <= height; y++) {
+                    grid.insert(glm::ivec3(x, y, z), met::null, (x + y + z + 300) % 3);
+                }
+            }
+        }
+
+        WHEN("It is written then read back") {
+            const std::string filePath = (std::filesystem::temp_directory_path() / "cube-beast-editor-test.vox").string();
+            REQUIRE(VoxWriter().writeFile(filePath.c_str(), grid.snapshot(), palette));
+
+            StagingScene scene;
+            std::atomic<float> progress;
+            REQUIRE(VoxLoader().loadFile(filePath.c_str(), scene, progress));
+            std::filesystem::remove(filePath);
+
+            THEN("Each voxel should be at the same position with the same color") {
+                REQUIRE(scene.voxels.size() == grid.size());
+                for (const auto& chunk : grid.snapshot()) {
+                    for (unsigned int i = 0; i < VoxelChunk::VOLUME; i++) {
+                        if (chunk->has(i)) {
+                            const glm::ivec3 pos = chunk->cellPosition(i);
+                            REQUIRE(scene.voxels.has(pos));
+                            const glm::vec3 expected = palette.at(chunk->materials[i]).albedo;
+                            REQUIRE(scene.palette.at(scene.voxels.material(pos)).albedo == expected);
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+SCENARIO("Malformed MagicaVoxel files should be rejected", "[vox]") {
+    GIVEN("A file with an unknown chunk of negative size") {
+        std::vector<char> data = { 'V', 'O', 'X', ' ' };
+        pushInt(data, 150);
+        data.insert(data.end(), { 'M', 'A', 'I', 'N' });
+        pushInt(data, 0);
+        pushInt(data, 12);
+        data.insert(data.end(), { 'A', 'B', 'C', 'D' });
+        pushInt(data, -12);
+        pushInt(data, 0);
+
+        const std::string filePath = (std::filesystem::temp_directory_path() / "cube-beast-editor-malformed-test.vox").string();
+        std::ofstream(filePath, std::ios::binary).write(data.data(), data.size());
+
+        WHEN("It is read") {
+            StagingScene scene;
+            std::atomic<float> progress;
+            const bool isLoaded = VoxLoader().loadFile(filePath.c_str(), scene, progress);
+            std::filesystem::remove(filePath);
+
+            THEN("The loading should fail instead of going back to the chunk") {
+                REQUIRE_FALSE(isLoaded);
+            }
+        }
+    }
+}
+
+SCENARIO("MagicaVoxel files without palette should use the default one of MagicaVoxel", "[vox]") {
+    GIVEN("A model with a white voxel and a red one, and no RGBA chunk") {
+        std::vector<char> data = { 'V', 'O', 'X', ' ' };
+        pushInt(data, 150);
+        data.insert(data.end(), { 'M', 'A', 'I', 'N' });
+        pushInt(data, 0);
+        pushInt(data, 24 + 24);
+        data.insert(data.end(), { 'S', 'I', 'Z', 'E' });
+        pushInt(data, 12);
+        pushInt(data, 0);
+        pushInt(data, 2);
+        pushInt(data, 1);
+        pushInt(data, 1);
+        data.insert(data.end(), { 'X', 'Y', 'Z', 'I' });
+        pushInt(data, 12);
+        pushInt(data, 0);
+        pushInt(data, 2);
+        data.insert(data.end(), { 0, 0, 0, 1 });
+        data.insert(data.end(), { 1, 0, 0, static_cast<char>(216) });
+
+        const std::string filePath = (std::filesystem::temp_directory_path() / "cube-beast-editor-default-palette-test.vox").string();
+        std::ofstream(filePath, std::ios::binary).write(data.data(), data.size());
+
+        WHEN("It is read") {
+            StagingScene scene;
+            std::atomic<float> progress;
+            const bool isLoaded = VoxLoader().loadFile(filePath.c_str(), scene, progress);
+            std::filesystem::remove(filePath);
+
+            THEN("The voxels have the colors of the default palette") {
+                REQUIRE(isLoaded);
+                REQUIRE(scene.voxels.size() == 2);
+                const glm::vec3 white = scene.palette.at(scene.voxels.material(glm::ivec3(0, 0, 0))).albedo;
+                const glm::vec3 red = scene.palette.at(scene.voxels.material(glm::ivec3(1, 0, 0))).albedo;
+                REQUIRE(white == glm::vec3(1.0f));
+                REQUIRE(red == glm::vec3(0xEE / 255.0f, 0.0f, 0.0f));
+            }
+        }
+    }
+}
@@ -0,0 +1,63 @@
+#include <catch2/catch.hpp>
+#include <glm/glm.hpp>
+#include <vector>
+#include <cstdlib>
+
+#include "maths/rasterization.h"
+
+SCENARIO("Rasterized lines should join their two ends without gaps", "[rasterization]") {
+    GIVEN("Segments in every direction") {
+        const std::vector<std::pair<glm::ivec3, glm::ivec3>> segments = {
+            { glm::ivec3(0), glm::ivec3(0) },
+            { glm::ivec3(0), glm::ivec3(10, 0, 0) },
+            { glm::ivec3(3, -2, 7), glm::ivec3(-12, 5, 1) },
+            { glm::ivec3(-4, 9, 0), glm::ivec3(1, -20, 6) },
+            { glm::ivec3(0), glm::ivec3(2000, 1500, -700) }
+        };
+
+        WHEN("They are rasterized") {
+            std::vector<std::vector<glm::ivec3>> lines(segments.size());
+            for (size_t i = 0; i < segments.size(); i++) {
+                voxmt::rasterizeLine(segments.at(i).first, segments.at(i).second, lines.at(i));
+            }
+
+            THEN("There is one cell per step of the longest axis, each touching the previous one") {
+                for (size_t i = 0; i < segments.size(); i++) {
+                    const std::vector<glm::ivec3>& cells = lines.at(i);
+                    const glm::ivec3 delta = glm::abs(segments.at(i).second - segments.at(i).first);
+                    REQUIRE(cells.size() == static_cast<size_t>(glm::max(delta.x, glm::max(delta.y, delta.z)) + 1));
+                    REQUIRE(cells.front() == segments.at(i).first);
+                    REQUIRE(cells.back() == segments.at(i).second);
+
+                    for (size_t j = 1; j < cells.size(); j++) {
+                        const glm::ivec3 move = glm::abs(cells.at(j) - cells.at(j - 1));
+                        REQUIRE(glm::max(move.x, glm::max(move.y, move.z)) == 1);
+                    }
+                }
+            }
+        }
+    }
+}
+
+SCENARIO("Rows of a ball should hold the cells close enough to its center", "[rasterization]") {
+    GIVEN("Balls of different radius") {
+        const std::vector<int> radii = { 0, 1, 2, 5, 17 };
+
+        WHEN("Their rows are compared to the distance of each cell") {
+            THEN("The cells of the rows are the ones inside") {
+                for (int radius : radii) {
+                    for (int y = -radius - 1; y <= radius + 1; y++) {
+                        for (int z = -radius - 1; z <= radius + 1; z++) {
+                            const int halfWidth = voxmt::ballRowHalfWidth(radius, y, z);
+                            for (int x = -radius - 1; x <= radius + 1; x++) {
+                                const bool isInside = x * x + y * y + z * z <= radius * (radius + 1);
+                                REQUIRE(isInside == (std::abs(x) <= halfWidth));
+                            }
+                        }
+                    }
+                    REQUIRE(voxmt::ballRowHalfWidth(radius, 0, 0) == radius);
+                }
+            }
+        }
+    }
+}
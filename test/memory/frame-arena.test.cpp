@@ -0,0 +1,46 @@
+#include <catch2/catch.hpp>
+#include <cstdint>
+
+#include "memory/frame-arena.h"
+
+SCENARIO("Frame arena should give aligned memory until it is reset", "[memory]") {
+    GIVEN("A small arena") {
+        FrameArena arena(256);
+
+        WHEN("Values of different alignments are allocated") {
+            void* byte = arena.allocate(1, 1);
+            void* number = arena.allocate(sizeof(double), alignof(double));
+
+            THEN("They are aligned and do not overlap") {
+                REQUIRE(reinterpret_cast<std::uintptr_t>(number) % alignof(double) == 0);
+                REQUIRE(static_cast<std::uint8_t*>(number) > static_cast<std::uint8_t*>(byte));
+                REQUIRE(arena.used() <= 16);
+            }
+
+            AND_WHEN("The arena is reset") {
+                arena.reset();
+
+                THEN("The memory is reused from the start") {
+                    REQUIRE(arena.used() == 0);
+                    REQUIRE(arena.allocate(1, 1) == byte);
+                }
+            }
+        }
+
+        WHEN("A frame vector grows beyond the capacity") {
+            {
+                FrameVector<int> values(arena);
+                for (int i = 0; i < 1000; i++) {
+                    values.push_back(i);
+                }
+                REQUIRE(values.at(999) == 999);
+            }
+            arena.reset();
+
+            THEN("The arena grows to fit the next frames") {
+                REQUIRE(arena.peak() >= 1000 * sizeof(int));
+                REQUIRE(arena.capacity() >= arena.peak());
+            }
+        }
+    }
+}
@@ -0,0 +1,137 @@
+#include <catch2/catch.hpp>
+#include <profiling/instrumentor.h>
+#include <nlohmann/json.hpp>
+#include <filesystem>
+#include <fstream>
+#include <set>
+
+SCENARIO("Scopes recorded from several threads should end up in the json trace", "[profiling]") {
+    GIVEN("A profiling session") {
+        const std::filesystem::path directory = std::filesystem::temp_directory_path();
+        const std::string jsonPath = (directory / "cube-beast-editor-profiling-test.json").string();
+        const std::string tracePath = (directory / "cube-beast-editor-profiling-test.trace").string();
+        Instrumentor::get().beginSession("Test", jsonPath);
+
+        WHEN("Scopes are recorded by the main thread and by a worker") {
+            for (int i = 0; i < 100; i++) {
+                InstrumentationTimer timer("Main \"scope\"");
+            }
+            std::thread worker([]() {
+                for (int i = 0; i < 50; i++) {
+                    InstrumentationTimer timer("Worker scope");
+                }
+            });
+            worker.join();
+            Instrumentor::get().endSession();
+
+            THEN("Every scope is converted with its name and its thread, after the name of the session") {
+                std::ifstream file(jsonPath);
+                const nlohmann::json json = nlohmann::json::parse(file);
+                const auto& events = json["traceEvents"];
+                REQUIRE(events.size() == 151);
+                REQUIRE(events.at(0)["name"] == "process_name");
+                REQUIRE(events.at(0)["args"]["name"] == "Test");
+
+                std::set<unsigned int> threads;
+                size_t mainCount = 0;
+                for (const auto& event : events) {
+                    if (event["ph"] != "X")
+                        continue;
+                    threads.insert(event["tid"].get<unsigned int>());
+                    REQUIRE(event["dur"].get<double>() >= 0.0);
+                    if (event["name"] == "Main 'scope'")
+                        mainCount++;
+                }
+                REQUIRE(mainCount == 100);
+                REQUIRE(threads.size() == 2);
+            }
+
+            std::filesystem::remove(jsonPath);
+            std::filesystem::remove(tracePath);
+        }
+    }
+}
+
+SCENARIO("A capture should only keep the last frames", "[profiling]") {
+    GIVEN("The instrumentor recording the last 2 frames") {
+        Instrumentor& instrumentor = Instrumentor::get();
+        instrumentor.setCapturedFrameCount(2);
+        instrumentor.setEnabled(true);
+
+        WHEN("10 frames with 3 scopes each are recorded, then a capture is saved") {
+            for (int frame = 0; frame < 10; frame++) {
+                instrumentor.markFrame();
+                for (int i = 0; i < 3; i++) {
+                    InstrumentationTimer timer("Frame scope");
+                    std::this_thread::sleep_for(std::chrono::microseconds(100));
+                }
+            }
+            instrumentor.markFrame();
+
+            const std::string jsonPath = (std::filesystem::temp_directory_path() / "cube-beast-editor-capture-test.json").string();
+            REQUIRE(instrumentor.saveCapture(jsonPath));
+            instrumentor.setEnabled(false);
+            instrumentor.setCapturedFrameCount(300);
+
+            THEN("Only the scopes of the last frames are in the file") {
+                std::ifstream file(jsonPath);
+                const nlohmann::json json = nlohmann::json::parse(file);
+                size_t frameCount = 0;
+                size_t scopeCount = 0;
+                for (const auto& event : json["traceEvents"]) {
+                    if (event["name"] == Instrumentor::FRAME_NAME)
+                        frameCount++;
+                    else
+                        scopeCount++;
+                }
+                REQUIRE(frameCount == 2);
+                REQUIRE(scopeCount == 6);
+            }
+
+            std::filesystem::remove(jsonPath);
+        }
+    }
+}
+
+SCENARIO("Gpu events should be written on their own track", "[profiling]") {
+    GIVEN("The instrumentor enabled") {
+        Instrumentor& instrumentor = Instrumentor::get();
+        instrumentor.setEnabled(true);
+
+        WHEN("A cpu scope and a gpu event of the same name are recorded") {
+            instrumentor.markFrame();
+            const std::int64_t start = Instrumentor::ticks();
+            {
+                InstrumentationTimer timer("Geometry pass");
+            }
+            instrumentor.recordGpu({ "Geometry pass", start, start + 1000 });
+            instrumentor.markFrame();
+
+            const std::string jsonPath = (std::filesystem::temp_directory_path() / "cube-beast-editor-gpu-test.json").string();
+            REQUIRE(instrumentor.saveCapture(jsonPath));
+            std::vector<ScopeDuration> durations;
+            instrumentor.lastFrameDurations(durations);
+            instrumentor.setEnabled(false);
+
+            THEN("The gpu event is on the named gpu track, and not counted in the cpu durations") {
+                std::ifstream file(jsonPath);
+                const nlohmann::json json = nlohmann::json::parse(file);
+                size_t gpuEventCount = 0;
+                bool hasTrackName = false;
+                for (const auto& event : json["traceEvents"]) {
+                    if (event["tid"].get<unsigned int>() != trace::GPU_THREAD_ID)
+                        continue;
+                    if (event["ph"] == "M")
+                        hasTrackName = event["args"]["name"] == "GPU";
+                    else
+                        gpuEventCount++;
+                }
+                REQUIRE(hasTrackName);
+                REQUIRE(gpuEventCount == 1);
+                REQUIRE(durations.size() == 1);
+            }
+
+            std::filesystem::remove(jsonPath);
+        }
+    }
+}
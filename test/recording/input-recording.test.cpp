@@ -0,0 +1,107 @@
+#include <catch2/catch.hpp>
+#include <filesystem>
+#include <fstream>
+
+#include "recording/input-recording.h"
+
+SCENARIO("Recorded inputs should be replayed frame by frame", "[recording]") {
+    GIVEN("Frames with different inputs") {
+        std::vector<InputFrame> frames(3);
+        frames.at(0).mousePos = glm::vec2(120.0f, 64.5f);
+        frames.at(0).ndcMousePos = glm::vec2(-0.25f, 0.5f);
+        frames.at(0).viewportSize = glm::ivec2(800, 600);
+        frames.at(0).viewportHovered = true;
+        frames.at(1).posDelta = glm::vec2(3.0f, -2.0f);
+        frames.at(1).ndcMouseSamples = { glm::vec2(-0.3f, 0.5f), glm::vec2(-0.25f, 0.45f) };
+        frames.at(1).wheelDelta = -1;
+        frames.at(1).actionState.at(static_cast<unsigned int>(InputAction::CAM_PAN)) = true;
+        frames.at(1).actionState.at(static_cast<unsigned int>(InputAction::DEBUG)) = true;
+        frames.at(2).brushType = BrushType::BOX;
+        frames.at(2).brushUsage = BrushUse::PAINT;
+        frames.at(2).brushStarted = true;
+        frames.at(2).brushSize = 5;
+        frames.at(2).brushFlat = true;
+        frames.at(1).brushSameMaterial = true;
+        frames.at(2).fillLimit = 200;
+        frames.at(2).selectionMode = SelectionMode::SUBTRACT;
+        frames.at(2).stampTurns = 3;
+        frames.at(2).stampMirrored = true;
+        frames.at(2).symmetry = glm::bvec3(true, false, true);
+        frames.at(2).symmetryCenter = glm::ivec3(-3, 0, 12);
+        frames.at(2).filter = MorphologyFilter::CLOSE;
+        frames.at(2).filterRadius = 12;
+        frames.at(2).material = 7;
+        frames.at(2).viewportPosTopLeft = glm::ivec2(10, 32);
+        frames.at(1).commands = { { GuiCommandType::UNDO }, { GuiCommandType::MOVE_SELECTION, glm::ivec3(0, -2, 5) } };
+        frames.at(2).commands = { { GuiCommandType::CSG_INTERSECT, glm::ivec3(-16, 3, 40), 1 } };
+
+        const std::string filePath = (std::filesystem::temp_directory_path() / "cube-beast-editor-inputs-test.bvei").string();
+
+        WHEN("They are recorded then replayed") {
+            {
+                InputRecorder recorder;
+                REQUIRE(recorder.open(filePath));
+                for (const InputFrame& frame : frames) {
+                    recorder.record(frame);
+                }
+            }
+
+            InputReplay replay;
+            REQUIRE(replay.open(filePath));
+            std::vector<InputFrame> replayed;
+            InputFrame frame;
+            while (replay.next(frame)) {
+                replayed.push_back(frame);
+            }
+
+            THEN("Every frame comes back the same") {
+                REQUIRE(replayed.size() == frames.size());
+                for (size_t i = 0; i < frames.size(); i++) {
+                    REQUIRE(replayed.at(i).mousePos == frames.at(i).mousePos);
+                    REQUIRE(replayed.at(i).ndcMousePos == frames.at(i).ndcMousePos);
+                    REQUIRE(replayed.at(i).posDelta == frames.at(i).posDelta);
+                    REQUIRE(replayed.at(i).ndcMouseSamples == frames.at(i).ndcMouseSamples);
+                    REQUIRE(replayed.at(i).wheelDelta == frames.at(i).wheelDelta);
+                    REQUIRE(replayed.at(i).actionState == frames.at(i).actionState);
+                    REQUIRE(replayed.at(i).brushType == frames.at(i).brushType);
+                    REQUIRE(replayed.at(i).brushUsage == frames.at(i).brushUsage);
+                    REQUIRE(replayed.at(i).brushStarted == frames.at(i).brushStarted);
+                    REQUIRE(replayed.at(i).brushSize == frames.at(i).brushSize);
+                    REQUIRE(replayed.at(i).brushFlat == frames.at(i).brushFlat);
+                    REQUIRE(replayed.at(i).brushSameMaterial == frames.at(i).brushSameMaterial);
+                    REQUIRE(replayed.at(i).fillLimit == frames.at(i).fillLimit);
+                    REQUIRE(replayed.at(i).selectionMode == frames.at(i).selectionMode);
+                    REQUIRE(replayed.at(i).stampTurns == frames.at(i).stampTurns);
+                    REQUIRE(replayed.at(i).stampMirrored == frames.at(i).stampMirrored);
+                    REQUIRE(replayed.at(i).symmetry == frames.at(i).symmetry);
+                    REQUIRE(replayed.at(i).symmetryCenter == frames.at(i).symmetryCenter);
+                    REQUIRE(replayed.at(i).filter == frames.at(i).filter);
+                    REQUIRE(replayed.at(i).filterRadius == frames.at(i).filterRadius);
+                    REQUIRE(replayed.at(i).material == frames.at(i).material);
+                    REQUIRE(replayed.at(i).viewportSize == frames.at(i).viewportSize);
+                    REQUIRE(replayed.at(i).viewportPosTopLeft == frames.at(i).viewportPosTopLeft);
+                    REQUIRE(replayed.at(i).viewportHovered == frames.at(i).viewportHovered);
+                    REQUIRE(replayed.at(i).commands.size() == frames.at(i).commands.size());
+                    for (size_t j = 0; j < frames.at(i).commands.size(); j++) {
+                        REQUIRE(replayed.at(i).commands.at(j).type == frames.at(i).commands.at(j).type);
+                        REQUIRE(replayed.at(i).commands.at(j).offset == frames.at(i).commands.at(j).offset);
+                        REQUIRE(replayed.at(i).commands.at(j).option == frames.at(i).commands.at(j).option);
+                    }
+                }
+                REQUIRE(replay.frameIndex() == frames.size());
+            }
+        }
+
+        WHEN("Another file is replayed") {
+            std::ofstream(filePath) << "Not a recording";
+            InputReplay replay;
+
+            THEN("It is refused") {
+                REQUIRE_FALSE(replay.open(filePath));
+                REQUIRE_FALSE(replay.isReplaying());
+            }
+        }
+
+        std::filesystem::remove(filePath);
+    }
+}
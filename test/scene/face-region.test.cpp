@@ -0,0 +1,59 @@
+#include <catch2/catch.hpp>
+#include <met/met.hpp>
+#include <vector>
+#include <algorithm>
+
+#include "scene/face-region.h"
+
+SCENARIO("Connected faces should stop at covered and unconnected voxels", "[scene]") {
+    GIVEN("A 40 x 40 floor with a pillar in its middle, a hole, and a different material on one row") {
+        VoxelGrid grid;
+        for (int x = 0; x < 40; x++) {
+            for (int z = 0; z < 40; z++) {
+                if (x == 5 && z == 5)
+                    continue;
+                grid.insert(glm::ivec3(x, 0, z), met::null, z == 39 ? 2 : 1);
+            }
+        }
+        grid.insert(glm::ivec3(20, 1, 20), met::null, 1);
+        grid.insert(glm::ivec3(60, 0, 60), met::null, 1);
+
+        WHEN("The top faces are searched from a corner") {
+            std::vector<glm::ivec3> cells;
+            findConnectedFaces(grid, glm::ivec3(0, 0, 0), glm::ivec3(0, 1, 0), false, cells);
+
+            THEN("Every exposed voxel of the floor is found once") {
+                REQUIRE(cells.size() == 40 * 40 - 2);
+                REQUIRE(std::find(cells.begin(), cells.end(), glm::ivec3(39, 0, 39)) != cells.end());
+                REQUIRE(std::find(cells.begin(), cells.end(), glm::ivec3(20, 0, 20)) == cells.end());
+            }
+        }
+
+        WHEN("Only the voxels of the same material are searched") {
+            std::vector<glm::ivec3> cells;
+            findConnectedFaces(grid, glm::ivec3(0, 0, 0), glm::ivec3(0, 1, 0), true, cells);
+
+            THEN("The last row is left out") {
+                REQUIRE(cells.size() == 40 * 39 - 2);
+            }
+        }
+
+        WHEN("The search starts on a covered face") {
+            std::vector<glm::ivec3> cells;
+            findConnectedFaces(grid, glm::ivec3(20, 0, 20), glm::ivec3(0, 1, 0), false, cells);
+
+            THEN("Nothing is found") {
+                REQUIRE(cells.empty());
+            }
+        }
+
+        WHEN("The side faces are searched") {
+            std::vector<glm::ivec3> cells;
+            findConnectedFaces(grid, glm::ivec3(39, 0, 0), glm::ivec3(1, 0, 0), false, cells);
+
+            THEN("Only the border of the floor is found") {
+                REQUIRE(cells.size() == 40);
+            }
+        }
+    }
+}
@@ -0,0 +1,102 @@
+#include <catch2/catch.hpp>
+#include <met/met.hpp>
+#include <vector>
+#include <algorithm>
+
+#include "scene/flood-fill.h"
+
+namespace {
+    /**
+     * @brief Walls of a cube between 0 and size - 1, with its top face of another material
+     */
+    void insertHollowCube(VoxelGrid& grid, int size) {
+        for (int x = 0; x < size; x++) {
+            for (int y = 0; y < size; y++) {
+                for (int z = 0; z < size; z++) {
+                    const bool isWall = x == 0 || y == 0 || z == 0 || x == size - 1 || y == size - 1 || z == size - 1;
+                    if (isWall)
+                        grid.insert(glm::ivec3(x, y, z), met::null, y == size - 1 ? 2 : 1);
+                }
+            }
+        }
+    }
+}
+
+SCENARIO("Flood fill should find the connected region without going through its walls", "[scene]") {
+    GIVEN("A hollow cube crossing chunk boundaries") {
+        VoxelGrid grid;
+        insertHollowCube(grid, 22);
+
+        WHEN("The inside is filled") {
+            std::vector<glm::ivec3> cells;
+            const bool isEnclosed = floodFill(grid, glm::ivec3(7, 12, 3), 64, cells);
+
+            THEN("Every empty cell inside is found once") {
+                REQUIRE(isEnclosed);
+                REQUIRE(cells.size() == 20 * 20 * 20);
+                std::sort(cells.begin(), cells.end(), [](const glm::ivec3& a, const glm::ivec3& b) {
+                    return std::tie(a.x, a.y, a.z) < std::tie(b.x, b.y, b.z);
+                });
+                REQUIRE(std::adjacent_find(cells.begin(), cells.end()) == cells.end());
+                REQUIRE(cells.front() == glm::ivec3(1));
+                REQUIRE(cells.back() == glm::ivec3(20));
+            }
+        }
+
+        WHEN("The walls are filled from a voxel of the bottom") {
+            std::vector<glm::ivec3> cells;
+            const bool isEnclosed = floodFill(grid, glm::ivec3(4, 0, 4), 64, cells);
+
+            THEN("Only the voxels of its material are found") {
+                REQUIRE(isEnclosed);
+                REQUIRE(cells.size() == 22 * 22 * 22 - 20 * 20 * 20 - 22 * 22);
+            }
+        }
+
+        WHEN("A wall has a hole, and the inside is filled") {
+            grid.erase(glm::ivec3(0, 5, 5));
+            std::vector<glm::ivec3> cells;
+            const bool isEnclosed = floodFill(grid, glm::ivec3(7, 12, 3), 40, cells);
+
+            THEN("The fill stops at the limit, and tells it was reached") {
+                REQUIRE_FALSE(isEnclosed);
+                REQUIRE(std::all_of(cells.begin(), cells.end(), [](const glm::ivec3& cell) {
+                    return glm::all(glm::greaterThanEqual(cell, glm::ivec3(7, 12, 3) - 40)) && glm::all(glm::lessThanEqual(cell, glm::ivec3(7, 12, 3) + 40));
+                }));
+            }
+        }
+    }
+}
+
+SCENARIO("Flood fill should stop early on open regions when asked to", "[scene]") {
+    GIVEN("An empty scene") {
+        VoxelGrid grid;
+
+        WHEN("The open ground is filled up to the largest limit of the brush") {
+            std::vector<glm::ivec3> cells;
+            const bool isEnclosed = floodFill(grid, glm::ivec3(3, 1, -8), 256, cells, true);
+
+            THEN("It tells the region is open without filling the box of the limit") {
+                REQUIRE_FALSE(isEnclosed);
+                REQUIRE(cells.size() <= 2 * 256 + 1);
+            }
+        }
+    }
+
+    GIVEN("A hollow cube with a hole in a wall") {
+        VoxelGrid grid;
+        insertHollowCube(grid, 22);
+        grid.erase(glm::ivec3(0, 5, 5));
+
+        WHEN("The inside is filled with and without stopping at the limit") {
+            std::vector<glm::ivec3> stoppedCells, cells;
+            const bool isStoppedEnclosed = floodFill(grid, glm::ivec3(7, 12, 3), 40, stoppedCells, true);
+            floodFill(grid, glm::ivec3(7, 12, 3), 40, cells);
+
+            THEN("The stopped fill finds fewer cells") {
+                REQUIRE_FALSE(isStoppedEnclosed);
+                REQUIRE(stoppedCells.size() < cells.size());
+            }
+        }
+    }
+}
@@ -0,0 +1,122 @@
+#include <catch2/catch.hpp>
+#include <met/met.hpp>
+
+#include "scene/morphology.h"
+
+namespace {
+    void fillBox(VoxelGrid& grid, const glm::ivec3& min, const glm::ivec3& max, unsigned int material) {
+        for (int x = min.x; x <= max.x; x++) {
+            for (int y = min.y; y <= max.y; y++) {
+                for (int z = min.z; z <= max.z; z++) {
+                    grid.insert(glm::ivec3(x, y, z), met::null, material);
+                }
+            }
+        }
+    }
+
+    Selection selectBox(const glm::ivec3& min, const glm::ivec3& max) {
+        Selection selection;
+        for (int x = min.x; x <= max.x; x++) {
+            for (int y = min.y; y <= max.y; y++) {
+                for (int z = min.z; z <= max.z; z++) {
+                    selection.insert(glm::ivec3(x, y, z));
+                }
+            }
+        }
+        return selection;
+    }
+}
+
+SCENARIO("Morphological filters should change the cells of the region from their neighbourhood", "[scene]") {
+    GIVEN("A 5 x 5 x 5 cube crossing chunk boundaries, with a spike of one voxel, and a region around it") {
+        VoxelGrid grid;
+        fillBox(grid, glm::ivec3(14, -2, 14), glm::ivec3(18, 2, 18), 3);
+        grid.insert(glm::ivec3(19, 0, 16), met::null, 4);
+        const Selection region = selectBox(glm::ivec3(10, -6, 10), glm::ivec3(24, 6, 24));
+        VoxelGrid result;
+
+        WHEN("It is dilated") {
+            filterVoxels(grid, region, MorphologyFilter::DILATE, result, 3);
+
+            THEN("The cube grows by one cell on each side, with the material of the closest voxel") {
+                REQUIRE(result.size() == 7 * 7 * 7 + 3 * 3);
+                REQUIRE(result.has(glm::ivec3(13, -3, 13)));
+                REQUIRE(result.material(glm::ivec3(13, 0, 16)) == 3);
+                REQUIRE(result.material(glm::ivec3(20, 0, 16)) == 4);
+                REQUIRE(grid.size() == 5 * 5 * 5 + 1);
+            }
+        }
+
+        WHEN("It is eroded") {
+            filterVoxels(grid, region, MorphologyFilter::ERODE, result, 3);
+
+            THEN("Only the inside of the cube is left") {
+                REQUIRE(result.size() == 3 * 3 * 3);
+                REQUIRE(result.has(glm::ivec3(15, -1, 15)));
+                REQUIRE_FALSE(result.has(glm::ivec3(14, 0, 16)));
+            }
+        }
+
+        WHEN("It is opened") {
+            filterVoxels(grid, region, MorphologyFilter::OPEN, result);
+
+            THEN("The spike is removed, and the cube is back") {
+                REQUIRE(result.size() == 5 * 5 * 5);
+                REQUIRE_FALSE(result.has(glm::ivec3(19, 0, 16)));
+            }
+        }
+
+        WHEN("It is smoothed") {
+            filterVoxels(grid, region, MorphologyFilter::SMOOTH, result, 1);
+
+            THEN("The spike and the corners are removed") {
+                REQUIRE_FALSE(result.has(glm::ivec3(19, 0, 16)));
+                REQUIRE_FALSE(result.has(glm::ivec3(14, -2, 14)));
+                REQUIRE(result.has(glm::ivec3(16, 0, 16)));
+                REQUIRE(result.has(glm::ivec3(14, 0, 16)));
+            }
+        }
+
+        WHEN("It is dilated in a region only holding the top of the cube") {
+            filterVoxels(grid, selectBox(glm::ivec3(10, 2, 10), glm::ivec3(24, 6, 24)), MorphologyFilter::DILATE, result);
+
+            THEN("Only the cells of the region are added") {
+                REQUIRE(result.size() == 5 * 5 * 5 + 1 + 7 * 7 * 2 - 5 * 5);
+                REQUIRE_FALSE(result.has(glm::ivec3(13, 0, 16)));
+            }
+        }
+    }
+
+    GIVEN("A cube with a hole in its middle") {
+        VoxelGrid grid;
+        fillBox(grid, glm::ivec3(0), glm::ivec3(4), 1);
+        grid.erase(glm::ivec3(2));
+
+        WHEN("It is closed") {
+            VoxelGrid result;
+            filterVoxels(grid, selectBox(glm::ivec3(-4), glm::ivec3(8)), MorphologyFilter::CLOSE, result);
+
+            THEN("The hole is filled, and the cube keeps its size") {
+                REQUIRE(result.size() == 5 * 5 * 5);
+                REQUIRE(result.has(glm::ivec3(2)));
+            }
+        }
+    }
+
+    GIVEN("A selected cell at a chunk corner") {
+        Selection selection;
+        selection.insert(glm::ivec3(15, 15, 15));
+
+        WHEN("The selection is dilated") {
+            Selection dilated;
+            dilateSelection(selection, dilated);
+
+            THEN("It holds the cells around it, in the chunks around") {
+                REQUIRE(dilated.size() == 27);
+                REQUIRE(dilated.has(glm::ivec3(16, 16, 16)));
+                REQUIRE(dilated.has(glm::ivec3(14, 14, 14)));
+                REQUIRE(dilated.chunkCount() == 8);
+            }
+        }
+    }
+}
@@ -0,0 +1,51 @@
+#include <catch2/catch.hpp>
+#include <met/met.hpp>
+
+#include "scene/ray-picking.h"
+
+SCENARIO("Picking should find the first voxel along the segment", "[scene]") {
+    GIVEN("Two voxels on the same row, with a chunk boundary between them") {
+        VoxelGrid grid;
+        grid.insert(glm::ivec3(20, 3, 4), met::null, 1);
+        grid.insert(glm::ivec3(30, 3, 4), met::null, 1);
+
+        glm::ivec3 position, normal;
+
+        WHEN("The segment goes along the row from the negative side") {
+            const bool isFound = pickVoxel(grid, glm::vec3(-5.5f, 3.5f, 4.5f), glm::vec3(50.0f, 3.5f, 4.5f), position, normal);
+
+            THEN("The nearest voxel is entered by its left face") {
+                REQUIRE(isFound);
+                REQUIRE(position == glm::ivec3(20, 3, 4));
+                REQUIRE(normal == glm::ivec3(-1, 0, 0));
+            }
+        }
+
+        WHEN("The segment goes along the row from the positive side") {
+            const bool isFound = pickVoxel(grid, glm::vec3(50.0f, 3.5f, 4.5f), glm::vec3(-5.5f, 3.5f, 4.5f), position, normal);
+
+            THEN("The other voxel is entered by its right face") {
+                REQUIRE(isFound);
+                REQUIRE(position == glm::ivec3(30, 3, 4));
+                REQUIRE(normal == glm::ivec3(1, 0, 0));
+            }
+        }
+
+        WHEN("The segment goes down on a diagonal") {
+            const bool isFound = pickVoxel(grid, glm::vec3(20.2f, 9.5f, 4.5f), glm::vec3(20.8f, -0.5f, 4.5f), position, normal);
+
+            THEN("The voxel is entered by its top face") {
+                REQUIRE(isFound);
+                REQUIRE(position == glm::ivec3(20, 3, 4));
+                REQUIRE(normal == glm::ivec3(0, 1, 0));
+            }
+        }
+
+        WHEN("The segment ends before the voxels") {
+            THEN("Nothing is found") {
+                REQUIRE_FALSE(pickVoxel(grid, glm::vec3(-5.5f, 3.5f, 4.5f), glm::vec3(19.5f, 3.5f, 4.5f), position, normal));
+                REQUIRE_FALSE(pickVoxel(grid, glm::vec3(-5.5f, 5.5f, 4.5f), glm::vec3(50.0f, 5.5f, 4.5f), position, normal));
+            }
+        }
+    }
+}
@@ -0,0 +1,55 @@
+#include <catch2/catch.hpp>
+#include <met/met.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "scene/screen-selection.h"
+
+SCENARIO("Screen selections should keep the voxels drawn inside the shape", "[scene]") {
+    GIVEN("A block of voxels seen from above one of its corners") {
+        VoxelGrid grid;
+        for (int x = -20; x < 40; x++) {
+            for (int y = 0; y < 24; y++) {
+                for (int z = -8; z < 40; z++) {
+                    grid.insert(glm::ivec3(x, y, z), met::null, 1);
+                }
+            }
+        }
+        const glm::mat4 viewProj = glm::perspectiveFovLH(glm::quarter_pi<float>(), 800.0f, 600.0f, 0.1f, 100.0f)
+            * glm::lookAtLH(glm::vec3(-30.0f, 50.0f, -30.0f), glm::vec3(10.0f, 0.0f, 15.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+
+        // Corners on the edges of the pixels of the lasso, so both shapes are the same
+        const glm::vec2 min(-0.5f, -0.25f);
+        const glm::vec2 max(0.5f, 0.75f);
+
+        size_t expectedCount = 0;
+        for (int x = -20; x < 40; x++) {
+            for (int y = 0; y < 24; y++) {
+                for (int z = -8; z < 40; z++) {
+                    const glm::vec4 clip = viewProj * glm::vec4(glm::vec3(x, y, z) + 0.5f, 1.0f);
+                    const glm::vec2 ndc = glm::vec2(clip) / clip.w;
+                    if (clip.w > 0.0f && ndc.x >= min.x && ndc.y >= min.y && ndc.x < max.x && ndc.y < max.y)
+                        expectedCount++;
+                }
+            }
+        }
+
+        WHEN("A rectangle is selected") {
+            Selection selection;
+            selectInRectangle(grid, viewProj, min, max, selection);
+
+            THEN("Each voxel is projected inside it") {
+                REQUIRE(expectedCount > 0);
+                REQUIRE(selection.size() == expectedCount);
+            }
+        }
+
+        WHEN("A lasso with the same outline is selected") {
+            Selection selection;
+            selectInLasso(grid, viewProj, { min, glm::vec2(max.x, min.y), max, glm::vec2(min.x, max.y) }, selection);
+
+            THEN("The same voxels are selected") {
+                REQUIRE(selection.size() == expectedCount);
+            }
+        }
+    }
+}
@@ -0,0 +1,86 @@
+#include <catch2/catch.hpp>
+#include <met/met.hpp>
+#include <vector>
+
+#include "scomponents/scene/clipboard.h"
+
+namespace {
+    /**
+     * @brief Material of the cell in the stamped voxels, or -1 if it is empty
+     */
+    int stampedMaterial(const std::vector<glm::ivec3>& positions, const std::vector<unsigned int>& materials, const glm::ivec3& pos) {
+        for (size_t i = 0; i < positions.size(); i++) {
+            if (positions[i] == pos)
+                return materials[i];
+        }
+        return -1;
+    }
+}
+
+SCENARIO("The clipboard should stamp the copied voxels relative to their box", "[scomponents]") {
+    GIVEN("An L shape of 3 x 1 x 2 cells, crossing a chunk boundary, with unselected voxels around") {
+        VoxelGrid grid;
+        Selection selection;
+        for (const glm::ivec3& pos : { glm::ivec3(14, 5, 3), glm::ivec3(15, 5, 3), glm::ivec3(16, 5, 3), glm::ivec3(14, 5, 4) }) {
+            grid.insert(pos, met::null, pos.x == 16 ? 2 : 1);
+            selection.insert(pos);
+        }
+        grid.insert(glm::ivec3(15, 5, 4), met::null, 3);
+        selection.insert(glm::ivec3(0, 0, 0)); // Not a voxel anymore
+
+        Clipboard clipboard;
+        clipboard.copy(grid, selection);
+
+        THEN("Only the selected voxels are copied, in few runs") {
+            REQUIRE(clipboard.voxelCount() == 4);
+            REQUIRE(clipboard.size() == glm::ivec3(3, 1, 2));
+            REQUIRE(clipboard.runCount() == 4);
+        }
+
+        WHEN("It is stamped without transform") {
+            std::vector<glm::ivec3> positions;
+            std::vector<unsigned int> materials;
+            clipboard.stamp(glm::ivec3(0, 10, 0), 0, false, positions, materials);
+
+            THEN("The smallest corner of the box is on the origin") {
+                REQUIRE(positions.size() == 4);
+                REQUIRE(stampedMaterial(positions, materials, glm::ivec3(0, 10, 0)) == 1);
+                REQUIRE(stampedMaterial(positions, materials, glm::ivec3(2, 10, 0)) == 2);
+                REQUIRE(stampedMaterial(positions, materials, glm::ivec3(0, 10, 1)) == 1);
+                REQUIRE(stampedMaterial(positions, materials, glm::ivec3(1, 10, 1)) == -1);
+            }
+        }
+
+        WHEN("It is mirrored and turned once") {
+            std::vector<glm::ivec3> positions;
+            std::vector<unsigned int> materials;
+            clipboard.stamp(glm::ivec3(0), 1, true, positions, materials);
+
+            THEN("The cells stay in the turned box") {
+                REQUIRE(clipboard.size(1) == glm::ivec3(2, 1, 3));
+                REQUIRE(positions.size() == 4);
+                for (const glm::ivec3& pos : positions) {
+                    REQUIRE(glm::all(glm::greaterThanEqual(pos, glm::ivec3(0))));
+                    REQUIRE(glm::all(glm::lessThan(pos, clipboard.size(1))));
+                }
+
+                // Mirrored (x, z) = (2 - x, z), then turned to (1 - z, x)
+                REQUIRE(stampedMaterial(positions, materials, glm::ivec3(1, 0, 0)) == 2);
+                REQUIRE(stampedMaterial(positions, materials, glm::ivec3(1, 0, 2)) == 1);
+                REQUIRE(stampedMaterial(positions, materials, glm::ivec3(0, 0, 2)) == 1);
+            }
+        }
+
+        WHEN("It is turned four times") {
+            std::vector<glm::ivec3> positions, fullTurn;
+            std::vector<unsigned int> materials, fullTurnMaterials;
+            clipboard.stamp(glm::ivec3(0), 0, false, positions, materials);
+            clipboard.stamp(glm::ivec3(0), 4, false, fullTurn, fullTurnMaterials);
+
+            THEN("It is back to its first orientation") {
+                REQUIRE(fullTurn == positions);
+                REQUIRE(fullTurnMaterials == materials);
+            }
+        }
+    }
+}
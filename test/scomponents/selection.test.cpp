@@ -0,0 +1,90 @@
+#include <catch2/catch.hpp>
+#include <met/met.hpp>
+#include <vector>
+#include <algorithm>
+
+#include "scomponents/scene/selection.h"
+
+namespace {
+    Selection selectBox(const glm::ivec3& min, const glm::ivec3& max) {
+        Selection selection;
+        for (int x = min.x; x <= max.x; x++) {
+            for (int y = min.y; y <= max.y; y++) {
+                for (int z = min.z; z <= max.z; z++) {
+                    selection.insert(glm::ivec3(x, y, z));
+                }
+            }
+        }
+        return selection;
+    }
+}
+
+SCENARIO("Selections should be combined cell by cell", "[scomponents]") {
+    GIVEN("Two boxes crossing chunk boundaries, which overlap on 10 x 10 x 10 cells") {
+        Selection a = selectBox(glm::ivec3(-10, 0, 0), glm::ivec3(19, 19, 19));
+        const Selection b = selectBox(glm::ivec3(10, 10, 10), glm::ivec3(39, 29, 29));
+
+        WHEN("They are united") {
+            a.unite(b);
+
+            THEN("Common cells are counted once") {
+                REQUIRE(a.size() == 30 * 20 * 20 + 30 * 20 * 20 - 10 * 10 * 10);
+                REQUIRE(a.has(glm::ivec3(-10, 0, 0)));
+                REQUIRE(a.has(glm::ivec3(39, 29, 29)));
+            }
+        }
+
+        WHEN("They are intersected") {
+            a.intersect(b);
+
+            THEN("Only the common cells are left, and the empty chunks are dropped") {
+                REQUIRE(a.size() == 10 * 10 * 10);
+                REQUIRE_FALSE(a.has(glm::ivec3(9, 10, 10)));
+                REQUIRE(a.chunkCount() == 8);
+            }
+        }
+
+        WHEN("One is subtracted from the other") {
+            a.subtract(b);
+
+            THEN("The common cells are removed") {
+                REQUIRE(a.size() == 30 * 20 * 20 - 10 * 10 * 10);
+                REQUIRE_FALSE(a.has(glm::ivec3(10, 10, 10)));
+                REQUIRE(a.has(glm::ivec3(9, 10, 10)));
+            }
+        }
+
+        WHEN("One is translated") {
+            a.translate(glm::ivec3(3, -17, 5));
+
+            THEN("Every cell moves by the offset") {
+                REQUIRE(a.size() == 30 * 20 * 20);
+                std::vector<glm::ivec3> positions;
+                a.positions(positions);
+                REQUIRE(positions.size() == a.size());
+                REQUIRE(std::all_of(positions.begin(), positions.end(), [](const glm::ivec3& pos) {
+                    return pos.x >= -7 && pos.x <= 22 && pos.y >= -17 && pos.y <= 2 && pos.z >= 5 && pos.z <= 24;
+                }));
+            }
+        }
+    }
+
+    GIVEN("A scene with two voxels") {
+        VoxelGrid grid;
+        grid.insert(glm::ivec3(0, 0, 0), met::null, 1);
+        grid.insert(glm::ivec3(40, 0, 0), met::null, 1);
+
+        WHEN("Every voxel is selected, then one is removed from the scene") {
+            Selection selection;
+            selection.selectAll(grid);
+            REQUIRE(selection.size() == 2);
+            grid.erase(glm::ivec3(40, 0, 0));
+            selection.intersect(grid);
+
+            THEN("It is left out of the selection") {
+                REQUIRE(selection.size() == 1);
+                REQUIRE(selection.has(glm::ivec3(0, 0, 0)));
+            }
+        }
+    }
+}
@@ -0,0 +1,71 @@
+#include <catch2/catch.hpp>
+#include <met/met.hpp>
+
+#include "scomponents/scene/voxel-grid.h"
+
+namespace {
+    void fillBox(VoxelGrid& grid, const glm::ivec3& min, const glm::ivec3& max, unsigned int material) {
+        for (int x = min.x; x <= max.x; x++) {
+            for (int y = min.y; y <= max.y; y++) {
+                for (int z = min.z; z <= max.z; z++) {
+                    grid.insert(glm::ivec3(x, y, z), met::null, material);
+                }
+            }
+        }
+    }
+}
+
+SCENARIO("Voxel grids should be combined with boolean operations", "[scomponents]") {
+    GIVEN("Two boxes crossing chunk boundaries, which overlap on 10 x 10 x 10 cells") {
+        VoxelGrid a, b;
+        fillBox(a, glm::ivec3(-10, 0, 0), glm::ivec3(19, 19, 19), 1);
+        fillBox(b, glm::ivec3(10, 10, 10), glm::ivec3(39, 29, 29), 2);
+        const VoxelGrid::Snapshot before = a.snapshot();
+
+        WHEN("They are united, keeping the materials of the first one") {
+            a.unite(b, false);
+
+            THEN("Common cells are counted once, and keep their material") {
+                REQUIRE(a.size() == 30 * 20 * 20 + 30 * 20 * 20 - 10 * 10 * 10);
+                REQUIRE(a.material(glm::ivec3(15, 15, 15)) == 1);
+                REQUIRE(a.material(glm::ivec3(39, 29, 29)) == 2);
+            }
+
+            THEN("The snapshot taken before is not changed") {
+                REQUIRE(VoxelGrid(before).size() == 30 * 20 * 20);
+                REQUIRE_FALSE(VoxelGrid(before).has(glm::ivec3(39, 29, 29)));
+            }
+        }
+
+        WHEN("They are united, replacing the materials") {
+            a.unite(b, true);
+
+            THEN("Common cells take the material of the second one") {
+                REQUIRE(a.material(glm::ivec3(15, 15, 15)) == 2);
+                REQUIRE(a.material(glm::ivec3(0, 0, 0)) == 1);
+            }
+        }
+
+        WHEN("The second one is subtracted") {
+            a.subtract(b);
+
+            THEN("Common cells are removed") {
+                REQUIRE(a.size() == 30 * 20 * 20 - 10 * 10 * 10);
+                REQUIRE_FALSE(a.has(glm::ivec3(15, 15, 15)));
+                REQUIRE(a.has(glm::ivec3(9, 9, 9)));
+            }
+        }
+
+        WHEN("They are intersected") {
+            a.intersect(b, true);
+
+            THEN("Only the common cells are left, and the empty chunks are dropped") {
+                REQUIRE(a.size() == 10 * 10 * 10);
+                REQUIRE(a.material(glm::ivec3(10, 10, 10)) == 2);
+                REQUIRE_FALSE(a.has(glm::ivec3(9, 10, 10)));
+                REQUIRE(a.findChunk(glm::ivec3(-10, 0, 0)) == nullptr);
+                REQUIRE(a.chunkCount() == 8);
+            }
+        }
+    }
+}